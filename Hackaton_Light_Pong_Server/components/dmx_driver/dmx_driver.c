@@ -6,53 +6,202 @@
  */
 
 #include "dmx_driver.h"
+#include "dmx_driver_priv.h"
+#include "dmx_port.h"
 #include <string.h>
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "freertos/semphr.h"
 #include "esp_log.h"
-#include "driver/uart.h"
-#include "driver/gpio.h"
 #include "esp_timer.h"
-#include "esp_rom_gpio.h"
 
 static const char *TAG = "DMX";
 
-#define DMX_TX_BUFFER_SIZE 1024
-#define DMX_RX_BUFFER_SIZE 256 // Minimum required by UART driver (even in TX-only mode)
-#define DMX_TASK_STACK_SIZE 4096
-#define DMX_TASK_PRIORITY 5
-#define DMX_UPDATE_RATE_HZ 44 // Standard DMX refresh rate
+/**
+ * @brief Publish the back buffer into the front buffer at a frame boundary
+ *
+ * Single channel writes are plain byte stores and never take this lock. Only
+ * multi-byte writes and this snapshot do, so a frame never contains half of a
+ * bulk update and writers are never blocked by the UART transfer itself. The
+ * source merge works on the snapshot after the lock is released.
+ */
+static void dmx_publish_frame(dmx_context_t *ctx, int64_t now)
+{
+    atomic_store(&ctx->dirty, false);
+    if (ctx->fade_count > 0)
+    {
+        dmx_fade_apply(ctx, now);
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    ctx->tx_len = (ctx->refresh_mode == DMX_REFRESH_TRIMMED) ? ctx->highest_channel + 1
+                                                             : ctx->universe_size + 1;
+    memcpy(ctx->tx_frame, ctx->dmx_data, ctx->tx_len);
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (ctx->merge != NULL)
+    {
+        dmx_merge_apply(ctx, ctx->tx_frame, ctx->tx_len);
+    }
+}
 
 /**
- * @brief DMX driver context structure
+ * @brief Update timing statistics for a frame that started at frame_start
  */
-typedef struct
+static void dmx_record_frame(dmx_context_t *ctx, int64_t frame_start, uint32_t cpu_us, bool complete)
+{
+    static const uint32_t bucket_limits[DMX_JITTER_BUCKETS] = DMX_JITTER_BUCKET_LIMITS_US;
+    dmx_stats_t *st = &ctx->stats;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+
+    if (complete)
+    {
+        st->frames_sent++;
+    }
+    else
+    {
+        st->frames_incomplete++;
+    }
+
+    st->cpu_time_last_us = cpu_us;
+    if (cpu_us > st->cpu_time_max_us)
+    {
+        st->cpu_time_max_us = cpu_us;
+    }
+
+    if (ctx->period_valid && st->last_frame_us != 0)
+    {
+        uint32_t period = (uint32_t)(frame_start - st->last_frame_us);
+        uint32_t deviation = (period > st->period_target_us) ? period - st->period_target_us
+                                                             : st->period_target_us - period;
+
+        if (ctx->period_count == 0 || period < st->period_min_us)
+        {
+            st->period_min_us = period;
+        }
+        if (period > st->period_max_us)
+        {
+            st->period_max_us = period;
+        }
+        ctx->period_sum_us += period;
+        ctx->period_count++;
+        st->period_mean_us = (uint32_t)(ctx->period_sum_us / ctx->period_count);
+
+        int bucket = 0;
+        while (deviation > bucket_limits[bucket])
+        {
+            bucket++;
+        }
+        st->jitter_hist[bucket]++;
+    }
+
+    st->last_frame_us = frame_start;
+    ctx->period_valid = true;
+
+    portEXIT_CRITICAL(&ctx->frame_lock);
+}
+
+bool dmx_frame_due(dmx_context_t *ctx, int64_t now)
+{
+    // Idle mode: nothing changed and nothing fading, only send a keep-alive frame
+    if (ctx->idle_period_us != 0 && !atomic_load(&ctx->dirty) && ctx->fade_count == 0 &&
+        (now - ctx->last_tx_us) < ctx->idle_period_us)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        ctx->stats.frames_idle_skipped++;
+        ctx->period_valid = false;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+        return false;
+    }
+
+    ctx->last_tx_us = now;
+    return true;
+}
+
+void dmx_record_dropped(dmx_context_t *ctx, uint32_t frames)
 {
-    uart_port_t uart_num;
-    gpio_num_t tx_pin;
-    gpio_num_t rx_pin;
-    gpio_num_t enable_pin;
-    uint16_t universe_size;
-    uint8_t *dmx_data;
-    SemaphoreHandle_t mutex;
-    TaskHandle_t tx_task_handle;
-    bool is_running;
-} dmx_context_t;
+    portENTER_CRITICAL(&ctx->frame_lock);
+    ctx->stats.frames_dropped += frames;
+    ctx->period_valid = false;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+}
+
+void dmx_run_tx_callback(dmx_context_t *ctx, int64_t now)
+{
+    dmx_tx_callback_t callbacks[DMX_MAX_TX_CALLBACKS];
+    void *user_ctx[DMX_MAX_TX_CALLBACKS];
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    uint8_t count = ctx->tx_callback_count;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        callbacks[i] = ctx->tx_callbacks[i];
+        user_ctx[i] = ctx->tx_user_ctx[i];
+    }
+    if (count > 0)
+    {
+        ctx->tx_callback_gen++;
+        ctx->tx_callback_task = xTaskGetCurrentTaskHandle();
+    }
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        callbacks[i](now, user_ctx[i]);
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    ctx->tx_callback_gen++;
+    ctx->tx_callback_task = NULL;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+}
 
 /**
- * @brief Send DMX break signal
+ * @brief Frame timer callback, wakes the transmission task
  */
-static esp_err_t dmx_send_break(dmx_context_t *ctx)
+static void dmx_frame_timer_cb(void *arg)
 {
-    uart_wait_tx_done(ctx->uart_num, portMAX_DELAY);
-    uart_set_line_inverse(ctx->uart_num, UART_SIGNAL_TXD_INV);
-    esp_rom_delay_us(DMX_BREAK_US);
+    dmx_context_t *ctx = (dmx_context_t *)arg;
+    xTaskNotifyGive(ctx->task_handle);
+}
 
-    uart_set_line_inverse(ctx->uart_num, UART_SIGNAL_INV_DISABLE);
-    esp_rom_delay_us(DMX_MAB_US);
+/**
+ * @brief Free the context and all buffers it owns
+ */
+static void dmx_free_context(dmx_context_t *ctx)
+{
+    dmx_merge_free(ctx->merge);
+    dmx_fade_free(ctx->fade);
+    dmx_rdm_free(ctx->rdm);
+    free(ctx->rx_buf[0]);
+    free(ctx->rx_buf[1]);
+    free(ctx->tx_frame);
+    free(ctx->dmx_data);
+    free(ctx);
+}
 
-    return ESP_OK;
+void dmx_rx_complete_frame(dmx_context_t *ctx)
+{
+    if (ctx->rx_synced && ctx->rx_len > 1)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        ctx->rx_front_len = ctx->rx_len;
+        ctx->rx_back ^= 1;
+        ctx->stats.rx_frames++;
+        ctx->stats.last_frame_us = esp_timer_get_time();
+        portEXIT_CRITICAL(&ctx->frame_lock);
+
+        if (ctx->rx_callback != NULL)
+        {
+            ctx->rx_callback(ctx->rx_buf[ctx->rx_back ^ 1], ctx->rx_front_len, ctx->rx_user_ctx);
+        }
+    }
+
+    ctx->rx_len = 0;
+    ctx->rx_synced = true;
 }
 
 /**
@@ -61,19 +210,37 @@ static esp_err_t dmx_send_break(dmx_context_t *ctx)
 static void dmx_tx_task(void *arg)
 {
     dmx_context_t *ctx = (dmx_context_t *)arg;
-    TickType_t last_wake_time = xTaskGetTickCount();
-    const TickType_t period = pdMS_TO_TICKS(1000 / DMX_UPDATE_RATE_HZ);
 
     ESP_LOGI(TAG, "DMX transmission task started");
 
     while (ctx->is_running)
     {
-        if (dmx_transmit(ctx) != ESP_OK)
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!ctx->is_running)
+        {
+            break;
+        }
+
+        // More than one pending tick means the previous frame overran its slot
+        if (pending > 1)
+        {
+            dmx_record_dropped(ctx, pending - 1);
+        }
+
+        int64_t slot_start = esp_timer_get_time();
+        dmx_run_tx_callback(ctx, slot_start);
+        bool frame_sent = dmx_frame_due(ctx, slot_start);
+
+        if (frame_sent && dmx_transmit(ctx) != ESP_OK)
         {
             ESP_LOGW(TAG, "DMX transmission failed");
         }
 
-        vTaskDelayUntil(&last_wake_time, period);
+        // RDM uses the rest of the slot, the frame has already left the line
+        if (ctx->rdm != NULL)
+        {
+            dmx_rdm_service(ctx, slot_start, frame_sent);
+        }
     }
 
     ESP_LOGI(TAG, "DMX transmission task stopped");
@@ -108,93 +275,79 @@ esp_err_t dmx_init(const dmx_config_t *config, dmx_handle_t *out_handle)
         return ESP_ERR_NO_MEM;
     }
 
-    ctx->mutex = xSemaphoreCreateMutex();
-    if (ctx->mutex == NULL)
+    ctx->tx_frame = (uint8_t *)calloc(config->universe_size + 1, sizeof(uint8_t));
+    if (ctx->tx_frame == NULL)
     {
-        ESP_LOGE(TAG, "Failed to create mutex");
+        ESP_LOGE(TAG, "Failed to allocate DMX frame buffer");
         free(ctx->dmx_data);
         free(ctx);
         return ESP_ERR_NO_MEM;
     }
 
+    if (config->mode == DMX_MODE_RX)
+    {
+        ctx->rx_buf[0] = (uint8_t *)calloc(config->universe_size + 1, sizeof(uint8_t));
+        ctx->rx_buf[1] = (uint8_t *)calloc(config->universe_size + 1, sizeof(uint8_t));
+        if (ctx->rx_buf[0] == NULL || ctx->rx_buf[1] == NULL)
+        {
+            ESP_LOGE(TAG, "Failed to allocate DMX receive buffers");
+            dmx_free_context(ctx);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    spinlock_initialize(&ctx->frame_lock);
+
     ctx->uart_num = config->uart_num;
     ctx->tx_pin = config->tx_pin;
     ctx->rx_pin = config->rx_pin;
     ctx->enable_pin = config->enable_pin;
     ctx->universe_size = config->universe_size;
-    ctx->is_running = false;
-    ctx->tx_task_handle = NULL;
+    ctx->mode = config->mode;
+    ctx->break_mode = config->break_mode;
+    ctx->break_on_line = false;
+    ctx->refresh_mode = config->refresh_mode;
+    ctx->highest_channel = 1;
+    atomic_init(&ctx->dirty, true);
 
-    ctx->dmx_data[0] = 0x00;
-
-    // Configure RS-485 enable pin
-    gpio_config_t io_conf = {
-        .intr_type = GPIO_INTR_DISABLE,
-        .mode = GPIO_MODE_OUTPUT,
-        .pin_bit_mask = (1ULL << ctx->enable_pin),
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .pull_up_en = GPIO_PULLUP_DISABLE};
-    esp_err_t ret = gpio_config(&io_conf);
-    if (ret != ESP_OK)
+    uint16_t rate_hz = (config->refresh_rate_hz != 0) ? config->refresh_rate_hz : DMX_DEFAULT_RATE_HZ;
+    ctx->frame_period_us = 1000000 / rate_hz;
+    if (ctx->frame_period_us < DMX_MIN_FRAME_US)
     {
-        ESP_LOGE(TAG, "Failed to configure enable pin");
-        vSemaphoreDelete(ctx->mutex);
-        free(ctx->dmx_data);
-        free(ctx);
-        return ret;
+        ctx->frame_period_us = DMX_MIN_FRAME_US;
     }
 
-    // Set RS-485 to transmit mode
-    gpio_set_level(ctx->enable_pin, 1);
-
-    // Configure UART
-    uart_config_t uart_config = {
-        .baud_rate = DMX_BAUD_RATE,
-        .data_bits = DMX_DATA_BITS,
-        .parity = DMX_PARITY,
-        .stop_bits = DMX_STOP_BITS,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
-        .source_clk = UART_SCLK_DEFAULT,
-    };
-
-    ret = uart_param_config(ctx->uart_num, &uart_config);
-    if (ret != ESP_OK)
+    ctx->stats.period_target_us = ctx->frame_period_us;
+    if (config->break_mode == DMX_BREAK_MODE_UART)
     {
-        ESP_LOGE(TAG, "UART param config failed");
-        gpio_reset_pin(ctx->enable_pin);
-        vSemaphoreDelete(ctx->mutex);
-        free(ctx->dmx_data);
-        free(ctx);
-        return ret;
+        ctx->stats.break_us = (DMX_BREAK_BITS * 1000) / (DMX_BAUD_RATE / 1000);
     }
 
-    ret = uart_set_pin(ctx->uart_num, ctx->tx_pin, ctx->rx_pin,
-                       UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-    if (ret != ESP_OK)
+    ctx->idle_period_us = 0;
+    if (config->idle_rate_hz != 0)
     {
-        ESP_LOGE(TAG, "UART set pin failed");
-        gpio_reset_pin(ctx->enable_pin);
-        vSemaphoreDelete(ctx->mutex);
-        free(ctx->dmx_data);
-        free(ctx);
-        return ret;
+        uint16_t idle_hz = (config->idle_rate_hz < DMX_MIN_IDLE_RATE_HZ) ? DMX_MIN_IDLE_RATE_HZ
+                                                                         : config->idle_rate_hz;
+        ctx->idle_period_us = 1000000 / idle_hz;
     }
+    ctx->is_running = false;
+    ctx->task_handle = NULL;
+
+    ctx->dmx_data[0] = 0x00;
 
-    ret = uart_driver_install(ctx->uart_num, DMX_RX_BUFFER_SIZE,
-                              DMX_TX_BUFFER_SIZE, 0, NULL, 0);
+    esp_err_t ret = dmx_port_init(ctx);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "UART driver install failed");
-        gpio_reset_pin(ctx->enable_pin);
-        vSemaphoreDelete(ctx->mutex);
-        free(ctx->dmx_data);
-        free(ctx);
+        ESP_LOGE(TAG, "DMX line setup failed: %s", esp_err_to_name(ret));
+        dmx_free_context(ctx);
         return ret;
     }
 
     *out_handle = (dmx_handle_t)ctx;
-    ESP_LOGI(TAG, "DMX initialized: UART%d, TX:%d, EN:%d, Channels:%d",
-             ctx->uart_num, ctx->tx_pin, ctx->enable_pin, ctx->universe_size);
+    ESP_LOGI(TAG, "DMX initialized: UART%d, TX:%d, RX:%d, EN:%d, Channels:%d, Mode:%s, Break:%s",
+             ctx->uart_num, ctx->tx_pin, ctx->rx_pin, ctx->enable_pin, ctx->universe_size,
+             ctx->mode == DMX_MODE_RX ? "rx" : "tx",
+             ctx->break_mode == DMX_BREAK_MODE_UART ? "uart" : "busy-wait");
 
     return ESP_OK;
 }
@@ -210,15 +363,18 @@ esp_err_t dmx_deinit(dmx_handle_t handle)
 
     if (ctx->is_running)
     {
-        dmx_stop_transmission(handle);
+        if (ctx->mode == DMX_MODE_RX)
+        {
+            dmx_stop_reception(handle);
+        }
+        else
+        {
+            dmx_stop_transmission(handle);
+        }
     }
 
-    uart_driver_delete(ctx->uart_num);
-    gpio_reset_pin(ctx->enable_pin);
-
-    vSemaphoreDelete(ctx->mutex);
-    free(ctx->dmx_data);
-    free(ctx);
+    dmx_port_deinit(ctx);
+    dmx_free_context(ctx);
 
     ESP_LOGI(TAG, "DMX deinitialized");
     return ESP_OK;
@@ -239,14 +395,20 @@ esp_err_t dmx_set_channel(dmx_handle_t handle, uint16_t channel, uint8_t value)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (xSemaphoreTake(ctx->mutex, portMAX_DELAY) == pdTRUE)
+    if (ctx->fade_count > 0)
     {
+        // A direct write replaces a running fade; both must happen between frames
+        portENTER_CRITICAL(&ctx->frame_lock);
+        dmx_fade_cancel_locked(ctx, ctx->dmx_data, channel, 1);
         ctx->dmx_data[channel] = value;
-        xSemaphoreGive(ctx->mutex);
-        return ESP_OK;
+        portEXIT_CRITICAL(&ctx->frame_lock);
     }
-
-    return ESP_FAIL;
+    else
+    {
+        ctx->dmx_data[channel] = value;
+    }
+    dmx_mark_dirty(ctx, channel);
+    return ESP_OK;
 }
 
 esp_err_t dmx_set_channels(dmx_handle_t handle, uint16_t start_channel,
@@ -266,14 +428,58 @@ esp_err_t dmx_set_channels(dmx_handle_t handle, uint16_t start_channel,
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (xSemaphoreTake(ctx->mutex, portMAX_DELAY) == pdTRUE)
+    portENTER_CRITICAL(&ctx->frame_lock);
+    if (ctx->fade_count > 0)
     {
-        memcpy(&ctx->dmx_data[start_channel], data, length);
-        xSemaphoreGive(ctx->mutex);
-        return ESP_OK;
+        dmx_fade_cancel_locked(ctx, ctx->dmx_data, start_channel, length);
     }
+    memcpy(&ctx->dmx_data[start_channel], data, length);
+    portEXIT_CRITICAL(&ctx->frame_lock);
 
-    return ESP_FAIL;
+    dmx_mark_dirty(ctx, start_channel + length - 1);
+    return ESP_OK;
+}
+
+esp_err_t dmx_set_channels_sparse(dmx_handle_t handle,
+                                  const dmx_channel_value_t *pairs, uint16_t count)
+{
+    if (handle == NULL || pairs == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    uint16_t last_channel = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (pairs[i].channel == 0 || pairs[i].channel > ctx->universe_size)
+        {
+            ESP_LOGE(TAG, "Invalid channel: %d (valid: 1-%d)", pairs[i].channel, ctx->universe_size);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (pairs[i].channel > last_channel)
+        {
+            last_channel = pairs[i].channel;
+        }
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (ctx->fade_count > 0)
+        {
+            dmx_fade_cancel_locked(ctx, ctx->dmx_data, pairs[i].channel, 1);
+        }
+        ctx->dmx_data[pairs[i].channel] = pairs[i].value;
+    }
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (count > 0)
+    {
+        dmx_mark_dirty(ctx, last_channel);
+    }
+    return ESP_OK;
 }
 
 esp_err_t dmx_get_channel(dmx_handle_t handle, uint16_t channel, uint8_t *value)
@@ -290,14 +496,65 @@ esp_err_t dmx_get_channel(dmx_handle_t handle, uint16_t channel, uint8_t *value)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (xSemaphoreTake(ctx->mutex, portMAX_DELAY) == pdTRUE)
+    if (ctx->mode == DMX_MODE_RX)
     {
-        *value = ctx->dmx_data[channel];
-        xSemaphoreGive(ctx->mutex);
+        portENTER_CRITICAL(&ctx->frame_lock);
+        *value = (channel < ctx->rx_front_len) ? ctx->rx_buf[ctx->rx_back ^ 1][channel] : 0;
+        portEXIT_CRITICAL(&ctx->frame_lock);
         return ESP_OK;
     }
 
-    return ESP_FAIL;
+    *value = ctx->dmx_data[channel];
+    return ESP_OK;
+}
+
+esp_err_t dmx_transmit_frame(dmx_context_t *ctx, TickType_t ready_timeout, bool wait_done)
+{
+    int bytes_written;
+
+    // Previous frame (and its trailing BREAK, if any) must be off the wire
+    if (dmx_port_wait_tx_done(ctx, ready_timeout) != ESP_OK)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    int64_t frame_start = esp_timer_get_time();
+
+    // Snapshot before the break so the copy never stretches the MAB
+    dmx_publish_frame(ctx, frame_start);
+    const int frame_len = ctx->tx_len;
+
+    if (ctx->break_mode == DMX_BREAK_MODE_UART)
+    {
+        // The BREAK for this frame was appended to the previous one; the idle
+        // line since then is the MAB. Append the BREAK for the next frame.
+        if (!ctx->break_on_line)
+        {
+            dmx_port_send_break(ctx);
+        }
+        bytes_written = dmx_port_write(ctx, ctx->tx_frame, frame_len, true);
+        ctx->break_on_line = (bytes_written == frame_len);
+    }
+    else
+    {
+        dmx_port_send_break(ctx);
+        bytes_written = dmx_port_write(ctx, ctx->tx_frame, frame_len, false);
+    }
+
+    uint32_t cpu_us = (uint32_t)(esp_timer_get_time() - frame_start);
+    dmx_record_frame(ctx, frame_start, cpu_us, bytes_written == frame_len);
+
+    if (bytes_written != frame_len)
+    {
+        ESP_LOGW(TAG, "DMX write incomplete: %d/%d bytes", bytes_written, frame_len);
+        return ESP_FAIL;
+    }
+
+    if (wait_done)
+    {
+        dmx_port_wait_tx_done(ctx, pdMS_TO_TICKS(DMX_PACKET_TIMEOUT_MS));
+    }
+    return ESP_OK;
 }
 
 esp_err_t dmx_transmit(dmx_handle_t handle)
@@ -307,33 +564,108 @@ esp_err_t dmx_transmit(dmx_handle_t handle)
         return ESP_ERR_INVALID_ARG;
     }
 
+    return dmx_transmit_frame((dmx_context_t *)handle, portMAX_DELAY, true);
+}
+
+esp_err_t dmx_get_frame_cpu_time(dmx_handle_t handle, uint32_t *last_us, uint32_t *max_us)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    if (last_us != NULL)
+    {
+        *last_us = ctx->stats.cpu_time_last_us;
+    }
+    if (max_us != NULL)
+    {
+        *max_us = ctx->stats.cpu_time_max_us;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_get_stats(dmx_handle_t handle, dmx_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
     dmx_context_t *ctx = (dmx_context_t *)handle;
-    esp_err_t ret;
 
-    ret = dmx_send_break(ctx);
+    portENTER_CRITICAL(&ctx->frame_lock);
+    *out_stats = ctx->stats;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_reset_stats(dmx_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    uint32_t period_target_us = ctx->stats.period_target_us;
+    uint32_t break_us = ctx->stats.break_us;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    ctx->stats.period_target_us = period_target_us;
+    ctx->stats.break_us = break_us;
+    ctx->period_sum_us = 0;
+    ctx->period_count = 0;
+    ctx->period_valid = false;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_log_stats(dmx_handle_t handle)
+{
+    static const uint32_t bucket_limits[DMX_JITTER_BUCKETS] = DMX_JITTER_BUCKET_LIMITS_US;
+    dmx_stats_t st;
+
+    esp_err_t ret = dmx_get_stats(handle, &st);
     if (ret != ESP_OK)
     {
         return ret;
     }
 
-    if (xSemaphoreTake(ctx->mutex, portMAX_DELAY) == pdTRUE)
-    {
-        int bytes_written = uart_write_bytes(ctx->uart_num, ctx->dmx_data,
-                                             ctx->universe_size + 1);
-        xSemaphoreGive(ctx->mutex);
+    ESP_LOGI(TAG, "Frames: sent=%lu incomplete=%lu dropped=%lu idle_skipped=%lu",
+             (unsigned long)st.frames_sent, (unsigned long)st.frames_incomplete,
+             (unsigned long)st.frames_dropped, (unsigned long)st.frames_idle_skipped);
+    ESP_LOGI(TAG, "Period: target=%lu min=%lu mean=%lu max=%lu us, break=%lu us",
+             (unsigned long)st.period_target_us, (unsigned long)st.period_min_us,
+             (unsigned long)st.period_mean_us, (unsigned long)st.period_max_us,
+             (unsigned long)st.break_us);
+    ESP_LOGI(TAG, "CPU per frame: last=%lu max=%lu us",
+             (unsigned long)st.cpu_time_last_us, (unsigned long)st.cpu_time_max_us);
+    ESP_LOGI(TAG, "RX: frames=%lu errors=%lu overflows=%lu",
+             (unsigned long)st.rx_frames, (unsigned long)st.rx_errors,
+             (unsigned long)st.rx_overflows);
 
-        if (bytes_written != (ctx->universe_size + 1))
+    for (int i = 0; i < DMX_JITTER_BUCKETS; i++)
+    {
+        if (bucket_limits[i] == UINT32_MAX)
         {
-            ESP_LOGW(TAG, "DMX write incomplete: %d/%d bytes",
-                     bytes_written, ctx->universe_size + 1);
-            return ESP_FAIL;
+            ESP_LOGI(TAG, "Jitter  > %5lu us: %lu", (unsigned long)bucket_limits[i - 1],
+                     (unsigned long)st.jitter_hist[i]);
+        }
+        else
+        {
+            ESP_LOGI(TAG, "Jitter <= %5lu us: %lu", (unsigned long)bucket_limits[i],
+                     (unsigned long)st.jitter_hist[i]);
         }
-
-        uart_wait_tx_done(ctx->uart_num, pdMS_TO_TICKS(DMX_PACKET_TIMEOUT_MS));
-        return ESP_OK;
     }
 
-    return ESP_FAIL;
+    return ESP_OK;
 }
 
 esp_err_t dmx_start_transmission(dmx_handle_t handle)
@@ -345,16 +677,16 @@ esp_err_t dmx_start_transmission(dmx_handle_t handle)
 
     dmx_context_t *ctx = (dmx_context_t *)handle;
 
-    if (ctx->is_running)
+    if (ctx->is_running || ctx->mode != DMX_MODE_TX)
     {
-        ESP_LOGW(TAG, "DMX transmission already running");
+        ESP_LOGW(TAG, "DMX transmission already running or port in receive mode");
         return ESP_ERR_INVALID_STATE;
     }
 
     ctx->is_running = true;
 
     BaseType_t ret = xTaskCreate(dmx_tx_task, "dmx_tx", DMX_TASK_STACK_SIZE,
-                                 ctx, DMX_TASK_PRIORITY, &ctx->tx_task_handle);
+                                 ctx, DMX_TASK_PRIORITY, &ctx->task_handle);
 
     if (ret != pdPASS)
     {
@@ -363,7 +695,24 @@ esp_err_t dmx_start_transmission(dmx_handle_t handle)
         return ESP_FAIL;
     }
 
-    ESP_LOGI(TAG, "DMX continuous transmission started");
+    const esp_timer_create_args_t timer_args = {
+        .callback = dmx_frame_timer_cb,
+        .arg = ctx,
+        .name = "dmx_frame"};
+    esp_err_t err = esp_timer_create(&timer_args, &ctx->frame_timer);
+    if (err == ESP_OK)
+    {
+        err = esp_timer_start_periodic(ctx->frame_timer, ctx->frame_period_us);
+    }
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to start DMX frame timer");
+        dmx_stop_transmission(handle);
+        return err;
+    }
+
+    ESP_LOGI(TAG, "DMX continuous transmission started (%lu us/frame, idle %lu us)",
+             (unsigned long)ctx->frame_period_us, (unsigned long)ctx->idle_period_us);
     return ESP_OK;
 }
 
@@ -383,17 +732,128 @@ esp_err_t dmx_stop_transmission(dmx_handle_t handle)
 
     ctx->is_running = false;
 
-    if (ctx->tx_task_handle != NULL)
+    if (ctx->frame_timer != NULL)
     {
+        esp_timer_stop(ctx->frame_timer);
+    }
+
+    if (ctx->task_handle != NULL)
+    {
+        xTaskNotifyGive(ctx->task_handle);
         vTaskDelay(pdMS_TO_TICKS(50));
-        ctx->tx_task_handle = NULL;
+        ctx->task_handle = NULL;
+    }
+
+    if (ctx->frame_timer != NULL)
+    {
+        esp_timer_delete(ctx->frame_timer);
+        ctx->frame_timer = NULL;
     }
 
     ESP_LOGI(TAG, "DMX continuous transmission stopped");
     return ESP_OK;
 }
 
-esp_err_t dmx_clear_all(dmx_handle_t handle)
+esp_err_t dmx_set_rx_callback(dmx_handle_t handle, dmx_rx_callback_t callback, void *user_ctx)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    ctx->rx_callback = callback;
+    ctx->rx_user_ctx = user_ctx;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_add_tx_callback(dmx_handle_t handle, dmx_tx_callback_t callback, void *user_ctx)
+{
+    if (handle == NULL || callback == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    for (uint8_t i = 0; i < ctx->tx_callback_count; i++)
+    {
+        if (ctx->tx_callbacks[i] == callback && ctx->tx_user_ctx[i] == user_ctx)
+        {
+            ret = ESP_ERR_INVALID_STATE;
+        }
+    }
+    if (ret == ESP_OK && ctx->tx_callback_count >= DMX_MAX_TX_CALLBACKS)
+    {
+        ret = ESP_ERR_NO_MEM;
+    }
+    if (ret == ESP_OK)
+    {
+        ctx->tx_callbacks[ctx->tx_callback_count] = callback;
+        ctx->tx_user_ctx[ctx->tx_callback_count] = user_ctx;
+        ctx->tx_callback_count++;
+    }
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    return ret;
+}
+
+esp_err_t dmx_remove_tx_callback(dmx_handle_t handle, dmx_tx_callback_t callback, void *user_ctx)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    uint32_t gen;
+    TaskHandle_t running;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    gen = ctx->tx_callback_gen;
+    running = ctx->tx_callback_task;
+    for (uint8_t i = 0; i < ctx->tx_callback_count; i++)
+    {
+        if (ctx->tx_callbacks[i] == callback && ctx->tx_user_ctx[i] == user_ctx)
+        {
+            // Keep the order of the others, it decides who wins a shared channel
+            for (uint8_t j = i + 1; j < ctx->tx_callback_count; j++)
+            {
+                ctx->tx_callbacks[j - 1] = ctx->tx_callbacks[j];
+                ctx->tx_user_ctx[j - 1] = ctx->tx_user_ctx[j];
+            }
+            ctx->tx_callback_count--;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    // A slot that started before the removal may still call it; wait for that
+    // slot to finish, unless the caller is that slot
+    if (ret == ESP_OK && (gen & 1) && running != xTaskGetCurrentTaskHandle())
+    {
+        uint32_t now_gen = gen;
+        while (now_gen == gen)
+        {
+            vTaskDelay(1);
+            portENTER_CRITICAL(&ctx->frame_lock);
+            now_gen = ctx->tx_callback_gen;
+            portEXIT_CRITICAL(&ctx->frame_lock);
+        }
+    }
+
+    return ret;
+}
+
+esp_err_t dmx_start_reception(dmx_handle_t handle)
 {
     if (handle == NULL)
     {
@@ -402,13 +862,74 @@ esp_err_t dmx_clear_all(dmx_handle_t handle)
 
     dmx_context_t *ctx = (dmx_context_t *)handle;
 
-    if (xSemaphoreTake(ctx->mutex, portMAX_DELAY) == pdTRUE)
+    if (ctx->is_running || ctx->mode != DMX_MODE_RX)
+    {
+        ESP_LOGW(TAG, "DMX reception already running or port in transmit mode");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ctx->rx_len = 0;
+    ctx->rx_synced = false;
+    ctx->is_running = true;
+
+    esp_err_t ret = dmx_port_start_rx(ctx);
+    if (ret != ESP_OK)
+    {
+        ctx->is_running = false;
+        ESP_LOGE(TAG, "Failed to start DMX reception: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "DMX reception started");
+    return ESP_OK;
+}
+
+esp_err_t dmx_stop_reception(dmx_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    if (!ctx->is_running || ctx->mode != DMX_MODE_RX)
     {
-        memset(&ctx->dmx_data[1], 0, ctx->universe_size);
-        xSemaphoreGive(ctx->mutex);
-        ESP_LOGI(TAG, "All DMX channels cleared");
         return ESP_OK;
     }
 
-    return ESP_FAIL;
+    ctx->is_running = false;
+
+    if (ctx->task_handle != NULL)
+    {
+        // The task polls is_running at least every 100 ms
+        vTaskDelay(pdMS_TO_TICKS(150));
+        ctx->task_handle = NULL;
+    }
+
+    ESP_LOGI(TAG, "DMX reception stopped");
+    return ESP_OK;
+}
+
+esp_err_t dmx_clear_all(dmx_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    if (ctx->fade_count > 0)
+    {
+        dmx_fade_cancel_locked(ctx, ctx->dmx_data, 1, ctx->universe_size);
+    }
+    memset(&ctx->dmx_data[1], 0, ctx->universe_size);
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    atomic_store(&ctx->dirty, true);
+
+    ESP_LOGI(TAG, "All DMX channels cleared");
+    return ESP_OK;
 }
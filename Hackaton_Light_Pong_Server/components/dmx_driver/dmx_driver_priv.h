@@ -0,0 +1,248 @@
+/**
+ * @file dmx_driver_priv.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Internal DMX driver definitions shared between driver sources
+ */
+
+#ifndef DMX_DRIVER_PRIV_H
+#define DMX_DRIVER_PRIV_H
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "dmx_driver.h"
+#include "dmx_fade.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DMX_TX_BUFFER_SIZE 1024
+#define DMX_RX_BUFFER_SIZE 256 // Minimum required by UART driver (even in TX-only mode)
+#define DMX_TASK_STACK_SIZE 4096
+#define DMX_TASK_PRIORITY 5
+#define DMX_RX_TASK_PRIORITY 6 // Above TX so a merger never drops incoming slots
+#define DMX_RX_QUEUE_SIZE 20
+#define DMX_RX_FULL_THRESHOLD 64 // Bytes in FIFO before an RX interrupt
+#define DMX_RX_TIMEOUT_SYMBOLS 2 // Flush the FIFO after ~88 us of silence
+
+    typedef struct dmx_merge dmx_merge_t;
+    typedef struct dmx_fade_engine dmx_fade_engine_t;
+    typedef struct dmx_rdm dmx_rdm_t;
+
+    /**
+     * @brief DMX driver context structure
+     */
+    typedef struct
+    {
+        uart_port_t uart_num;
+        gpio_num_t tx_pin;
+        gpio_num_t rx_pin;
+        gpio_num_t enable_pin;
+        uint16_t universe_size;
+        dmx_mode_t mode;
+        dmx_break_mode_t break_mode;
+        bool break_on_line;      // Previous frame ended with a hardware BREAK
+        dmx_refresh_mode_t refresh_mode;
+        uint32_t frame_period_us;
+        uint32_t idle_period_us; // 0 = idle mode disabled
+        uint16_t highest_channel; // Highest channel ever written (trimmed mode length)
+        uint16_t tx_len;          // Bytes in tx_frame including the start code
+        atomic_bool dirty;        // Back buffer changed since the last snapshot
+        esp_timer_handle_t frame_timer;
+        uint8_t *rx_buf[2];       // Receive double buffer, rx_back is being filled
+        uint8_t rx_back;
+        uint16_t rx_len;          // Bytes received into rx_buf[rx_back]
+        uint16_t rx_front_len;    // Length of the last complete frame
+        bool rx_synced;           // A BREAK was seen since the last error
+        QueueHandle_t uart_queue;
+        void *port;               // Line backend state (virtual wire)
+        dmx_rx_callback_t rx_callback;
+        void *rx_user_ctx;
+        dmx_tx_callback_t tx_callbacks[DMX_MAX_TX_CALLBACKS]; // Frame slot callbacks, changed under frame_lock
+        void *tx_user_ctx[DMX_MAX_TX_CALLBACKS];
+        uint8_t tx_callback_count;
+        uint32_t tx_callback_gen; // Odd while a slot's callbacks run, changed under frame_lock
+        TaskHandle_t tx_callback_task; // Task running them, NULL between slots
+        dmx_stats_t stats;        // Written by the transmit path, copied under frame_lock
+        uint64_t period_sum_us;
+        uint32_t period_count;
+        bool period_valid;        // Previous frame slot was sent, next period is measurable
+        uint8_t *dmx_data;       // Back buffer, written lock-free by the set/clear API
+        uint8_t *tx_frame;       // Front buffer, snapshot of dmx_data sent on the wire
+        dmx_merge_t *merge;      // Source layers merged into tx_frame, NULL until first used
+        dmx_fade_engine_t *fade; // Running fades, NULL until first used
+        uint16_t fade_count;     // Running fades, changed under frame_lock
+        dmx_rdm_t *rdm;          // RDM controller, NULL until first used
+        portMUX_TYPE frame_lock; // Keeps bulk writes and the frame snapshot apart
+        TaskHandle_t task_handle;
+        int64_t last_tx_us;       // Time of the last frame slot that was not idle-skipped
+        bool is_running;          // Owned by a TX/RX task or a scheduler
+    } dmx_context_t;
+
+    /**
+     * @brief Record a write up to last_channel; call after the data is stored
+     *
+     * The lock is only taken on the rare path where the trimmed length grows.
+     */
+    static inline void dmx_mark_dirty(dmx_context_t *ctx, uint16_t last_channel)
+    {
+        if (last_channel > ctx->highest_channel)
+        {
+            portENTER_CRITICAL(&ctx->frame_lock);
+            if (last_channel > ctx->highest_channel)
+            {
+                ctx->highest_channel = last_channel;
+            }
+            portEXIT_CRITICAL(&ctx->frame_lock);
+        }
+        atomic_store(&ctx->dirty, true);
+    }
+
+    /**
+     * @brief Send one frame: snapshot, BREAK/MAB and queue the data
+     *
+     * @param ctx Driver context
+     * @param ready_timeout How long to wait for the previous frame to leave the wire
+     * @param wait_done Block until this frame has been shifted out
+     * @return
+     *      - ESP_OK: Frame queued (and sent, if wait_done)
+     *      - ESP_ERR_TIMEOUT: Previous frame still on the wire, nothing sent
+     *      - ESP_FAIL: UART did not accept the whole frame
+     */
+    esp_err_t dmx_transmit_frame(dmx_context_t *ctx, TickType_t ready_timeout, bool wait_done);
+
+    /**
+     * @brief Run the frame slot callbacks for the slot at time now
+     *
+     * @param ctx Driver context
+     * @param now esp_timer timestamp of the frame slot
+     */
+    void dmx_run_tx_callback(dmx_context_t *ctx, int64_t now);
+
+    /**
+     * @brief Decide whether a frame slot at time now should be transmitted
+     *
+     * Applies idle mode and updates the idle statistics.
+     *
+     * @param ctx Driver context
+     * @param now esp_timer timestamp of the frame slot
+     * @return true if the frame should be sent
+     */
+    bool dmx_frame_due(dmx_context_t *ctx, int64_t now);
+
+    /**
+     * @brief Count frame slots that were lost and restart the period statistics
+     *
+     * Takes the frame lock like the other statistics updates.
+     *
+     * @param ctx Driver context
+     * @param frames Number of lost frame slots
+     */
+    void dmx_record_dropped(dmx_context_t *ctx, uint32_t frames);
+
+    /**
+     * @brief Publish the receive back buffer as the latest frame at a BREAK
+     *
+     * Called by the line backend's receive task.
+     *
+     * @param ctx Driver context
+     */
+    void dmx_rx_complete_frame(dmx_context_t *ctx);
+
+    /**
+     * @brief Merge all source layers into a frame; call without frame_lock
+     *
+     * Only takes frame_lock to copy the source list, so the per-channel work
+     * never runs with interrupts masked.
+     *
+     * @param ctx Driver context, ctx->merge not NULL
+     * @param frame Frame already holding the back buffer snapshot, merged in place
+     * @param length Frame length including the start code
+     */
+    void dmx_merge_apply(dmx_context_t *ctx, uint8_t *frame, uint16_t length);
+
+    /**
+     * @brief Start fades on a layer (back buffer or source values)
+     *
+     * Takes frame_lock; the channel range must already be validated.
+     *
+     * @param ctx Driver context
+     * @param layer Layer the fades write to, indexed by channel
+     * @param start_channel First channel
+     * @param targets Target values, one per channel
+     * @param length Number of channels
+     * @param duration_ms Fade time
+     * @param curve Fade curve
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_NO_MEM: Out of memory or DMX_MAX_FADES reached
+     */
+    esp_err_t dmx_fade_start(dmx_context_t *ctx, uint8_t *layer, uint16_t start_channel,
+                             const uint8_t *targets, uint16_t length,
+                             uint32_t duration_ms, dmx_fade_curve_t curve);
+
+    /**
+     * @brief Advance all running fades to time now; call without frame_lock
+     *
+     * Takes frame_lock for a small batch of fades at a time.
+     *
+     * @param ctx Driver context
+     * @param now esp_timer timestamp of the frame
+     */
+    void dmx_fade_apply(dmx_context_t *ctx, int64_t now);
+
+    /**
+     * @brief Drop running fades on a channel range of a layer; call with frame_lock held
+     *
+     * @param ctx Driver context
+     * @param layer Layer the fades write to
+     * @param start_channel First channel
+     * @param length Number of channels
+     */
+    void dmx_fade_cancel_locked(dmx_context_t *ctx, const uint8_t *layer,
+                                uint16_t start_channel, uint16_t length);
+
+    /**
+     * @brief Free the fade engine
+     *
+     * @param fade Fade engine, may be NULL
+     */
+    void dmx_fade_free(dmx_fade_engine_t *fade);
+
+    /**
+     * @brief Run a pending RDM transaction if it fits before the line is needed
+     *
+     * Called by the transmission task once per frame slot, after the frame
+     * (if any) has left the line.
+     *
+     * @param ctx Driver context, ctx->rdm not NULL
+     * @param slot_start esp_timer timestamp of the frame slot
+     * @param frame_sent A frame was sent in this slot (false for idle slots)
+     */
+    void dmx_rdm_service(dmx_context_t *ctx, int64_t slot_start, bool frame_sent);
+
+    /**
+     * @brief Free the RDM controller state
+     *
+     * @param rdm RDM state, may be NULL
+     */
+    void dmx_rdm_free(dmx_rdm_t *rdm);
+
+    /**
+     * @brief Free the merge state and all of its sources
+     *
+     * @param merge Merge state, may be NULL
+     */
+    void dmx_merge_free(dmx_merge_t *merge);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_DRIVER_PRIV_H
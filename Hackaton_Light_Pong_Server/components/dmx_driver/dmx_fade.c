@@ -0,0 +1,308 @@
+/**
+ * @file dmx_fade.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Per-channel fade engine implementation
+ */
+
+#include "dmx_fade.h"
+#include "dmx_driver_priv.h"
+#include <stdlib.h>
+#include "esp_log.h"
+
+static const char *TAG = "DMX_FADE";
+
+#define DMX_FADE_ONE 32768 // 1.0 in the Q15 phase and curve values
+#define DMX_FADE_BATCH 16  // Fades advanced per frame_lock section
+
+/**
+ * @brief One running fade
+ */
+typedef struct
+{
+    uint64_t recip;       // 2^47 / duration_us, phase = (t * recip) >> 32 in Q15
+    uint8_t *layer;       // Back buffer or source values
+    uint32_t start_us;    // Low 32 bits of esp_timer; differences are wrap-safe
+    uint32_t duration_us;
+    uint16_t channel;
+    int16_t delta;        // target - from
+    uint8_t from;
+    uint8_t curve;
+} dmx_fade_slot_t;
+
+/**
+ * @brief Fade engine of one universe; ctx->fade_count slots are in use
+ */
+struct dmx_fade_engine
+{
+    dmx_fade_slot_t slots[DMX_MAX_FADES];
+};
+
+/**
+ * @brief Shape a Q15 phase with the fade curve
+ */
+static inline uint32_t dmx_fade_shape(uint8_t curve, uint32_t x)
+{
+    switch (curve)
+    {
+    case DMX_FADE_EASE_IN:
+        return (x * x) >> 15;
+
+    case DMX_FADE_EASE_OUT:
+    {
+        uint32_t r = DMX_FADE_ONE - x;
+        return DMX_FADE_ONE - ((r * r) >> 15);
+    }
+
+    case DMX_FADE_EASE_IN_OUT:
+    {
+        // Smoothstep x^2 * (3 - 2x); stays within 32 bits for x < 1.0
+        uint32_t x2 = (x * x) >> 15;
+        return (x2 * (3 * DMX_FADE_ONE - 2 * x)) >> 15;
+    }
+
+    default:
+        return x;
+    }
+}
+
+/**
+ * @brief Count running fades on a channel range of a layer
+ */
+static uint16_t dmx_fade_count_range(dmx_context_t *ctx, const uint8_t *layer,
+                                     uint16_t start_channel, uint16_t length)
+{
+    uint16_t n = 0;
+
+    for (uint16_t i = 0; i < ctx->fade_count; i++)
+    {
+        const dmx_fade_slot_t *slot = &ctx->fade->slots[i];
+        if (slot->layer == layer && slot->channel >= start_channel &&
+            slot->channel < start_channel + length)
+        {
+            n++;
+        }
+    }
+
+    return n;
+}
+
+void dmx_fade_cancel_locked(dmx_context_t *ctx, const uint8_t *layer,
+                            uint16_t start_channel, uint16_t length)
+{
+    uint16_t i = 0;
+
+    while (i < ctx->fade_count)
+    {
+        dmx_fade_slot_t *slot = &ctx->fade->slots[i];
+        if (slot->layer == layer && slot->channel >= start_channel &&
+            slot->channel < start_channel + length)
+        {
+            *slot = ctx->fade->slots[--ctx->fade_count];
+            continue;
+        }
+        i++;
+    }
+}
+
+esp_err_t dmx_fade_start(dmx_context_t *ctx, uint8_t *layer, uint16_t start_channel,
+                         const uint8_t *targets, uint16_t length,
+                         uint32_t duration_ms, dmx_fade_curve_t curve)
+{
+    if (ctx->fade == NULL && duration_ms > 0)
+    {
+        dmx_fade_engine_t *fade = (dmx_fade_engine_t *)calloc(1, sizeof(dmx_fade_engine_t));
+        if (fade == NULL)
+        {
+            ESP_LOGE(TAG, "Failed to allocate fade engine");
+            return ESP_ERR_NO_MEM;
+        }
+
+        portENTER_CRITICAL(&ctx->frame_lock);
+        if (ctx->fade == NULL)
+        {
+            ctx->fade = fade;
+            fade = NULL;
+        }
+        portEXIT_CRITICAL(&ctx->frame_lock);
+        free(fade);
+    }
+
+    const uint32_t duration_us = duration_ms * 1000;
+    const uint64_t recip = (duration_us > 0) ? ((1ULL << 47) / duration_us) : 0;
+    const uint32_t now = (uint32_t)esp_timer_get_time();
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+
+    if (ctx->fade != NULL)
+    {
+        if (duration_ms > 0 &&
+            ctx->fade_count - dmx_fade_count_range(ctx, layer, start_channel, length) + length > DMX_MAX_FADES)
+        {
+            ret = ESP_ERR_NO_MEM;
+        }
+        else
+        {
+            dmx_fade_cancel_locked(ctx, layer, start_channel, length);
+        }
+    }
+
+    if (ret == ESP_OK)
+    {
+        for (uint16_t i = 0; i < length; i++)
+        {
+            const uint16_t channel = start_channel + i;
+
+            if (duration_ms == 0 || layer[channel] == targets[i])
+            {
+                layer[channel] = targets[i];
+                continue;
+            }
+
+            dmx_fade_slot_t *slot = &ctx->fade->slots[ctx->fade_count++];
+            slot->recip = recip;
+            slot->layer = layer;
+            slot->start_us = now;
+            slot->duration_us = duration_us;
+            slot->channel = channel;
+            slot->from = layer[channel];
+            slot->delta = (int16_t)targets[i] - (int16_t)layer[channel];
+            slot->curve = (uint8_t)curve;
+        }
+    }
+
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Fade pool full (%d fades)", DMX_MAX_FADES);
+        return ret;
+    }
+
+    dmx_mark_dirty(ctx, start_channel + length - 1);
+    return ESP_OK;
+}
+
+void dmx_fade_apply(dmx_context_t *ctx, int64_t now)
+{
+    const uint32_t now32 = (uint32_t)now;
+    dmx_fade_slot_t *slots = ctx->fade->slots;
+    uint16_t i = 0;
+    bool more = true;
+
+    // Interrupts are masked for one batch at a time, not for the whole pool. A
+    // fade moved by a cancel between batches may miss this frame; its value
+    // only depends on the time, so the next frame catches up.
+    while (more)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        for (uint16_t n = 0; n < DMX_FADE_BATCH && i < ctx->fade_count; n++)
+        {
+            dmx_fade_slot_t *slot = &slots[i];
+            uint32_t t = now32 - slot->start_us;
+
+            if (t >= slot->duration_us)
+            {
+                slot->layer[slot->channel] = (uint8_t)(slot->from + slot->delta);
+                *slot = slots[--ctx->fade_count];
+                continue;
+            }
+
+            uint32_t x = (uint32_t)(((uint64_t)t * slot->recip) >> 32);
+            int32_t step = ((int32_t)slot->delta * (int32_t)dmx_fade_shape(slot->curve, x)) >> 15;
+            slot->layer[slot->channel] = (uint8_t)(slot->from + step);
+            i++;
+        }
+        more = i < ctx->fade_count;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+    }
+}
+
+void dmx_fade_free(dmx_fade_engine_t *fade)
+{
+    free(fade);
+}
+
+/**
+ * @brief Validate a back buffer channel range for the public fade API
+ */
+static esp_err_t dmx_fade_check_range(dmx_context_t *ctx, uint16_t start_channel, uint16_t length,
+                                      uint32_t duration_ms)
+{
+    if (start_channel == 0 || length == 0 || start_channel > ctx->universe_size ||
+        (start_channel + length - 1) > ctx->universe_size)
+    {
+        ESP_LOGE(TAG, "Invalid channel range: %d-%d", start_channel, start_channel + length - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (duration_ms > DMX_FADE_MAX_MS)
+    {
+        ESP_LOGE(TAG, "Fade too long: %lu ms (max %d)", (unsigned long)duration_ms, DMX_FADE_MAX_MS);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_fade_channel(dmx_handle_t handle, uint16_t channel, uint8_t target,
+                           uint32_t duration_ms, dmx_fade_curve_t curve)
+{
+    return dmx_fade_channels(handle, channel, &target, 1, duration_ms, curve);
+}
+
+esp_err_t dmx_fade_channels(dmx_handle_t handle, uint16_t start_channel, const uint8_t *targets,
+                            uint16_t length, uint32_t duration_ms, dmx_fade_curve_t curve)
+{
+    if (handle == NULL || targets == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    esp_err_t ret = dmx_fade_check_range(ctx, start_channel, length, duration_ms);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    return dmx_fade_start(ctx, ctx->dmx_data, start_channel, targets, length, duration_ms, curve);
+}
+
+esp_err_t dmx_fade_cancel(dmx_handle_t handle, uint16_t start_channel, uint16_t length)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    esp_err_t ret = dmx_fade_check_range(ctx, start_channel, length, 0);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    if (ctx->fade != NULL)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        dmx_fade_cancel_locked(ctx, ctx->dmx_data, start_channel, length);
+        portEXIT_CRITICAL(&ctx->frame_lock);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_fade_get_active(dmx_handle_t handle, uint16_t *out_count)
+{
+    if (handle == NULL || out_count == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *out_count = ((dmx_context_t *)handle)->fade_count;
+    return ESP_OK;
+}
@@ -0,0 +1,558 @@
+/**
+ * @file dmx_merge.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Multi-source HTP/LTP merge implementation
+ */
+
+#include "dmx_merge.h"
+#include "dmx_driver_priv.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+
+static const char *TAG = "DMX_MERGE";
+
+#define DMX_MERGE_RETRIES 2 // Extra passes when a bulk write lands during a merge
+
+/**
+ * @brief One source layer
+ */
+typedef struct
+{
+    dmx_context_t *ctx;
+    char name[DMX_SOURCE_NAME_LEN];
+    uint8_t priority;
+    uint8_t id;      // 1..DMX_MAX_SOURCES, 0 marks "no writer" in last_writer
+    uint8_t *values; // Layer values, indexed by channel
+    uint8_t *owned;  // 0xFF where the source owns the channel, 0x00 otherwise
+} dmx_source_t;
+
+/**
+ * @brief Merge state of one universe
+ *
+ * All per-channel arrays are universe_size + 1 bytes so they can be indexed
+ * by channel number like the frame itself. The merge loops only use byte
+ * masks (0x00/0xFF) and max, no per-channel branches, so the compiler can
+ * vectorize them where the target supports it.
+ *
+ * The merge runs without frame_lock. Bulk writers bump write_seq under the
+ * lock, and a merge that overlapped one is redone, so a frame still never
+ * carries half of a bulk update. Sources stay allocated while applying is set.
+ */
+struct dmx_merge
+{
+    dmx_source_t *sources[DMX_MAX_SOURCES]; // Sorted by ascending priority
+    uint8_t source_count;
+    uint8_t used_ids;     // Bit n set: id n + 1 is taken
+    bool applying;        // The transmit path is merging from a copy of sources[]
+    uint32_t write_seq;   // Bumped by every bulk write, under frame_lock
+    uint8_t *last_writer; // Id of the source that wrote each channel last
+    uint8_t *rule_ltp;    // 0xFF for LTP channels, 0x00 for HTP
+    uint8_t *htp;         // Scratch: highest value within a priority group
+    uint8_t *ltp;         // Scratch: value of the last writer within the group
+    uint8_t *ltp_mask;    // Scratch: last writer is part of the group
+    uint8_t *group_mask;  // Scratch: any source of the group owns the channel
+    uint8_t *base;        // Scratch: the frame before merging, for a second pass
+};
+
+/**
+ * @brief Get the merge state of a universe, allocating it on first use
+ */
+static esp_err_t dmx_merge_get(dmx_context_t *ctx, dmx_merge_t **out_merge)
+{
+    if (ctx->mode != DMX_MODE_TX)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (ctx->merge != NULL)
+    {
+        *out_merge = ctx->merge;
+        return ESP_OK;
+    }
+
+    const size_t n = ctx->universe_size + 1;
+    dmx_merge_t *merge = (dmx_merge_t *)calloc(1, sizeof(dmx_merge_t));
+    uint8_t *arrays = (uint8_t *)calloc(7, n);
+    if (merge == NULL || arrays == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate merge state");
+        free(merge);
+        free(arrays);
+        return ESP_ERR_NO_MEM;
+    }
+
+    merge->last_writer = arrays;
+    merge->rule_ltp = arrays + n;
+    merge->htp = arrays + 2 * n;
+    merge->ltp = arrays + 3 * n;
+    merge->ltp_mask = arrays + 4 * n;
+    merge->group_mask = arrays + 5 * n;
+    merge->base = arrays + 6 * n;
+    memset(merge->rule_ltp, 0xFF, n);
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    ctx->merge = merge;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    *out_merge = merge;
+    return ESP_OK;
+}
+
+/**
+ * @brief Merge a copy of the source list into a frame; runs without frame_lock
+ */
+static void dmx_merge_layers(dmx_merge_t *merge, dmx_source_t *const *sources, uint8_t source_count,
+                             uint8_t *frame, uint16_t length)
+{
+    uint8_t *htp = merge->htp;
+    uint8_t *ltp = merge->ltp;
+    uint8_t *ltp_mask = merge->ltp_mask;
+    uint8_t *group_mask = merge->group_mask;
+    const uint8_t *last_writer = merge->last_writer;
+    const uint8_t *rule_ltp = merge->rule_ltp;
+
+    uint8_t i = 0;
+    while (i < source_count)
+    {
+        const uint8_t priority = sources[i]->priority;
+
+        memset(htp, 0, length);
+        memset(ltp, 0, length);
+        memset(ltp_mask, 0, length);
+        memset(group_mask, 0, length);
+
+        // Combine all sources of one priority
+        for (; i < source_count && sources[i]->priority == priority; i++)
+        {
+            const dmx_source_t *src = sources[i];
+            const uint8_t *values = src->values;
+            const uint8_t *owned = src->owned;
+            const uint8_t id = src->id;
+
+            for (uint16_t ch = 1; ch < length; ch++)
+            {
+                uint8_t v = values[ch] & owned[ch];
+                uint8_t last = owned[ch] & (uint8_t)-(last_writer[ch] == id);
+                htp[ch] = (v > htp[ch]) ? v : htp[ch];
+                ltp[ch] |= v & last;
+                ltp_mask[ch] |= last;
+                group_mask[ch] |= owned[ch];
+            }
+        }
+
+        // LTP falls back to HTP when the last writer released the channel;
+        // the group then overrides everything below it where it owns a channel
+        for (uint16_t ch = 1; ch < length; ch++)
+        {
+            uint8_t sel = rule_ltp[ch] & ltp_mask[ch];
+            uint8_t v = (ltp[ch] & sel) | (htp[ch] & (uint8_t)~sel);
+            frame[ch] = (v & group_mask[ch]) | (frame[ch] & (uint8_t)~group_mask[ch]);
+        }
+    }
+}
+
+void dmx_merge_apply(dmx_context_t *ctx, uint8_t *frame, uint16_t length)
+{
+    dmx_merge_t *merge = ctx->merge;
+    dmx_source_t *sources[DMX_MAX_SOURCES];
+    uint8_t source_count;
+    uint32_t seq;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    source_count = merge->source_count;
+    memcpy(sources, merge->sources, source_count * sizeof(sources[0]));
+    seq = merge->write_seq;
+    merge->applying = true;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (source_count == 0)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        merge->applying = false;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+        return;
+    }
+
+    memcpy(merge->base, frame, length);
+    for (int pass = 0;; pass++)
+    {
+        dmx_merge_layers(merge, sources, source_count, frame, length);
+
+        portENTER_CRITICAL(&ctx->frame_lock);
+        if (merge->write_seq == seq || pass == DMX_MERGE_RETRIES)
+        {
+            merge->applying = false;
+            portEXIT_CRITICAL(&ctx->frame_lock);
+            return;
+        }
+        // A bulk write overlapped the merge; redo it with the finished write
+        source_count = merge->source_count;
+        memcpy(sources, merge->sources, source_count * sizeof(sources[0]));
+        seq = merge->write_seq;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+
+        memcpy(frame, merge->base, length);
+    }
+}
+
+void dmx_merge_free(dmx_merge_t *merge)
+{
+    if (merge == NULL)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < merge->source_count; i++)
+    {
+        free(merge->sources[i]->values);
+        free(merge->sources[i]);
+    }
+    free(merge->last_writer); // Start of the shared per-channel allocation
+    free(merge);
+}
+
+esp_err_t dmx_source_create(dmx_handle_t handle, const char *name, uint8_t priority,
+                            dmx_source_handle_t *out_source)
+{
+    if (handle == NULL || name == NULL || out_source == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    dmx_merge_t *merge;
+    esp_err_t ret = dmx_merge_get(ctx, &merge);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    if (merge->source_count >= DMX_MAX_SOURCES)
+    {
+        ESP_LOGE(TAG, "Maximum number of sources reached (%d)", DMX_MAX_SOURCES);
+        return ESP_ERR_NO_MEM;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)calloc(1, sizeof(dmx_source_t));
+    uint8_t *arrays = (uint8_t *)calloc(2, ctx->universe_size + 1);
+    if (src == NULL || arrays == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate source '%s'", name);
+        free(src);
+        free(arrays);
+        return ESP_ERR_NO_MEM;
+    }
+
+    src->ctx = ctx;
+    strncpy(src->name, name, DMX_SOURCE_NAME_LEN - 1);
+    src->priority = priority;
+    src->values = arrays;
+    src->owned = arrays + ctx->universe_size + 1;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    uint8_t id = 0;
+    while (merge->used_ids & (1U << id))
+    {
+        id++;
+    }
+    merge->used_ids |= (1U << id);
+    src->id = id + 1;
+
+    // Insert after all sources of lower or equal priority
+    uint8_t pos = merge->source_count;
+    while (pos > 0 && merge->sources[pos - 1]->priority > priority)
+    {
+        merge->sources[pos] = merge->sources[pos - 1];
+        pos--;
+    }
+    merge->sources[pos] = src;
+    merge->source_count++;
+    merge->write_seq++;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    *out_source = (dmx_source_handle_t)src;
+    ESP_LOGI(TAG, "Source '%s' created (priority %d)", src->name, priority);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_source_delete(dmx_source_handle_t source)
+{
+    if (source == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)source;
+    dmx_context_t *ctx = src->ctx;
+    dmx_merge_t *merge = ctx->merge;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    uint8_t pos = 0;
+    while (pos < merge->source_count && merge->sources[pos] != src)
+    {
+        pos++;
+    }
+    for (; pos + 1 < merge->source_count; pos++)
+    {
+        merge->sources[pos] = merge->sources[pos + 1];
+    }
+    merge->source_count--;
+    merge->used_ids &= ~(1U << (src->id - 1));
+    merge->write_seq++;
+    if (ctx->fade_count > 0)
+    {
+        dmx_fade_cancel_locked(ctx, src->values, 1, ctx->universe_size);
+    }
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    atomic_store(&ctx->dirty, true);
+
+    // A merge in progress may still read the source from its copy of the list
+    bool applying = true;
+    while (applying)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        applying = merge->applying;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+        if (applying)
+        {
+            vTaskDelay(1);
+        }
+    }
+
+    ESP_LOGI(TAG, "Source '%s' deleted", src->name);
+    free(src->values);
+    free(src);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_source_set_channel(dmx_source_handle_t source, uint16_t channel, uint8_t value)
+{
+    if (source == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)source;
+    dmx_context_t *ctx = src->ctx;
+
+    if (channel == 0 || channel > ctx->universe_size)
+    {
+        ESP_LOGE(TAG, "Invalid channel: %d (valid: 1-%d)", channel, ctx->universe_size);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (ctx->fade_count > 0)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        dmx_fade_cancel_locked(ctx, src->values, channel, 1);
+        portEXIT_CRITICAL(&ctx->frame_lock);
+    }
+
+    // Value before ownership, so the merge never sees a stale owned value
+    src->values[channel] = value;
+    src->owned[channel] = 0xFF;
+    ctx->merge->last_writer[channel] = src->id;
+    dmx_mark_dirty(ctx, channel);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_source_set_channels(dmx_source_handle_t source, uint16_t start_channel,
+                                  const uint8_t *data, uint16_t length)
+{
+    if (source == NULL || data == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)source;
+    dmx_context_t *ctx = src->ctx;
+
+    if (start_channel == 0 || start_channel > ctx->universe_size ||
+        (start_channel + length - 1) > ctx->universe_size)
+    {
+        ESP_LOGE(TAG, "Invalid channel range: %d-%d", start_channel, start_channel + length - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    if (ctx->fade_count > 0)
+    {
+        dmx_fade_cancel_locked(ctx, src->values, start_channel, length);
+    }
+    memcpy(&src->values[start_channel], data, length);
+    memset(&src->owned[start_channel], 0xFF, length);
+    memset(&ctx->merge->last_writer[start_channel], src->id, length);
+    ctx->merge->write_seq++;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    dmx_mark_dirty(ctx, start_channel + length - 1);
+    return ESP_OK;
+}
+
+esp_err_t dmx_source_set_channels_sparse(dmx_source_handle_t source,
+                                         const dmx_channel_value_t *pairs, uint16_t count)
+{
+    if (source == NULL || pairs == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)source;
+    dmx_context_t *ctx = src->ctx;
+
+    uint16_t last_channel = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (pairs[i].channel == 0 || pairs[i].channel > ctx->universe_size)
+        {
+            ESP_LOGE(TAG, "Invalid channel: %d (valid: 1-%d)", pairs[i].channel, ctx->universe_size);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (pairs[i].channel > last_channel)
+        {
+            last_channel = pairs[i].channel;
+        }
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (ctx->fade_count > 0)
+        {
+            dmx_fade_cancel_locked(ctx, src->values, pairs[i].channel, 1);
+        }
+        src->values[pairs[i].channel] = pairs[i].value;
+        src->owned[pairs[i].channel] = 0xFF;
+        ctx->merge->last_writer[pairs[i].channel] = src->id;
+    }
+    ctx->merge->write_seq++;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (count > 0)
+    {
+        dmx_mark_dirty(ctx, last_channel);
+    }
+    return ESP_OK;
+}
+
+esp_err_t dmx_source_release(dmx_source_handle_t source, uint16_t start_channel, uint16_t length)
+{
+    if (source == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)source;
+    dmx_context_t *ctx = src->ctx;
+
+    if (start_channel == 0 || start_channel > ctx->universe_size ||
+        (start_channel + length - 1) > ctx->universe_size)
+    {
+        ESP_LOGE(TAG, "Invalid channel range: %d-%d", start_channel, start_channel + length - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    if (ctx->fade_count > 0)
+    {
+        dmx_fade_cancel_locked(ctx, src->values, start_channel, length);
+    }
+    memset(&src->owned[start_channel], 0x00, length);
+    ctx->merge->write_seq++;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    atomic_store(&ctx->dirty, true);
+    return ESP_OK;
+}
+
+esp_err_t dmx_source_release_all(dmx_source_handle_t source)
+{
+    if (source == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)source;
+    return dmx_source_release(source, 1, src->ctx->universe_size);
+}
+
+esp_err_t dmx_merge_set_rule(dmx_handle_t handle, uint16_t start_channel, uint16_t length,
+                             dmx_merge_rule_t rule)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    if (start_channel == 0 || start_channel > ctx->universe_size ||
+        (start_channel + length - 1) > ctx->universe_size)
+    {
+        ESP_LOGE(TAG, "Invalid channel range: %d-%d", start_channel, start_channel + length - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_merge_t *merge;
+    esp_err_t ret = dmx_merge_get(ctx, &merge);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    memset(&merge->rule_ltp[start_channel], (rule == DMX_MERGE_LTP) ? 0xFF : 0x00, length);
+    merge->write_seq++;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    atomic_store(&ctx->dirty, true);
+    return ESP_OK;
+}
+
+esp_err_t dmx_source_fade_channel(dmx_source_handle_t source, uint16_t channel, uint8_t target,
+                                  uint32_t duration_ms, dmx_fade_curve_t curve)
+{
+    return dmx_source_fade_channels(source, channel, &target, 1, duration_ms, curve);
+}
+
+esp_err_t dmx_source_fade_channels(dmx_source_handle_t source, uint16_t start_channel,
+                                   const uint8_t *targets, uint16_t length,
+                                   uint32_t duration_ms, dmx_fade_curve_t curve)
+{
+    if (source == NULL || targets == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_source_t *src = (dmx_source_t *)source;
+    dmx_context_t *ctx = src->ctx;
+
+    if (start_channel == 0 || length == 0 || start_channel > ctx->universe_size ||
+        (start_channel + length - 1) > ctx->universe_size || duration_ms > DMX_FADE_MAX_MS)
+    {
+        ESP_LOGE(TAG, "Invalid fade: channels %d-%d, %lu ms", start_channel,
+                 start_channel + length - 1, (unsigned long)duration_ms);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = dmx_fade_start(ctx, src->values, start_channel, targets, length, duration_ms, curve);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    memset(&src->owned[start_channel], 0xFF, length);
+    memset(&ctx->merge->last_writer[start_channel], src->id, length);
+    ctx->merge->write_seq++;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    atomic_store(&ctx->dirty, true);
+    return ESP_OK;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file dmx_port.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Line backend interface of the DMX driver
+ *
+ * The frame loop, merge and statistics in dmx_driver.c are hardware
+ * independent. Everything that touches the line goes through these calls,
+ * implemented either by the UART/RS-485 backend (dmx_port_uart.c) or by the
+ * virtual wire (dmx_port_virtual.c, CONFIG_DMX_DRIVER_VIRTUAL_WIRE).
+ */
+
+#ifndef DMX_PORT_H
+#define DMX_PORT_H
+
+#include "dmx_driver_priv.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Set up the line for ctx->mode; ctx is fully initialized otherwise
+     *
+     * @param ctx Driver context
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_NOT_SUPPORTED: Mode not supported by this backend
+     *      - Others: Error from the underlying driver
+     */
+    esp_err_t dmx_port_init(dmx_context_t *ctx);
+
+    /**
+     * @brief Release the line
+     *
+     * @param ctx Driver context
+     */
+    void dmx_port_deinit(dmx_context_t *ctx);
+
+    /**
+     * @brief Wait until the previous frame (and trailing BREAK) left the line
+     *
+     * @param ctx Driver context
+     * @param timeout Maximum time to wait
+     * @return
+     *      - ESP_OK: Line is idle
+     *      - ESP_ERR_TIMEOUT: Still transmitting
+     */
+    esp_err_t dmx_port_wait_tx_done(dmx_context_t *ctx, TickType_t timeout);
+
+    /**
+     * @brief Generate BREAK and MAB on the CPU, updates ctx->stats.break_us
+     *
+     * @param ctx Driver context
+     */
+    void dmx_port_send_break(dmx_context_t *ctx);
+
+    /**
+     * @brief Queue a frame for transmission
+     *
+     * @param ctx Driver context
+     * @param data Frame including the start code
+     * @param length Frame length
+     * @param append_break Let the line append a DMX_BREAK_BITS BREAK after the frame
+     * @return Number of bytes accepted
+     */
+    int dmx_port_write(dmx_context_t *ctx, const uint8_t *data, uint16_t length, bool append_break);
+
+    /**
+     * @brief Turn the transceiver around for RDM
+     *
+     * Switching to receive discards anything still in the receive buffer.
+     *
+     * @param ctx Driver context of a DMX_MODE_TX port
+     * @param transmit true to drive the line, false to listen
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_NOT_SUPPORTED: Backend cannot receive
+     */
+    esp_err_t dmx_port_set_direction(dmx_context_t *ctx, bool transmit);
+
+    /**
+     * @brief Read received bytes, blocking until the first one arrives
+     *
+     * Returns as soon as at least one byte was read, together with whatever
+     * else is already buffered.
+     *
+     * @param ctx Driver context
+     * @param data Destination
+     * @param length Maximum number of bytes
+     * @param timeout Maximum time to wait for the first byte
+     * @return Number of bytes read, 0 on timeout, -1 on error
+     */
+    int dmx_port_read(dmx_context_t *ctx, uint8_t *data, uint16_t length, TickType_t timeout);
+
+    /**
+     * @brief Start the receive task of a DMX_MODE_RX port
+     *
+     * @param ctx Driver context, is_running already set
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_NOT_SUPPORTED: Backend cannot receive
+     *      - ESP_FAIL: Task creation failed
+     */
+    esp_err_t dmx_port_start_rx(dmx_context_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_PORT_H
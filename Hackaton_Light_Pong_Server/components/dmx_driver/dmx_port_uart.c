@@ -0,0 +1,269 @@
+/**
+ * @file dmx_port_uart.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief DMX line backend on a UART with an RS-485 transceiver
+ */
+
+#include "dmx_port.h"
+#include "dmx_wire.h"
+#include "esp_log.h"
+#include "driver/uart.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "esp_rom_gpio.h"
+
+static const char *TAG = "DMX";
+
+esp_err_t dmx_port_init(dmx_context_t *ctx)
+{
+    // Configure RS-485 enable pin
+    gpio_config_t io_conf = {
+        .intr_type = GPIO_INTR_DISABLE,
+        .mode = GPIO_MODE_OUTPUT,
+        .pin_bit_mask = (1ULL << ctx->enable_pin),
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .pull_up_en = GPIO_PULLUP_DISABLE};
+    esp_err_t ret = gpio_config(&io_conf);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to configure enable pin");
+        return ret;
+    }
+
+    // Set RS-485 direction (high = transmit, low = receive)
+    gpio_set_level(ctx->enable_pin, ctx->mode == DMX_MODE_TX ? 1 : 0);
+
+    // Configure UART
+    uart_config_t uart_config = {
+        .baud_rate = DMX_BAUD_RATE,
+        .data_bits = DMX_DATA_BITS,
+        .parity = DMX_PARITY,
+        .stop_bits = DMX_STOP_BITS,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+
+    ret = uart_param_config(ctx->uart_num, &uart_config);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "UART param config failed");
+        gpio_reset_pin(ctx->enable_pin);
+        return ret;
+    }
+
+    ret = uart_set_pin(ctx->uart_num, ctx->tx_pin, ctx->rx_pin,
+                       UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "UART set pin failed");
+        gpio_reset_pin(ctx->enable_pin);
+        return ret;
+    }
+
+    if (ctx->mode == DMX_MODE_RX)
+    {
+        ret = uart_driver_install(ctx->uart_num, DMX_RX_RING_SIZE, DMX_TX_BUFFER_SIZE,
+                                  DMX_RX_QUEUE_SIZE, &ctx->uart_queue, 0);
+    }
+    else
+    {
+        ret = uart_driver_install(ctx->uart_num, DMX_RX_BUFFER_SIZE,
+                                  DMX_TX_BUFFER_SIZE, 0, NULL, 0);
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "UART driver install failed");
+        gpio_reset_pin(ctx->enable_pin);
+        return ret;
+    }
+
+    if (ctx->mode == DMX_MODE_RX)
+    {
+        uart_set_rx_full_threshold(ctx->uart_num, DMX_RX_FULL_THRESHOLD);
+        uart_set_rx_timeout(ctx->uart_num, DMX_RX_TIMEOUT_SYMBOLS);
+    }
+
+    return ESP_OK;
+}
+
+void dmx_port_deinit(dmx_context_t *ctx)
+{
+    uart_driver_delete(ctx->uart_num);
+    gpio_reset_pin(ctx->enable_pin);
+}
+
+esp_err_t dmx_port_wait_tx_done(dmx_context_t *ctx, TickType_t timeout)
+{
+    return uart_wait_tx_done(ctx->uart_num, timeout);
+}
+
+void dmx_port_send_break(dmx_context_t *ctx)
+{
+    int64_t break_start = esp_timer_get_time();
+    uart_set_line_inverse(ctx->uart_num, UART_SIGNAL_TXD_INV);
+    esp_rom_delay_us(DMX_BREAK_US);
+
+    uart_set_line_inverse(ctx->uart_num, UART_SIGNAL_INV_DISABLE);
+    ctx->stats.break_us = (uint32_t)(esp_timer_get_time() - break_start);
+    esp_rom_delay_us(DMX_MAB_US);
+}
+
+int dmx_port_write(dmx_context_t *ctx, const uint8_t *data, uint16_t length, bool append_break)
+{
+    if (append_break)
+    {
+        return uart_write_bytes_with_break(ctx->uart_num, data, length, DMX_BREAK_BITS);
+    }
+    return uart_write_bytes(ctx->uart_num, data, length);
+}
+
+esp_err_t dmx_port_set_direction(dmx_context_t *ctx, bool transmit)
+{
+    if (!transmit)
+    {
+        uart_flush_input(ctx->uart_num);
+    }
+    gpio_set_level(ctx->enable_pin, transmit ? 1 : 0);
+    return ESP_OK;
+}
+
+int dmx_port_read(dmx_context_t *ctx, uint8_t *data, uint16_t length, TickType_t timeout)
+{
+    // uart_read_bytes() waits for all requested bytes, so block for one only
+    int n = uart_read_bytes(ctx->uart_num, data, 1, timeout);
+    if (n <= 0 || length == 1)
+    {
+        return n;
+    }
+
+    size_t buffered = 0;
+    uart_get_buffered_data_len(ctx->uart_num, &buffered);
+    if (buffered > (size_t)(length - 1))
+    {
+        buffered = length - 1;
+    }
+    if (buffered > 0)
+    {
+        int more = uart_read_bytes(ctx->uart_num, data + 1, buffered, 0);
+        if (more > 0)
+        {
+            n += more;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Read len bytes from the UART straight into the receive back buffer
+ */
+static void dmx_rx_read(dmx_context_t *ctx, size_t len)
+{
+    const uint16_t frame_max = ctx->universe_size + 1;
+    uint8_t discard[32];
+
+    while (len > 0)
+    {
+        int n;
+        if (ctx->rx_synced && ctx->rx_len < frame_max)
+        {
+            size_t room = frame_max - ctx->rx_len;
+            n = uart_read_bytes(ctx->uart_num, &ctx->rx_buf[ctx->rx_back][ctx->rx_len],
+                                (len < room) ? len : room, 0);
+            if (n > 0)
+            {
+                ctx->rx_len += n;
+            }
+        }
+        else
+        {
+            // Not synchronized yet, or slots beyond the configured universe
+            n = uart_read_bytes(ctx->uart_num, discard, (len < sizeof(discard)) ? len : sizeof(discard), 0);
+        }
+
+        if (n <= 0)
+        {
+            break;
+        }
+        len -= n;
+    }
+}
+
+/**
+ * @brief Reception task, driven by UART driver events
+ */
+static void dmx_rx_task(void *arg)
+{
+    dmx_context_t *ctx = (dmx_context_t *)arg;
+    uart_event_t event;
+
+    ESP_LOGI(TAG, "DMX reception task started");
+
+    while (ctx->is_running)
+    {
+        if (xQueueReceive(ctx->uart_queue, &event, pdMS_TO_TICKS(100)) != pdTRUE)
+        {
+            continue;
+        }
+
+        switch (event.type)
+        {
+        case UART_DATA:
+            dmx_rx_read(ctx, event.size);
+            break;
+
+        case UART_BREAK:
+        {
+            // Slots still buffered belong to the frame this BREAK terminates
+            size_t buffered = 0;
+            uart_get_buffered_data_len(ctx->uart_num, &buffered);
+            dmx_rx_read(ctx, buffered);
+            dmx_rx_complete_frame(ctx);
+            break;
+        }
+
+        case UART_FRAME_ERR:
+        case UART_PARITY_ERR:
+            ctx->stats.rx_errors++;
+            ctx->rx_len = 0;
+            ctx->rx_synced = false;
+            break;
+
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            ctx->stats.rx_overflows++;
+            uart_flush_input(ctx->uart_num);
+            xQueueReset(ctx->uart_queue);
+            ctx->rx_len = 0;
+            ctx->rx_synced = false;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    ESP_LOGI(TAG, "DMX reception task stopped");
+    vTaskDelete(NULL);
+}
+
+esp_err_t dmx_port_start_rx(dmx_context_t *ctx)
+{
+    uart_flush_input(ctx->uart_num);
+    xQueueReset(ctx->uart_queue);
+
+    BaseType_t ret = xTaskCreate(dmx_rx_task, "dmx_rx", DMX_TASK_STACK_SIZE,
+                                 ctx, DMX_RX_TASK_PRIORITY, &ctx->task_handle);
+
+    return (ret == pdPASS) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t dmx_wire_read(dmx_handle_t handle, dmx_wire_frame_t *out_frame, TickType_t timeout)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t dmx_wire_get_overruns(dmx_handle_t handle, uint32_t *out_overruns)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
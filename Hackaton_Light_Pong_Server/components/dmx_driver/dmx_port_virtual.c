@@ -0,0 +1,255 @@
+/**
+ * @file dmx_port_virtual.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief DMX line backend on a virtual wire (linux target, benchmarks)
+ *
+ * Nothing is shifted out; instead the line is modelled. Each write occupies
+ * the line for DMX_WIRE_SLOT_US per slot (plus BREAK/MAB) starting when the
+ * previous frame ends, and dmx_port_wait_tx_done() sleeps until the modelled
+ * line is idle, so the frame loop runs at the same pace as on hardware.
+ */
+
+#include "dmx_port.h"
+#include "dmx_wire.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/queue.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <unistd.h>
+#endif
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE_PTY
+#include <fcntl.h>
+#include <stdio.h>
+#endif
+
+static const char *TAG = "DMX_WIRE";
+
+/**
+ * @brief Virtual wire state of one universe
+ */
+typedef struct
+{
+    QueueHandle_t ring;       // dmx_wire_frame_t items, oldest dropped when full
+    dmx_wire_frame_t staged;  // Frame being built, too large for the task stack
+    dmx_wire_frame_t dropped; // Receives the oldest frame on overrun
+    int64_t line_free_us;     // Modelled time the line becomes idle
+    uint32_t overruns;
+    int pty_fd;               // -1 if not mirrored to a pseudo-terminal
+} dmx_wire_t;
+
+/**
+ * @brief Sleep for at least us microseconds
+ */
+static void dmx_wire_sleep_us(int64_t us)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    usleep((useconds_t)us);
+#else
+    TickType_t ticks = pdMS_TO_TICKS((us + 999) / 1000);
+    vTaskDelay(ticks > 0 ? ticks : 1);
+#endif
+}
+
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE_PTY
+/**
+ * @brief Open a non-blocking pseudo-terminal master, returns -1 on failure
+ */
+static int dmx_wire_open_pty(void)
+{
+    int fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+
+    ESP_LOGI(TAG, "Virtual wire mirrored to %s", ptsname(fd));
+    return fd;
+}
+
+/**
+ * @brief Write a frame record to the pseudo-terminal; dropped if nobody reads
+ */
+static void dmx_wire_mirror(dmx_wire_t *wire, const dmx_wire_frame_t *frame)
+{
+    if (wire->pty_fd < 0)
+    {
+        return;
+    }
+
+    (void)!write(wire->pty_fd, &frame->end_us, sizeof(frame->end_us));
+    (void)!write(wire->pty_fd, &frame->length, sizeof(frame->length));
+    (void)!write(wire->pty_fd, frame->data, frame->length);
+}
+#endif
+
+esp_err_t dmx_port_init(dmx_context_t *ctx)
+{
+    if (ctx->mode != DMX_MODE_TX)
+    {
+        ESP_LOGE(TAG, "Virtual wire supports transmit mode only");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    dmx_wire_t *wire = (dmx_wire_t *)calloc(1, sizeof(dmx_wire_t));
+    if (wire == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    wire->ring = xQueueCreate(DMX_WIRE_RING_FRAMES, sizeof(dmx_wire_frame_t));
+    if (wire->ring == NULL)
+    {
+        free(wire);
+        return ESP_ERR_NO_MEM;
+    }
+
+    wire->pty_fd = -1;
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE_PTY
+    wire->pty_fd = dmx_wire_open_pty();
+    if (wire->pty_fd < 0)
+    {
+        ESP_LOGW(TAG, "Failed to open pseudo-terminal, ring only");
+    }
+#endif
+
+    ctx->port = wire;
+    return ESP_OK;
+}
+
+void dmx_port_deinit(dmx_context_t *ctx)
+{
+    dmx_wire_t *wire = (dmx_wire_t *)ctx->port;
+
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE_PTY
+    if (wire->pty_fd >= 0)
+    {
+        close(wire->pty_fd);
+    }
+#endif
+    vQueueDelete(wire->ring);
+    free(wire);
+    ctx->port = NULL;
+}
+
+esp_err_t dmx_port_wait_tx_done(dmx_context_t *ctx, TickType_t timeout)
+{
+    dmx_wire_t *wire = (dmx_wire_t *)ctx->port;
+    int64_t remaining = wire->line_free_us - esp_timer_get_time();
+
+    if (remaining <= 0)
+    {
+        return ESP_OK;
+    }
+
+    int64_t timeout_us = (timeout == portMAX_DELAY) ? remaining
+                                                    : (int64_t)timeout * portTICK_PERIOD_MS * 1000;
+    if (timeout_us < remaining)
+    {
+        if (timeout_us > 0)
+        {
+            dmx_wire_sleep_us(timeout_us);
+        }
+        return ESP_ERR_TIMEOUT;
+    }
+
+    dmx_wire_sleep_us(remaining);
+    return ESP_OK;
+}
+
+void dmx_port_send_break(dmx_context_t *ctx)
+{
+    dmx_wire_t *wire = (dmx_wire_t *)ctx->port;
+    int64_t now = esp_timer_get_time();
+
+    // The BREAK occupies the modelled line instead of the CPU
+    if (wire->line_free_us < now)
+    {
+        wire->line_free_us = now;
+    }
+    wire->line_free_us += DMX_BREAK_US + DMX_MAB_US;
+    ctx->stats.break_us = DMX_BREAK_US;
+}
+
+int dmx_port_write(dmx_context_t *ctx, const uint8_t *data, uint16_t length, bool append_break)
+{
+    dmx_wire_t *wire = (dmx_wire_t *)ctx->port;
+    dmx_wire_frame_t *frame = &wire->staged;
+    int64_t now = esp_timer_get_time();
+
+    frame->start_us = (wire->line_free_us > now) ? wire->line_free_us : now;
+    frame->end_us = frame->start_us + (int64_t)length * DMX_WIRE_SLOT_US;
+    frame->length = length;
+    memcpy(frame->data, data, length);
+
+    wire->line_free_us = frame->end_us;
+    if (append_break)
+    {
+        wire->line_free_us += DMX_BREAK_US + DMX_MAB_US;
+    }
+
+    if (xQueueSend(wire->ring, frame, 0) != pdTRUE)
+    {
+        // Keep the newest frames: a reader that fell behind wants the latest state
+        xQueueReceive(wire->ring, &wire->dropped, 0);
+        xQueueSend(wire->ring, frame, 0);
+        wire->overruns++;
+    }
+
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE_PTY
+    dmx_wire_mirror(wire, frame);
+#endif
+
+    return length;
+}
+
+esp_err_t dmx_port_set_direction(dmx_context_t *ctx, bool transmit)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+int dmx_port_read(dmx_context_t *ctx, uint8_t *data, uint16_t length, TickType_t timeout)
+{
+    return -1;
+}
+
+esp_err_t dmx_port_start_rx(dmx_context_t *ctx)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t dmx_wire_read(dmx_handle_t handle, dmx_wire_frame_t *out_frame, TickType_t timeout)
+{
+    if (handle == NULL || out_frame == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_wire_t *wire = (dmx_wire_t *)((dmx_context_t *)handle)->port;
+
+    if (xQueueReceive(wire->ring, out_frame, timeout) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_wire_get_overruns(dmx_handle_t handle, uint32_t *out_overruns)
+{
+    if (handle == NULL || out_overruns == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_wire_t *wire = (dmx_wire_t *)((dmx_context_t *)handle)->port;
+    *out_overruns = wire->overruns;
+
+    return ESP_OK;
+}
@@ -0,0 +1,876 @@
+/**
+ * @file dmx_rdm.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief RDM controller implementation
+ */
+
+#include "dmx_rdm.h"
+#include "dmx_driver_priv.h"
+#include "dmx_port.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "DMX_RDM";
+
+/* E1.20 packet layout */
+#define DMX_RDM_START_CODE 0xCC
+#define DMX_RDM_SUB_START 0x01
+#define DMX_RDM_HEADER_LEN 24 // Start code up to and including the PDL
+#define DMX_RDM_MAX_PDL 231
+#define DMX_RDM_MAX_PACKET (DMX_RDM_HEADER_LEN + DMX_RDM_MAX_PDL + 2)
+#define DMX_RDM_PORT_ID 1
+
+/* Discovery response: up to 7 preamble bytes, separator, encoded UID and checksum */
+#define DMX_RDM_DISC_PREAMBLE 0xFE
+#define DMX_RDM_DISC_PREAMBLE_MAX 7
+#define DMX_RDM_DISC_SEPARATOR 0xAA
+#define DMX_RDM_DISC_EUID_LEN 16
+#define DMX_RDM_DISC_RESPONSE_LEN (DMX_RDM_DISC_PREAMBLE_MAX + 1 + DMX_RDM_DISC_EUID_LEN)
+
+/* Command classes; the response class is the request class + 1 */
+#define DMX_RDM_CC_DISCOVERY 0x10
+#define DMX_RDM_CC_GET 0x20
+#define DMX_RDM_CC_SET 0x30
+
+/* Parameter IDs */
+#define DMX_RDM_PID_DISC_UNIQUE_BRANCH 0x0001
+#define DMX_RDM_PID_DISC_MUTE 0x0002
+#define DMX_RDM_PID_DISC_UN_MUTE 0x0003
+#define DMX_RDM_PID_DEVICE_INFO 0x0060
+#define DMX_RDM_PID_DMX_START_ADDRESS 0x00F0
+
+/* Response types */
+#define DMX_RDM_RESPONSE_ACK 0x00
+#define DMX_RDM_RESPONSE_NACK_REASON 0x02
+
+/* Parameter data lengths of the responses used here */
+#define DMX_RDM_DEVICE_INFO_PDL 19
+#define DMX_RDM_MUTE_PDL 8 // Control field and optional binding UID
+
+/* Line timing */
+#define DMX_RDM_SLOT_US 44                          // 11 bits at 250 kbaud
+#define DMX_RDM_RESPONSE_TIMEOUT_US 2800            // Request end to first response slot
+#define DMX_RDM_INTERSLOT_US 2100                   // Longest gap inside a response
+#define DMX_RDM_TICK_US (portTICK_PERIOD_MS * 1000) // Overrun of a blocking read's deadline
+#define DMX_RDM_MUTE_RETRIES 3
+
+/**
+ * @brief One request/response exchange on the line
+ */
+typedef struct
+{
+    uint8_t request[DMX_RDM_MAX_PACKET];
+    uint8_t response[DMX_RDM_MAX_PACKET];
+    uint16_t request_len;
+    uint16_t response_len;
+    uint16_t response_max;  // Longest expected response, for the frame gap estimate
+    bool expect_response;   // false for broadcasts
+    bool discovery;         // Response is a DISC_UNIQUE_BRANCH reply without BREAK
+    esp_err_t result;
+} dmx_rdm_txn_t;
+
+/**
+ * @brief RDM controller state of one universe
+ */
+struct dmx_rdm
+{
+    SemaphoreHandle_t lock; // Serializes callers, held for a whole discovery
+    SemaphoreHandle_t done; // Given by the transmission task after executing txn
+    dmx_rdm_txn_t txn;
+    bool pending;           // txn waits for the transmission task, changed under frame_lock
+    uint8_t deferred;       // Frame slots the pending txn did not fit into
+    uint8_t tn;             // Transaction number
+    dmx_rdm_uid_t uid;
+    dmx_rdm_stats_t stats;
+};
+
+/**
+ * @brief Discovery progress
+ */
+typedef struct
+{
+    dmx_rdm_uid_t *uids;
+    uint16_t max_uids;
+    uint16_t count;
+    bool truncated;
+} dmx_rdm_disc_t;
+
+static void dmx_rdm_put_uid(uint8_t *buf, dmx_rdm_uid_t uid)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        buf[i] = (uint8_t)(uid >> (40 - 8 * i));
+    }
+}
+
+static dmx_rdm_uid_t dmx_rdm_get_uid(const uint8_t *buf)
+{
+    dmx_rdm_uid_t uid = 0;
+    for (int i = 0; i < 6; i++)
+    {
+        uid = (uid << 8) | buf[i];
+    }
+    return uid;
+}
+
+static uint16_t dmx_rdm_checksum(const uint8_t *buf, uint16_t length)
+{
+    uint16_t sum = 0;
+    for (uint16_t i = 0; i < length; i++)
+    {
+        sum += buf[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Lazily create the RDM state of a transmit port
+ */
+static esp_err_t dmx_rdm_get(dmx_context_t *ctx, dmx_rdm_t **out_rdm)
+{
+    if (ctx->mode != DMX_MODE_TX)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (ctx->rdm != NULL)
+    {
+        *out_rdm = ctx->rdm;
+        return ESP_OK;
+    }
+
+    dmx_rdm_t *rdm = (dmx_rdm_t *)calloc(1, sizeof(dmx_rdm_t));
+    if (rdm != NULL)
+    {
+        rdm->lock = xSemaphoreCreateMutex();
+        rdm->done = xSemaphoreCreateBinary();
+    }
+    if (rdm == NULL || rdm->lock == NULL || rdm->done == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate RDM state");
+        dmx_rdm_free(rdm);
+        return ESP_ERR_NO_MEM;
+    }
+    rdm->uid = DMX_RDM_DEFAULT_UID;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    ctx->rdm = rdm;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    *out_rdm = rdm;
+    return ESP_OK;
+}
+
+void dmx_rdm_free(dmx_rdm_t *rdm)
+{
+    if (rdm == NULL)
+    {
+        return;
+    }
+
+    if (rdm->lock != NULL)
+    {
+        vSemaphoreDelete(rdm->lock);
+    }
+    if (rdm->done != NULL)
+    {
+        vSemaphoreDelete(rdm->done);
+    }
+    free(rdm);
+}
+
+/**
+ * @brief Worst-case line time of a transaction
+ */
+static uint32_t dmx_rdm_estimate_us(const dmx_rdm_txn_t *txn)
+{
+    uint32_t us = DMX_BREAK_US + DMX_MAB_US + txn->request_len * DMX_RDM_SLOT_US;
+    if (txn->expect_response)
+    {
+        us += DMX_RDM_RESPONSE_TIMEOUT_US + DMX_RDM_TICK_US + txn->response_max * DMX_RDM_SLOT_US;
+    }
+    return us;
+}
+
+/**
+ * @brief Response length once enough of it has arrived, 0 if not known yet
+ */
+static uint16_t dmx_rdm_expected_len(const dmx_rdm_txn_t *txn, uint16_t received)
+{
+    const uint8_t *buf = txn->response;
+    uint16_t i = 0;
+
+    if (txn->discovery)
+    {
+        while (i < received && i < DMX_RDM_DISC_PREAMBLE_MAX && buf[i] == DMX_RDM_DISC_PREAMBLE)
+        {
+            i++;
+        }
+        if (i < received && buf[i] == DMX_RDM_DISC_SEPARATOR)
+        {
+            return i + 1 + DMX_RDM_DISC_EUID_LEN;
+        }
+        return 0;
+    }
+
+    // The responder's BREAK is read as null bytes
+    while (i < received && buf[i] == 0x00)
+    {
+        i++;
+    }
+    if (received > i + 2 && buf[i] == DMX_RDM_START_CODE)
+    {
+        return i + buf[i + 2] + 2;
+    }
+    return 0;
+}
+
+/**
+ * @brief Collect the response after the line was turned around
+ *
+ * Blocks on the UART, so the TX task yields the CPU while the responder
+ * answers: the response starts within DMX_RDM_RESPONSE_TIMEOUT_US and is
+ * complete after the length in its header, or at the first gap longer than
+ * DMX_RDM_INTERSLOT_US (collisions during discovery). Waits are rounded up
+ * to whole ticks.
+ */
+static esp_err_t dmx_rdm_receive(dmx_context_t *ctx, dmx_rdm_txn_t *txn)
+{
+    int64_t deadline = esp_timer_get_time() + DMX_RDM_RESPONSE_TIMEOUT_US;
+    uint16_t limit = DMX_RDM_MAX_PACKET;
+    uint16_t len = 0;
+
+    while (len < limit)
+    {
+        int64_t remaining = deadline - esp_timer_get_time();
+        if (remaining <= 0)
+        {
+            break;
+        }
+
+        TickType_t wait = pdMS_TO_TICKS((remaining + 999) / 1000);
+        int n = dmx_port_read(ctx, &txn->response[len], limit - len, (wait > 0) ? wait : 1);
+        if (n < 0)
+        {
+            break;
+        }
+        if (n > 0)
+        {
+            len += n;
+            deadline = esp_timer_get_time() + DMX_RDM_INTERSLOT_US;
+
+            uint16_t expected = dmx_rdm_expected_len(txn, len);
+            if (expected != 0 && expected < limit)
+            {
+                limit = expected;
+            }
+        }
+    }
+
+    txn->response_len = len;
+    return (len > 0) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Send the request and receive the response; owns the line meanwhile
+ */
+static esp_err_t dmx_rdm_execute(dmx_context_t *ctx, dmx_rdm_txn_t *txn)
+{
+    txn->response_len = 0;
+
+    // Fails before anything is sent if the backend cannot turn the line around
+    esp_err_t ret = dmx_port_set_direction(ctx, true);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    if (dmx_port_wait_tx_done(ctx, pdMS_TO_TICKS(DMX_PACKET_TIMEOUT_MS)) != ESP_OK)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    ctx->rdm->stats.transactions++;
+
+    // The BREAK appended to the last DMX frame also starts this packet
+    if (!(ctx->break_mode == DMX_BREAK_MODE_UART && ctx->break_on_line))
+    {
+        dmx_port_send_break(ctx);
+    }
+    ctx->break_on_line = false;
+
+    if (dmx_port_write(ctx, txn->request, txn->request_len, false) != txn->request_len ||
+        dmx_port_wait_tx_done(ctx, pdMS_TO_TICKS(DMX_PACKET_TIMEOUT_MS)) != ESP_OK)
+    {
+        return ESP_FAIL;
+    }
+
+    if (!txn->expect_response)
+    {
+        return ESP_OK;
+    }
+
+    ret = dmx_port_set_direction(ctx, false);
+    if (ret == ESP_OK)
+    {
+        ret = dmx_rdm_receive(ctx, txn);
+    }
+    dmx_port_set_direction(ctx, true);
+
+    return ret;
+}
+
+void dmx_rdm_service(dmx_context_t *ctx, int64_t slot_start, bool frame_sent)
+{
+    dmx_rdm_t *rdm = ctx->rdm;
+
+    if (!rdm->pending)
+    {
+        return;
+    }
+
+    // The line is needed again at the next frame slot, or in an idle slot
+    // at the next keep-alive frame
+    int64_t line_needed = slot_start + ctx->frame_period_us;
+    if (!frame_sent && ctx->idle_period_us != 0)
+    {
+        line_needed = ctx->last_tx_us + ctx->idle_period_us;
+    }
+
+    bool fits = (line_needed - esp_timer_get_time()) >= (int64_t)dmx_rdm_estimate_us(&rdm->txn);
+    if (!fits && ++rdm->deferred < DMX_RDM_MAX_DEFER_SLOTS)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    bool claimed = rdm->pending;
+    rdm->pending = false;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (!claimed)
+    {
+        return; // Caller gave up in the meantime
+    }
+
+    rdm->deferred = 0;
+    if (!fits)
+    {
+        rdm->stats.slots_stretched++;
+    }
+
+    rdm->txn.result = dmx_rdm_execute(ctx, &rdm->txn);
+    xSemaphoreGive(rdm->done);
+}
+
+/**
+ * @brief Run rdm->txn on the line; call with rdm->lock held
+ *
+ * Hands the transaction to the transmission task if it is running, so it is
+ * placed between frames, and executes it directly otherwise.
+ */
+static esp_err_t dmx_rdm_transact(dmx_context_t *ctx, dmx_rdm_t *rdm)
+{
+    if (!ctx->is_running)
+    {
+        rdm->txn.result = dmx_rdm_execute(ctx, &rdm->txn);
+        return rdm->txn.result;
+    }
+
+    if (ctx->task_handle == NULL)
+    {
+        ESP_LOGE(TAG, "RDM is not available on scheduler-driven universes");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(rdm->done, 0); // Drop a completion nobody waited for
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    rdm->deferred = 0;
+    rdm->pending = true;
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    if (xSemaphoreTake(rdm->done, pdMS_TO_TICKS(DMX_PACKET_TIMEOUT_MS)) != pdTRUE)
+    {
+        portENTER_CRITICAL(&ctx->frame_lock);
+        bool queued = rdm->pending;
+        rdm->pending = false;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+
+        if (queued)
+        {
+            return ESP_ERR_TIMEOUT; // Transmission stopped before picking it up
+        }
+        xSemaphoreTake(rdm->done, portMAX_DELAY); // Already on the line, bounded
+    }
+
+    return rdm->txn.result;
+}
+
+/**
+ * @brief Build rdm->txn as a request with the given header fields
+ */
+static void dmx_rdm_build(dmx_rdm_t *rdm, dmx_rdm_uid_t dest, uint8_t cc, uint16_t pid,
+                          const uint8_t *pd, uint8_t pdl, uint8_t response_pdl)
+{
+    dmx_rdm_txn_t *txn = &rdm->txn;
+    uint8_t *buf = txn->request;
+
+    buf[0] = DMX_RDM_START_CODE;
+    buf[1] = DMX_RDM_SUB_START;
+    buf[2] = DMX_RDM_HEADER_LEN + pdl;
+    dmx_rdm_put_uid(&buf[3], dest);
+    dmx_rdm_put_uid(&buf[9], rdm->uid);
+    buf[15] = rdm->tn++;
+    buf[16] = DMX_RDM_PORT_ID;
+    buf[17] = 0; // Message count
+    buf[18] = 0; // Sub-device (root)
+    buf[19] = 0;
+    buf[20] = cc;
+    buf[21] = (uint8_t)(pid >> 8);
+    buf[22] = (uint8_t)pid;
+    buf[23] = pdl;
+    if (pdl > 0)
+    {
+        memcpy(&buf[DMX_RDM_HEADER_LEN], pd, pdl);
+    }
+
+    uint16_t sum = dmx_rdm_checksum(buf, DMX_RDM_HEADER_LEN + pdl);
+    buf[DMX_RDM_HEADER_LEN + pdl] = (uint8_t)(sum >> 8);
+    buf[DMX_RDM_HEADER_LEN + pdl + 1] = (uint8_t)sum;
+
+    txn->request_len = DMX_RDM_HEADER_LEN + pdl + 2;
+    txn->expect_response = (dest != DMX_RDM_UID_BROADCAST);
+    txn->discovery = (pid == DMX_RDM_PID_DISC_UNIQUE_BRANCH);
+    txn->response_max = txn->discovery ? DMX_RDM_DISC_RESPONSE_LEN
+                                       : DMX_RDM_HEADER_LEN + response_pdl + 2;
+}
+
+/**
+ * @brief Validate the response to rdm->txn and locate its parameter data
+ */
+static esp_err_t dmx_rdm_parse(dmx_rdm_t *rdm, const uint8_t **out_pd, uint8_t *out_pdl)
+{
+    const dmx_rdm_txn_t *txn = &rdm->txn;
+    const uint8_t *req = txn->request;
+    const uint8_t *p = txn->response;
+    uint16_t len = txn->response_len;
+
+    while (len > 0 && *p == 0x00)
+    {
+        p++;
+        len--;
+    }
+
+    if (len < DMX_RDM_HEADER_LEN + 2 || p[0] != DMX_RDM_START_CODE || p[1] != DMX_RDM_SUB_START ||
+        p[2] < DMX_RDM_HEADER_LEN || len < p[2] + 2 || p[23] != p[2] - DMX_RDM_HEADER_LEN)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    uint16_t sum = ((uint16_t)p[p[2]] << 8) | p[p[2] + 1];
+    if (sum != dmx_rdm_checksum(p, p[2]))
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    if (dmx_rdm_get_uid(&p[3]) != rdm->uid || dmx_rdm_get_uid(&p[9]) != dmx_rdm_get_uid(&req[3]) ||
+        p[15] != req[15] || p[20] != req[20] + 1 || p[21] != req[21] || p[22] != req[22])
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    if (p[16] != DMX_RDM_RESPONSE_ACK)
+    {
+        if (p[16] == DMX_RDM_RESPONSE_NACK_REASON && p[23] >= 2)
+        {
+            ESP_LOGW(TAG, "PID 0x%04X NACK, reason 0x%04X", (p[21] << 8) | p[22], (p[24] << 8) | p[25]);
+        }
+        else
+        {
+            ESP_LOGW(TAG, "PID 0x%04X unsupported response type %d", (p[21] << 8) | p[22], p[16]);
+        }
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    *out_pd = &p[DMX_RDM_HEADER_LEN];
+    *out_pdl = p[23];
+    return ESP_OK;
+}
+
+/**
+ * @brief Unicast request/response; call with rdm->lock held
+ *
+ * out_pd points into rdm->txn and is valid until the next request.
+ */
+static esp_err_t dmx_rdm_request(dmx_context_t *ctx, dmx_rdm_t *rdm, dmx_rdm_uid_t uid,
+                                 uint8_t cc, uint16_t pid, const uint8_t *pd, uint8_t pdl,
+                                 uint8_t response_pdl, const uint8_t **out_pd, uint8_t *out_pdl)
+{
+    dmx_rdm_build(rdm, uid, cc, pid, pd, pdl, response_pdl);
+
+    esp_err_t ret = dmx_rdm_transact(ctx, rdm);
+    if (ret == ESP_ERR_TIMEOUT)
+    {
+        rdm->stats.timeouts++;
+    }
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    ret = dmx_rdm_parse(rdm, out_pd, out_pdl);
+    if (ret != ESP_OK)
+    {
+        rdm->stats.invalid_responses++;
+    }
+    return ret;
+}
+
+/**
+ * @brief Decode a DISC_UNIQUE_BRANCH response
+ *
+ * @return ESP_OK with the UID, ESP_ERR_INVALID_CRC if it is garbled (collision)
+ */
+static esp_err_t dmx_rdm_decode_disc(const dmx_rdm_txn_t *txn, dmx_rdm_uid_t *out_uid)
+{
+    const uint8_t *buf = txn->response;
+    uint16_t i = 0;
+
+    while (i < txn->response_len && i < DMX_RDM_DISC_PREAMBLE_MAX && buf[i] == DMX_RDM_DISC_PREAMBLE)
+    {
+        i++;
+    }
+    if (i >= txn->response_len || buf[i] != DMX_RDM_DISC_SEPARATOR ||
+        txn->response_len - i - 1 < DMX_RDM_DISC_EUID_LEN)
+    {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    // Each byte is sent twice, OR-ed with 0xAA and with 0x55
+    const uint8_t *euid = &buf[i + 1];
+    uint8_t uid[6];
+    for (int k = 0; k < 6; k++)
+    {
+        uid[k] = euid[2 * k] & euid[2 * k + 1];
+    }
+    uint16_t sum = ((uint16_t)(euid[12] & euid[13]) << 8) | (euid[14] & euid[15]);
+    if (sum != dmx_rdm_checksum(euid, 12))
+    {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    *out_uid = dmx_rdm_get_uid(uid);
+    return ESP_OK;
+}
+
+/**
+ * @brief Ask all unmuted responders in [lower, upper] to identify themselves
+ *
+ * @return ESP_OK with a UID, ESP_ERR_TIMEOUT if nobody answered,
+ *         ESP_ERR_INVALID_CRC if several answered
+ */
+static esp_err_t dmx_rdm_unique_branch(dmx_context_t *ctx, dmx_rdm_t *rdm, dmx_rdm_uid_t lower,
+                                       dmx_rdm_uid_t upper, dmx_rdm_uid_t *out_uid)
+{
+    uint8_t pd[12];
+    dmx_rdm_put_uid(&pd[0], lower);
+    dmx_rdm_put_uid(&pd[6], upper);
+
+    dmx_rdm_build(rdm, DMX_RDM_UID_BROADCAST, DMX_RDM_CC_DISCOVERY, DMX_RDM_PID_DISC_UNIQUE_BRANCH,
+                  pd, sizeof(pd), 0);
+    rdm->txn.expect_response = true; // Broadcast, but every device in range answers
+
+    esp_err_t ret = dmx_rdm_transact(ctx, rdm);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    ret = dmx_rdm_decode_disc(&rdm->txn, out_uid);
+    if (ret == ESP_OK && (*out_uid < lower || *out_uid > upper))
+    {
+        ret = ESP_ERR_INVALID_CRC;
+    }
+    if (ret != ESP_OK)
+    {
+        rdm->stats.collisions++;
+    }
+    return ret;
+}
+
+/**
+ * @brief Mute a discovered responder so it stops answering discovery
+ */
+static esp_err_t dmx_rdm_mute(dmx_context_t *ctx, dmx_rdm_t *rdm, dmx_rdm_uid_t uid)
+{
+    const uint8_t *pd;
+    uint8_t pdl;
+    esp_err_t ret = ESP_FAIL;
+
+    for (int attempt = 0; attempt < DMX_RDM_MUTE_RETRIES && ret != ESP_OK; attempt++)
+    {
+        ret = dmx_rdm_request(ctx, rdm, uid, DMX_RDM_CC_DISCOVERY, DMX_RDM_PID_DISC_MUTE,
+                              NULL, 0, DMX_RDM_MUTE_PDL, &pd, &pdl);
+    }
+    return ret;
+}
+
+/**
+ * @brief Discover all unmuted responders in [lower, upper]
+ */
+static esp_err_t dmx_rdm_discover_branch(dmx_context_t *ctx, dmx_rdm_t *rdm, dmx_rdm_uid_t lower,
+                                         dmx_rdm_uid_t upper, dmx_rdm_disc_t *disc)
+{
+    for (;;)
+    {
+        dmx_rdm_uid_t uid;
+        esp_err_t ret = dmx_rdm_unique_branch(ctx, rdm, lower, upper, &uid);
+
+        if (ret == ESP_ERR_TIMEOUT)
+        {
+            return ESP_OK; // Nobody left in this branch
+        }
+
+        if (ret == ESP_OK)
+        {
+            if (dmx_rdm_mute(ctx, rdm, uid) == ESP_OK)
+            {
+                ESP_LOGI(TAG, "Found %04X:%08lX", DMX_RDM_UID_MANUFACTURER(uid),
+                         (unsigned long)DMX_RDM_UID_DEVICE(uid));
+                if (disc->count < disc->max_uids)
+                {
+                    disc->uids[disc->count++] = uid;
+                }
+                else
+                {
+                    disc->truncated = true;
+                }
+                continue; // More devices may answer in the same branch
+            }
+            ESP_LOGW(TAG, "%04X:%08lX did not accept DISC_MUTE", DMX_RDM_UID_MANUFACTURER(uid),
+                     (unsigned long)DMX_RDM_UID_DEVICE(uid));
+            // Handled like a collision, a single UID branch gives up on it
+        }
+        else if (ret != ESP_ERR_INVALID_CRC)
+        {
+            return ret;
+        }
+
+        if (lower == upper)
+        {
+            return ESP_OK; // Duplicate UID or an unmutable device
+        }
+
+        dmx_rdm_uid_t mid = lower + (upper - lower) / 2;
+        ret = dmx_rdm_discover_branch(ctx, rdm, lower, mid, disc);
+        if (ret != ESP_OK)
+        {
+            return ret;
+        }
+        return dmx_rdm_discover_branch(ctx, rdm, mid + 1, upper, disc);
+    }
+}
+
+esp_err_t dmx_rdm_set_uid(dmx_handle_t handle, dmx_rdm_uid_t uid)
+{
+    if (handle == NULL || uid == 0 || uid > DMX_RDM_UID_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    dmx_rdm_t *rdm;
+    esp_err_t ret = dmx_rdm_get(ctx, &rdm);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    xSemaphoreTake(rdm->lock, portMAX_DELAY);
+    rdm->uid = uid;
+    xSemaphoreGive(rdm->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_rdm_discover(dmx_handle_t handle, dmx_rdm_uid_t *uids, uint16_t max_uids,
+                           uint16_t *out_count)
+{
+    if (handle == NULL || uids == NULL || out_count == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    dmx_rdm_t *rdm;
+    esp_err_t ret = dmx_rdm_get(ctx, &rdm);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    dmx_rdm_disc_t disc = {
+        .uids = uids,
+        .max_uids = max_uids,
+        .count = 0,
+        .truncated = false};
+
+    xSemaphoreTake(rdm->lock, portMAX_DELAY);
+
+    dmx_rdm_build(rdm, DMX_RDM_UID_BROADCAST, DMX_RDM_CC_DISCOVERY, DMX_RDM_PID_DISC_UN_MUTE,
+                  NULL, 0, 0);
+    ret = dmx_rdm_transact(ctx, rdm);
+    if (ret == ESP_OK)
+    {
+        ret = dmx_rdm_discover_branch(ctx, rdm, 0, DMX_RDM_UID_MAX, &disc);
+    }
+
+    xSemaphoreGive(rdm->lock);
+
+    *out_count = disc.count;
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Discovery failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "Discovery complete: %d device(s)", disc.count);
+    return disc.truncated ? ESP_ERR_NO_MEM : ESP_OK;
+}
+
+esp_err_t dmx_rdm_get_device_info(dmx_handle_t handle, dmx_rdm_uid_t uid,
+                                  dmx_rdm_device_info_t *out_info)
+{
+    if (handle == NULL || out_info == NULL || uid == 0 || uid > DMX_RDM_UID_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    dmx_rdm_t *rdm;
+    esp_err_t ret = dmx_rdm_get(ctx, &rdm);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    const uint8_t *pd;
+    uint8_t pdl;
+
+    xSemaphoreTake(rdm->lock, portMAX_DELAY);
+    ret = dmx_rdm_request(ctx, rdm, uid, DMX_RDM_CC_GET, DMX_RDM_PID_DEVICE_INFO,
+                          NULL, 0, DMX_RDM_DEVICE_INFO_PDL, &pd, &pdl);
+    if (ret == ESP_OK && pdl != DMX_RDM_DEVICE_INFO_PDL)
+    {
+        rdm->stats.invalid_responses++;
+        ret = ESP_ERR_INVALID_RESPONSE;
+    }
+    if (ret == ESP_OK)
+    {
+        out_info->protocol_version = (pd[0] << 8) | pd[1];
+        out_info->model_id = (pd[2] << 8) | pd[3];
+        out_info->product_category = (pd[4] << 8) | pd[5];
+        out_info->software_version = ((uint32_t)pd[6] << 24) | ((uint32_t)pd[7] << 16) |
+                                     ((uint32_t)pd[8] << 8) | pd[9];
+        out_info->footprint = (pd[10] << 8) | pd[11];
+        out_info->personality = pd[12];
+        out_info->personality_count = pd[13];
+        out_info->start_address = (pd[14] << 8) | pd[15];
+        out_info->sub_device_count = (pd[16] << 8) | pd[17];
+        out_info->sensor_count = pd[18];
+    }
+    xSemaphoreGive(rdm->lock);
+
+    return ret;
+}
+
+esp_err_t dmx_rdm_get_start_address(dmx_handle_t handle, dmx_rdm_uid_t uid,
+                                    uint16_t *out_address)
+{
+    if (handle == NULL || out_address == NULL || uid == 0 || uid > DMX_RDM_UID_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    dmx_rdm_t *rdm;
+    esp_err_t ret = dmx_rdm_get(ctx, &rdm);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    const uint8_t *pd;
+    uint8_t pdl;
+
+    xSemaphoreTake(rdm->lock, portMAX_DELAY);
+    ret = dmx_rdm_request(ctx, rdm, uid, DMX_RDM_CC_GET, DMX_RDM_PID_DMX_START_ADDRESS,
+                          NULL, 0, 2, &pd, &pdl);
+    if (ret == ESP_OK && pdl != 2)
+    {
+        rdm->stats.invalid_responses++;
+        ret = ESP_ERR_INVALID_RESPONSE;
+    }
+    if (ret == ESP_OK)
+    {
+        *out_address = (pd[0] << 8) | pd[1];
+    }
+    xSemaphoreGive(rdm->lock);
+
+    return ret;
+}
+
+esp_err_t dmx_rdm_set_start_address(dmx_handle_t handle, dmx_rdm_uid_t uid, uint16_t address)
+{
+    if (handle == NULL || uid == 0 || uid > DMX_RDM_UID_MAX ||
+        address == 0 || address > DMX_UNIVERSE_SIZE)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+    dmx_rdm_t *rdm;
+    esp_err_t ret = dmx_rdm_get(ctx, &rdm);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    const uint8_t pd[2] = {(uint8_t)(address >> 8), (uint8_t)address};
+    const uint8_t *resp_pd;
+    uint8_t resp_pdl;
+
+    xSemaphoreTake(rdm->lock, portMAX_DELAY);
+    ret = dmx_rdm_request(ctx, rdm, uid, DMX_RDM_CC_SET, DMX_RDM_PID_DMX_START_ADDRESS,
+                          pd, sizeof(pd), 0, &resp_pd, &resp_pdl);
+    xSemaphoreGive(rdm->lock);
+
+    return ret;
+}
+
+esp_err_t dmx_rdm_get_stats(dmx_handle_t handle, dmx_rdm_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_context_t *ctx = (dmx_context_t *)handle;
+
+    portENTER_CRITICAL(&ctx->frame_lock);
+    if (ctx->rdm != NULL)
+    {
+        *out_stats = ctx->rdm->stats;
+    }
+    else
+    {
+        memset(out_stats, 0, sizeof(*out_stats));
+    }
+    portEXIT_CRITICAL(&ctx->frame_lock);
+
+    return ESP_OK;
+}
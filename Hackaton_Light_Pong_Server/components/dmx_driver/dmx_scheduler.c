@@ -0,0 +1,251 @@
+/**
+ * @file dmx_scheduler.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Single-task scheduler driving several DMX universes
+ */
+
+#include "dmx_scheduler.h"
+#include "dmx_driver_priv.h"
+#include <stdlib.h>
+#include "esp_log.h"
+
+static const char *TAG = "DMX_SCHED";
+
+/**
+ * @brief Scheduler context
+ */
+typedef struct
+{
+    dmx_context_t *universes[DMX_MAX_UNIVERSES];
+    uint8_t count;
+    uint32_t frame_period_us;
+    esp_timer_handle_t frame_timer;
+    TaskHandle_t task_handle;
+    volatile bool is_running;
+} dmx_scheduler_t;
+
+/**
+ * @brief Frame timer callback, wakes the scheduler task
+ */
+static void dmx_scheduler_timer_cb(void *arg)
+{
+    dmx_scheduler_t *sched = (dmx_scheduler_t *)arg;
+    xTaskNotifyGive(sched->task_handle);
+}
+
+/**
+ * @brief Scheduler task: one pass over all universes per frame slot
+ */
+static void dmx_scheduler_task(void *arg)
+{
+    dmx_scheduler_t *sched = (dmx_scheduler_t *)arg;
+
+    ESP_LOGI(TAG, "DMX scheduler started with %d universes", sched->count);
+
+    while (sched->is_running)
+    {
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!sched->is_running)
+        {
+            break;
+        }
+
+        int64_t now = esp_timer_get_time();
+
+        for (uint8_t i = 0; i < sched->count; i++)
+        {
+            dmx_context_t *ctx = sched->universes[i];
+
+            if (pending > 1)
+            {
+                dmx_record_dropped(ctx, pending - 1);
+            }
+
+            dmx_run_tx_callback(ctx, now);
+            if (!dmx_frame_due(ctx, now))
+            {
+                continue;
+            }
+
+            // Never block on one universe while the others are waiting: queue
+            // the frame only if the previous one has already left the wire
+            esp_err_t ret = dmx_transmit_frame(ctx, 0, false);
+            if (ret == ESP_ERR_TIMEOUT)
+            {
+                dmx_record_dropped(ctx, 1);
+            }
+            else if (ret != ESP_OK)
+            {
+                ESP_LOGW(TAG, "Universe %d transmission failed", i);
+            }
+        }
+    }
+
+    ESP_LOGI(TAG, "DMX scheduler stopped");
+    vTaskDelete(NULL);
+}
+
+esp_err_t dmx_scheduler_start(const dmx_handle_t *handles, uint8_t count,
+                              dmx_scheduler_handle_t *out_handle)
+{
+    if (handles == NULL || out_handle == NULL || count == 0 || count > DMX_MAX_UNIVERSES)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        dmx_context_t *ctx = (dmx_context_t *)handles[i];
+        if (ctx == NULL)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (ctx->is_running || ctx->mode != DMX_MODE_TX)
+        {
+            ESP_LOGE(TAG, "Universe %d is already running or in receive mode", i);
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+
+    dmx_scheduler_t *sched = (dmx_scheduler_t *)calloc(1, sizeof(dmx_scheduler_t));
+    if (sched == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate scheduler");
+        return ESP_ERR_NO_MEM;
+    }
+
+    sched->count = count;
+    sched->frame_period_us = UINT32_MAX;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        sched->universes[i] = (dmx_context_t *)handles[i];
+        if (sched->universes[i]->frame_period_us < sched->frame_period_us)
+        {
+            sched->frame_period_us = sched->universes[i]->frame_period_us;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        dmx_context_t *ctx = sched->universes[i];
+        portENTER_CRITICAL(&ctx->frame_lock);
+        ctx->stats.period_target_us = sched->frame_period_us;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+        ctx->is_running = true;
+    }
+    sched->is_running = true;
+
+    BaseType_t task_ret = xTaskCreate(dmx_scheduler_task, "dmx_sched", DMX_TASK_STACK_SIZE,
+                                      sched, DMX_TASK_PRIORITY, &sched->task_handle);
+    if (task_ret != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create scheduler task");
+        for (uint8_t i = 0; i < count; i++)
+        {
+            sched->universes[i]->is_running = false;
+        }
+        free(sched);
+        return ESP_FAIL;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = dmx_scheduler_timer_cb,
+        .arg = sched,
+        .name = "dmx_sched"};
+    esp_err_t ret = esp_timer_create(&timer_args, &sched->frame_timer);
+    if (ret == ESP_OK)
+    {
+        ret = esp_timer_start_periodic(sched->frame_timer, sched->frame_period_us);
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to start scheduler timer");
+        dmx_scheduler_stop(sched);
+        return ret;
+    }
+
+    *out_handle = (dmx_scheduler_handle_t)sched;
+    ESP_LOGI(TAG, "DMX scheduler running: %d universes, %lu us/frame",
+             count, (unsigned long)sched->frame_period_us);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_scheduler_stop(dmx_scheduler_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_scheduler_t *sched = (dmx_scheduler_t *)handle;
+
+    sched->is_running = false;
+
+    if (sched->frame_timer != NULL)
+    {
+        esp_timer_stop(sched->frame_timer);
+    }
+
+    if (sched->task_handle != NULL)
+    {
+        xTaskNotifyGive(sched->task_handle);
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+
+    if (sched->frame_timer != NULL)
+    {
+        esp_timer_delete(sched->frame_timer);
+    }
+
+    for (uint8_t i = 0; i < sched->count; i++)
+    {
+        dmx_context_t *ctx = sched->universes[i];
+        portENTER_CRITICAL(&ctx->frame_lock);
+        ctx->stats.period_target_us = ctx->frame_period_us;
+        portEXIT_CRITICAL(&ctx->frame_lock);
+        ctx->is_running = false;
+    }
+
+    free(sched);
+    ESP_LOGI(TAG, "DMX scheduler released");
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_scheduler_get_stats(dmx_scheduler_handle_t handle, uint8_t universe,
+                                  dmx_stats_t *out_stats)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_scheduler_t *sched = (dmx_scheduler_t *)handle;
+
+    if (universe >= sched->count)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return dmx_get_stats((dmx_handle_t)sched->universes[universe], out_stats);
+}
+
+esp_err_t dmx_scheduler_log_stats(dmx_scheduler_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_scheduler_t *sched = (dmx_scheduler_t *)handle;
+
+    for (uint8_t i = 0; i < sched->count; i++)
+    {
+        ESP_LOGI(TAG, "Universe %d (UART%d):", i, sched->universes[i]->uart_num);
+        dmx_log_stats((dmx_handle_t)sched->universes[i]);
+    }
+
+    return ESP_OK;
+}
@@ -13,8 +13,13 @@
 
 #include <stdint.h>
 #include "esp_err.h"
+#include "sdkconfig.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include "dmx_host_types.h"
+#else
 #include "driver/uart.h"
 #include "driver/gpio.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -26,6 +31,11 @@ extern "C"
 #define DMX_BREAK_US 92            // Break time in microseconds (88-1000us)
 #define DMX_MAB_US 12              // Mark After Break (8-1000us)
 #define DMX_PACKET_TIMEOUT_MS 1000 // Timeout for packet transmission
+#define DMX_MIN_FRAME_US 1204      // Minimum break-to-break time (short packets are padded in time)
+#define DMX_DEFAULT_RATE_HZ 44     // Refresh rate used when refresh_rate_hz is 0
+#define DMX_MIN_IDLE_RATE_HZ 2     // Keeps break-to-break and MAB below 1 s while idle
+#define DMX_RX_RING_SIZE 1024      // UART RX ring buffer in receive mode (two full frames)
+#define DMX_MAX_TX_CALLBACKS 4     // Frame slot callbacks per universe
 
 /* Default GPIO Configuration for Clownfish ESP32-C3 */
 /* Adjust these based on your actual board layout */
@@ -40,6 +50,36 @@ extern "C"
 #define DMX_PARITY UART_PARITY_DISABLE
 #define DMX_STOP_BITS UART_STOP_BITS_2
 
+/* Break length in bit times at DMX_BAUD_RATE (used by DMX_BREAK_MODE_UART) */
+#define DMX_BREAK_BITS ((DMX_BREAK_US * (DMX_BAUD_RATE / 1000)) / 1000)
+
+    /**
+     * @brief How the BREAK/MAB preceding each frame is generated
+     */
+    typedef enum
+    {
+        DMX_BREAK_MODE_BUSY_WAIT = 0, ///< Invert TX and spin for BREAK/MAB on the CPU
+        DMX_BREAK_MODE_UART,          ///< UART hardware appends BREAK after each frame, no spinning
+    } dmx_break_mode_t;
+
+    /**
+     * @brief Line direction of a DMX port
+     */
+    typedef enum
+    {
+        DMX_MODE_TX = 0, ///< Controller: transmit the universe
+        DMX_MODE_RX,     ///< Receiver: reassemble incoming frames
+    } dmx_mode_t;
+
+    /**
+     * @brief Which part of the universe each frame carries
+     */
+    typedef enum
+    {
+        DMX_REFRESH_FULL = 0, ///< Always send universe_size channels
+        DMX_REFRESH_TRIMMED,  ///< Send only up to the highest channel ever written
+    } dmx_refresh_mode_t;
+
     /**
      * @brief DMX Configuration Structure
      */
@@ -50,8 +90,74 @@ extern "C"
         gpio_num_t enable_pin;  ///< RS-485 DE/RE control pin
         uart_port_t uart_num;   ///< UART port number
         uint16_t universe_size; ///< Number of DMX channels (1-512)
+        dmx_mode_t mode;        ///< Transmit (default) or receive
+        dmx_break_mode_t break_mode; ///< BREAK generation mode
+        dmx_refresh_mode_t refresh_mode; ///< Full or trimmed frames
+        uint16_t refresh_rate_hz; ///< Frame rate while channels change (0 = DMX_DEFAULT_RATE_HZ)
+        uint16_t idle_rate_hz;    ///< Keep-alive rate when nothing changed (0 = no idle mode)
     } dmx_config_t;
 
+    /**
+     * @brief Channel/value pair for sparse updates
+     */
+    typedef struct
+    {
+        uint16_t channel; ///< Channel number (1-512)
+        uint8_t value;    ///< Channel value (0-255)
+    } dmx_channel_value_t;
+
+/* Jitter histogram: bucket upper bounds for |period - target| in microseconds */
+#define DMX_JITTER_BUCKETS 8
+#define DMX_JITTER_BUCKET_LIMITS_US {50, 100, 250, 500, 1000, 2500, 5000, UINT32_MAX}
+
+    /**
+     * @brief DMX output timing statistics
+     */
+    typedef struct
+    {
+        uint32_t frames_sent;         ///< Frames handed to the UART completely
+        uint32_t frames_incomplete;   ///< Frames the UART did not accept in full
+        uint32_t frames_dropped;      ///< Frame slots missed because the task ran late
+        uint32_t frames_idle_skipped; ///< Frame slots skipped by idle mode
+        uint32_t period_target_us;    ///< Configured frame period
+        uint32_t period_min_us;       ///< Shortest break-to-break period
+        uint32_t period_max_us;       ///< Longest break-to-break period
+        uint32_t period_mean_us;      ///< Mean break-to-break period
+        uint32_t break_us;            ///< Length of the last BREAK
+        uint32_t cpu_time_last_us;    ///< CPU time of the last frame (see dmx_get_frame_cpu_time)
+        uint32_t cpu_time_max_us;     ///< Maximum CPU time per frame
+        uint32_t jitter_hist[DMX_JITTER_BUCKETS]; ///< Period deviation histogram
+        int64_t last_frame_us;        ///< esp_timer timestamp of the last frame start
+        uint32_t rx_frames;           ///< Complete frames received (receive mode)
+        uint32_t rx_errors;           ///< Framing/parity errors, frame discarded (receive mode)
+        uint32_t rx_overflows;        ///< FIFO or ring buffer overflows (receive mode)
+    } dmx_stats_t;
+
+    /**
+     * @brief Frame callback for receive mode
+     *
+     * Called from the receive task once per complete frame. frame points to the
+     * start code followed by the slots and stays valid until the callback
+     * returns; it is not copied.
+     *
+     * @param frame Start code and slot data
+     * @param length Number of bytes including the start code
+     * @param user_ctx User context passed to dmx_set_rx_callback()
+     */
+    typedef void (*dmx_rx_callback_t)(const uint8_t *frame, uint16_t length, void *user_ctx);
+
+    /**
+     * @brief Frame slot callback for continuous transmission
+     *
+     * Called from the transmission task (or scheduler) at the start of every
+     * frame slot, before the idle check and the frame snapshot, so channels
+     * written here go out in this slot's frame. Must not block.
+     *
+     * @param slot_us esp_timer timestamp of the frame slot
+     * @param user_ctx User context passed to dmx_add_tx_callback()
+     */
+    typedef void (*dmx_tx_callback_t)(int64_t slot_us, void *user_ctx);
+
     /**
      * @brief DMX driver handle
      */
@@ -83,6 +189,9 @@ extern "C"
     /**
      * @brief Set DMX channel value
      *
+     * Writes into the back buffer without locking; the value goes out with the
+     * next frame published by dmx_transmit().
+     *
      * @param handle DMX handle
      * @param channel Channel number (1-512)
      * @param value Channel value (0-255)
@@ -106,6 +215,23 @@ extern "C"
     esp_err_t dmx_set_channels(dmx_handle_t handle, uint16_t start_channel,
                                const uint8_t *data, uint16_t length);
 
+    /**
+     * @brief Set a list of non-contiguous DMX channels atomically
+     *
+     * All pairs are validated first and then applied with a single
+     * synchronization point, so a transmitted frame contains either none or
+     * all of them (e.g. coarse and fine pan/tilt bytes).
+     *
+     * @param handle DMX handle
+     * @param pairs Array of channel/value pairs
+     * @param count Number of pairs
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments (nothing is written)
+     */
+    esp_err_t dmx_set_channels_sparse(dmx_handle_t handle,
+                                      const dmx_channel_value_t *pairs, uint16_t count);
+
     /**
      * @brief Get DMX channel value
      *
@@ -123,6 +249,8 @@ extern "C"
      *
      * Sends a complete DMX512 packet including break, MAB, and data.
      * This function should be called periodically (typically 44Hz or 25-44ms interval).
+     * The back buffer is published into the frame buffer at the start of each
+     * call, so only one task (normally the transmission task) may call it.
      *
      * @param handle DMX handle
      * @return
@@ -132,10 +260,62 @@ extern "C"
      */
     esp_err_t dmx_transmit(dmx_handle_t handle);
 
+    /**
+     * @brief Get CPU time spent per transmitted frame
+     *
+     * Measures the time dmx_transmit() keeps the core busy (frame snapshot,
+     * BREAK generation and queueing the data), excluding blocking waits for
+     * the UART to drain.
+     *
+     * @param handle DMX handle
+     * @param last_us Pointer to store the CPU time of the last frame (may be NULL)
+     * @param max_us Pointer to store the maximum CPU time seen (may be NULL)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_get_frame_cpu_time(dmx_handle_t handle, uint32_t *last_us, uint32_t *max_us);
+
+    /**
+     * @brief Get DMX output timing statistics
+     *
+     * Periods are only measured between frames sent back to back at the
+     * refresh rate; gaps caused by idle mode are not counted as jitter.
+     *
+     * @param handle DMX handle
+     * @param out_stats Pointer to store a consistent snapshot of the statistics
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_get_stats(dmx_handle_t handle, dmx_stats_t *out_stats);
+
+    /**
+     * @brief Reset DMX output timing statistics
+     *
+     * @param handle DMX handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_reset_stats(dmx_handle_t handle);
+
+    /**
+     * @brief Log DMX output timing statistics to the console
+     *
+     * @param handle DMX handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_log_stats(dmx_handle_t handle);
+
     /**
      * @brief Start continuous DMX transmission
      *
-     * Starts a task that continuously transmits DMX packets at ~44Hz.
+     * Starts a task that transmits DMX packets at the configured refresh rate,
+     * paced by an esp_timer rather than the FreeRTOS tick. With an idle rate
+     * configured, frames are only sent at that rate while no channel changes.
      *
      * @param handle DMX handle
      * @return
@@ -155,6 +335,78 @@ extern "C"
      */
     esp_err_t dmx_stop_transmission(dmx_handle_t handle);
 
+    /**
+     * @brief Add a frame slot callback for continuous transmission
+     *
+     * Lets per-frame generators (motion, effects) compute their values at the
+     * exact frame rate instead of the FreeRTOS tick. Callbacks run in the order
+     * they were added, so a later one wins where both write the same channel.
+     *
+     * @param handle DMX handle
+     * @param callback Callback
+     * @param user_ctx User context passed to the callback
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Callback and context already added
+     *      - ESP_ERR_NO_MEM: DMX_MAX_TX_CALLBACKS already added
+     */
+    esp_err_t dmx_add_tx_callback(dmx_handle_t handle, dmx_tx_callback_t callback, void *user_ctx);
+
+    /**
+     * @brief Remove a frame slot callback
+     *
+     * Returns once the callback is no longer running, so user_ctx may be freed
+     * right away. Called from a frame slot callback itself it cannot wait; the
+     * caller then must not free the context of a callback still on the stack.
+     *
+     * @param handle DMX handle
+     * @param callback Callback passed to dmx_add_tx_callback()
+     * @param user_ctx User context passed to dmx_add_tx_callback()
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     *      - ESP_ERR_NOT_FOUND: Callback was not added
+     */
+    esp_err_t dmx_remove_tx_callback(dmx_handle_t handle, dmx_tx_callback_t callback, void *user_ctx);
+
+    /**
+     * @brief Register the per-frame callback for receive mode
+     *
+     * @param handle DMX handle
+     * @param callback Callback, or NULL to disable
+     * @param user_ctx User context passed to the callback
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_set_rx_callback(dmx_handle_t handle, dmx_rx_callback_t callback, void *user_ctx);
+
+    /**
+     * @brief Start receiving DMX frames
+     *
+     * Starts a task that detects BREAKs through UART events and reassembles
+     * frames into a double buffer. dmx_get_channel() returns values from the
+     * last complete frame. Only valid in DMX_MODE_RX.
+     *
+     * @param handle DMX handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     *      - ESP_ERR_INVALID_STATE: Already running or not in receive mode
+     */
+    esp_err_t dmx_start_reception(dmx_handle_t handle);
+
+    /**
+     * @brief Stop receiving DMX frames
+     *
+     * @param handle DMX handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_stop_reception(dmx_handle_t handle);
+
     /**
      * @brief Clear all DMX channels (set to 0)
      *
@@ -0,0 +1,140 @@
+/**
+ * @file dmx_fade.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Per-channel fades interpolated inside the DMX frame loop
+ *
+ * A fade command returns immediately. The transmit path advances all active
+ * fades once per frame, right before the frame snapshot, so fades are as
+ * smooth as the refresh rate and independent of the FreeRTOS tick. Idle
+ * mode keeps sending full-rate frames while any fade is running.
+ *
+ * Fades start from the current value of their layer (back buffer or merge
+ * source). A new fade or a direct write to the same channel of the same
+ * layer replaces a running fade.
+ */
+
+#ifndef DMX_FADE_H
+#define DMX_FADE_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+#include "dmx_merge.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DMX_MAX_FADES 256      // Concurrent fades per universe
+#define DMX_FADE_MAX_MS 600000 // Longest fade (10 min)
+
+    /**
+     * @brief Fade curve
+     */
+    typedef enum
+    {
+        DMX_FADE_LINEAR = 0,  ///< Constant rate
+        DMX_FADE_EASE_IN,     ///< Slow start (quadratic)
+        DMX_FADE_EASE_OUT,    ///< Slow end (quadratic)
+        DMX_FADE_EASE_IN_OUT, ///< Slow start and end (smoothstep)
+    } dmx_fade_curve_t;
+
+    /**
+     * @brief Fade a channel of the back buffer to a target value
+     *
+     * @param handle DMX handle
+     * @param channel DMX channel number (1-512)
+     * @param target Value at the end of the fade
+     * @param duration_ms Fade time (0-DMX_FADE_MAX_MS), 0 sets the value on the next frame
+     * @param curve Fade curve
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory or DMX_MAX_FADES reached
+     */
+    esp_err_t dmx_fade_channel(dmx_handle_t handle, uint16_t channel, uint8_t target,
+                               uint32_t duration_ms, dmx_fade_curve_t curve);
+
+    /**
+     * @brief Crossfade consecutive channels of the back buffer in lockstep
+     *
+     * All channels share the same start time, so they arrive together.
+     *
+     * @param handle DMX handle
+     * @param start_channel Starting DMX channel (1-512)
+     * @param targets Target values, one per channel
+     * @param length Number of channels
+     * @param duration_ms Fade time (0-DMX_FADE_MAX_MS), 0 sets the values on the next frame
+     * @param curve Fade curve
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory or DMX_MAX_FADES reached
+     */
+    esp_err_t dmx_fade_channels(dmx_handle_t handle, uint16_t start_channel, const uint8_t *targets,
+                                uint16_t length, uint32_t duration_ms, dmx_fade_curve_t curve);
+
+    /**
+     * @brief Fade a channel of a merge source and take ownership of it
+     *
+     * @param source Source handle
+     * @param channel DMX channel number (1-512)
+     * @param target Value at the end of the fade
+     * @param duration_ms Fade time (0-DMX_FADE_MAX_MS), 0 sets the value on the next frame
+     * @param curve Fade curve
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory or DMX_MAX_FADES reached
+     */
+    esp_err_t dmx_source_fade_channel(dmx_source_handle_t source, uint16_t channel, uint8_t target,
+                                      uint32_t duration_ms, dmx_fade_curve_t curve);
+
+    /**
+     * @brief Crossfade consecutive channels of a merge source in lockstep
+     *
+     * @param source Source handle
+     * @param start_channel Starting DMX channel (1-512)
+     * @param targets Target values, one per channel
+     * @param length Number of channels
+     * @param duration_ms Fade time (0-DMX_FADE_MAX_MS), 0 sets the values on the next frame
+     * @param curve Fade curve
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory or DMX_MAX_FADES reached
+     */
+    esp_err_t dmx_source_fade_channels(dmx_source_handle_t source, uint16_t start_channel,
+                                       const uint8_t *targets, uint16_t length,
+                                       uint32_t duration_ms, dmx_fade_curve_t curve);
+
+    /**
+     * @brief Stop fades on back buffer channels, keeping their current values
+     *
+     * @param handle DMX handle
+     * @param start_channel Starting DMX channel (1-512)
+     * @param length Number of channels
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_fade_cancel(dmx_handle_t handle, uint16_t start_channel, uint16_t length);
+
+    /**
+     * @brief Get the number of running fades on a universe
+     *
+     * @param handle DMX handle
+     * @param out_count Pointer to store the count
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_fade_get_active(dmx_handle_t handle, uint16_t *out_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_FADE_H
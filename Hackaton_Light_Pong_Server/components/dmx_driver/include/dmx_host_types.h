@@ -0,0 +1,35 @@
+/**
+ * @file dmx_host_types.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Stand-ins for the UART/GPIO types on the linux target
+ *
+ * The linux target has no UART or GPIO driver. These definitions only keep
+ * dmx_config_t source compatible; the virtual wire ignores pin numbers.
+ */
+
+#ifndef DMX_HOST_TYPES_H
+#define DMX_HOST_TYPES_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef int uart_port_t;
+    typedef int gpio_num_t;
+
+#define UART_NUM_0 0
+#define UART_NUM_1 1
+#define UART_NUM_MAX 2
+
+#define GPIO_NUM_NC (-1)
+#define GPIO_NUM_19 19
+#define GPIO_NUM_20 20
+#define GPIO_NUM_21 21
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_HOST_TYPES_H
@@ -0,0 +1,156 @@
+/**
+ * @file dmx_merge.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Multi-source HTP/LTP merge in front of the DMX back buffer
+ *
+ * Each source (game, effects, network, manual override, ...) owns a sparse
+ * layer: only channels it has written take part in the merge. Once per
+ * frame the layers are merged on top of the plain back buffer written by
+ * dmx_set_channel():
+ * - A channel owned by a higher priority source always wins.
+ * - Among sources of equal priority the channel rule decides: HTP takes the
+ *   highest value, LTP takes the value of the source that wrote last.
+ * - Channels no source owns are sent from the back buffer unchanged.
+ */
+
+#ifndef DMX_MERGE_H
+#define DMX_MERGE_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DMX_MAX_SOURCES 8      // Merge sources per universe
+#define DMX_SOURCE_NAME_LEN 16 // Including the terminator
+
+    /**
+     * @brief Merge rule between sources of equal priority
+     */
+    typedef enum
+    {
+        DMX_MERGE_LTP = 0, ///< Latest takes precedence (default, attribute channels)
+        DMX_MERGE_HTP,     ///< Highest takes precedence (intensity channels)
+    } dmx_merge_rule_t;
+
+    /**
+     * @brief DMX merge source handle
+     */
+    typedef void *dmx_source_handle_t;
+
+    /**
+     * @brief Create a merge source on a transmit universe
+     *
+     * Sources are freed by dmx_source_delete() or together with the universe
+     * in dmx_deinit().
+     *
+     * @param handle DMX handle
+     * @param name Source name for logging (truncated to DMX_SOURCE_NAME_LEN - 1)
+     * @param priority Source priority, higher wins
+     * @param out_source Pointer to store the source handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Universe is in receive mode
+     *      - ESP_ERR_NO_MEM: Out of memory or DMX_MAX_SOURCES reached
+     */
+    esp_err_t dmx_source_create(dmx_handle_t handle, const char *name, uint8_t priority,
+                                dmx_source_handle_t *out_source);
+
+    /**
+     * @brief Delete a merge source; its channels fall back to lower layers
+     *
+     * @param source Source handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_source_delete(dmx_source_handle_t source);
+
+    /**
+     * @brief Set a single channel in a source layer and take ownership of it
+     *
+     * @param source Source handle
+     * @param channel DMX channel number (1-512)
+     * @param value Channel value (0-255)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_source_set_channel(dmx_source_handle_t source, uint16_t channel, uint8_t value);
+
+    /**
+     * @brief Set consecutive channels in a source layer; applied atomically
+     *
+     * @param source Source handle
+     * @param start_channel Starting DMX channel (1-512)
+     * @param data Pointer to channel data
+     * @param length Number of channels to set
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_source_set_channels(dmx_source_handle_t source, uint16_t start_channel,
+                                      const uint8_t *data, uint16_t length);
+
+    /**
+     * @brief Set scattered channels in a source layer; applied atomically
+     *
+     * @param source Source handle
+     * @param pairs Array of channel/value pairs
+     * @param count Number of pairs
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_source_set_channels_sparse(dmx_source_handle_t source,
+                                             const dmx_channel_value_t *pairs, uint16_t count);
+
+    /**
+     * @brief Release channels so they no longer take part in the merge
+     *
+     * @param source Source handle
+     * @param start_channel Starting DMX channel (1-512)
+     * @param length Number of channels to release
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_source_release(dmx_source_handle_t source, uint16_t start_channel, uint16_t length);
+
+    /**
+     * @brief Release all channels owned by a source
+     *
+     * @param source Source handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_source_release_all(dmx_source_handle_t source);
+
+    /**
+     * @brief Set the merge rule for a range of channels
+     *
+     * @param handle DMX handle
+     * @param start_channel Starting DMX channel (1-512)
+     * @param length Number of channels
+     * @param rule Merge rule between sources of equal priority
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Universe is in receive mode
+     *      - ESP_ERR_NO_MEM: Out of memory
+     */
+    esp_err_t dmx_merge_set_rule(dmx_handle_t handle, uint16_t start_channel, uint16_t length,
+                                 dmx_merge_rule_t rule);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_MERGE_H
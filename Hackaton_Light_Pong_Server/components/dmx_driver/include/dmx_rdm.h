@@ -0,0 +1,175 @@
+/**
+ * @file dmx_rdm.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief RDM (ANSI E1.20) controller on a DMX transmit port
+ *
+ * RDM shares the line with the DMX data: the RS-485 transceiver is turned
+ * around with the enable pin after each request to receive the response.
+ * While continuous transmission runs, every request is handed to the
+ * transmission task, which runs at most one transaction per frame slot and
+ * only in the time left before the next frame (or the next idle keep-alive).
+ * If a request does not fit for DMX_RDM_MAX_DEFER_SLOTS slots in a row it is
+ * run anyway and stretches that one slot, so the DMX output keeps at least
+ * DMX_RDM_MAX_DEFER_SLOTS / (DMX_RDM_MAX_DEFER_SLOTS + 1) of its refresh rate.
+ * Without running transmission the request is executed by the caller.
+ *
+ * All calls block the caller until the transaction is complete. RDM is not
+ * available on universes driven by dmx_scheduler or in receive mode.
+ */
+
+#ifndef DMX_RDM_H
+#define DMX_RDM_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DMX_RDM_MAX_DEFER_SLOTS 8 // Frame slots a request waits for a large enough gap
+
+    /**
+     * @brief 48-bit RDM UID: manufacturer ID (high 16 bits) and device ID
+     */
+    typedef uint64_t dmx_rdm_uid_t;
+
+#define DMX_RDM_UID(manufacturer, device) (((uint64_t)(manufacturer) << 32) | (uint32_t)(device))
+#define DMX_RDM_UID_MANUFACTURER(uid) ((uint16_t)((uid) >> 32))
+#define DMX_RDM_UID_DEVICE(uid) ((uint32_t)(uid))
+#define DMX_RDM_UID_BROADCAST 0xFFFFFFFFFFFFULL
+#define DMX_RDM_UID_MAX 0xFFFFFFFFFFFEULL
+#define DMX_RDM_DEFAULT_UID DMX_RDM_UID(0x7FF0, 0x00000001) // E1.20 prototype manufacturer range
+
+    /**
+     * @brief DEVICE_INFO parameter of a responder
+     */
+    typedef struct
+    {
+        uint16_t protocol_version;  ///< RDM protocol version (0x0100)
+        uint16_t model_id;          ///< Manufacturer specific model
+        uint16_t product_category;  ///< E1.20 product category
+        uint32_t software_version;  ///< Manufacturer specific software version
+        uint16_t footprint;         ///< DMX channels used by the current personality
+        uint8_t personality;        ///< Current personality (1-based)
+        uint8_t personality_count;  ///< Number of personalities
+        uint16_t start_address;     ///< DMX start address, 0xFFFF if footprint is 0
+        uint16_t sub_device_count;  ///< Number of sub-devices
+        uint8_t sensor_count;       ///< Number of sensors
+    } dmx_rdm_device_info_t;
+
+    /**
+     * @brief RDM transaction statistics
+     */
+    typedef struct
+    {
+        uint32_t transactions;      ///< Requests sent
+        uint32_t timeouts;          ///< Requests without a response
+        uint32_t invalid_responses; ///< Responses with bad checksum, framing or NACK
+        uint32_t collisions;        ///< Discovery responses from more than one device
+        uint32_t slots_stretched;   ///< Transactions that did not fit a frame gap
+    } dmx_rdm_stats_t;
+
+    /**
+     * @brief Set the UID the controller sends requests from
+     *
+     * @param handle DMX handle
+     * @param uid Controller UID (default DMX_RDM_DEFAULT_UID)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Port is in receive mode
+     *      - ESP_ERR_NO_MEM: Out of memory
+     */
+    esp_err_t dmx_rdm_set_uid(dmx_handle_t handle, dmx_rdm_uid_t uid);
+
+    /**
+     * @brief Find all responders on the line with binary-search discovery
+     *
+     * Unmutes all responders, then searches the UID space with
+     * DISC_UNIQUE_BRANCH and mutes each device found. Each request is a
+     * separate transaction, so DMX output continues during discovery.
+     *
+     * @param handle DMX handle
+     * @param uids Array receiving the UIDs found
+     * @param max_uids Size of uids
+     * @param out_count Number of UIDs stored in uids
+     * @return
+     *      - ESP_OK: Success (also if no device was found)
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Port is in receive mode or driven by a scheduler
+     *      - ESP_ERR_NO_MEM: More devices than max_uids, the first max_uids are stored
+     *      - ESP_ERR_NOT_SUPPORTED: Line backend cannot receive (virtual wire)
+     */
+    esp_err_t dmx_rdm_discover(dmx_handle_t handle, dmx_rdm_uid_t *uids, uint16_t max_uids,
+                               uint16_t *out_count);
+
+    /**
+     * @brief GET DEVICE_INFO from a responder
+     *
+     * @param handle DMX handle
+     * @param uid Responder UID
+     * @param out_info Device information
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Port is in receive mode or driven by a scheduler
+     *      - ESP_ERR_TIMEOUT: No response
+     *      - ESP_ERR_INVALID_RESPONSE: Malformed response or NACK
+     *      - ESP_ERR_NOT_SUPPORTED: Line backend cannot receive (virtual wire)
+     */
+    esp_err_t dmx_rdm_get_device_info(dmx_handle_t handle, dmx_rdm_uid_t uid,
+                                      dmx_rdm_device_info_t *out_info);
+
+    /**
+     * @brief GET DMX_START_ADDRESS from a responder
+     *
+     * @param handle DMX handle
+     * @param uid Responder UID
+     * @param out_address Start address (1-512)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Port is in receive mode or driven by a scheduler
+     *      - ESP_ERR_TIMEOUT: No response
+     *      - ESP_ERR_INVALID_RESPONSE: Malformed response or NACK
+     *      - ESP_ERR_NOT_SUPPORTED: Line backend cannot receive (virtual wire)
+     */
+    esp_err_t dmx_rdm_get_start_address(dmx_handle_t handle, dmx_rdm_uid_t uid,
+                                        uint16_t *out_address);
+
+    /**
+     * @brief SET DMX_START_ADDRESS of a responder
+     *
+     * @param handle DMX handle
+     * @param uid Responder UID
+     * @param address New start address (1-512)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Port is in receive mode or driven by a scheduler
+     *      - ESP_ERR_TIMEOUT: No response
+     *      - ESP_ERR_INVALID_RESPONSE: Malformed response or NACK
+     *      - ESP_ERR_NOT_SUPPORTED: Line backend cannot receive (virtual wire)
+     */
+    esp_err_t dmx_rdm_set_start_address(dmx_handle_t handle, dmx_rdm_uid_t uid, uint16_t address);
+
+    /**
+     * @brief Get RDM transaction statistics
+     *
+     * @param handle DMX handle
+     * @param out_stats Statistics (all zero before the first RDM call)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_rdm_get_stats(dmx_handle_t handle, dmx_rdm_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_RDM_H
@@ -0,0 +1,89 @@
+/**
+ * @file dmx_scheduler.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Single-task scheduler driving several DMX universes
+ *
+ * Drives one universe per UART from one task instead of one transmission
+ * task per universe. Each frame slot the scheduler queues the frames of all
+ * universes back to back; the UARTs shift them out in parallel, so every
+ * universe keeps its full refresh rate.
+ */
+
+#ifndef DMX_SCHEDULER_H
+#define DMX_SCHEDULER_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DMX_MAX_UNIVERSES UART_NUM_MAX
+
+    /**
+     * @brief DMX scheduler handle
+     */
+    typedef void *dmx_scheduler_handle_t;
+
+    /**
+     * @brief Start driving several universes from one task
+     *
+     * The universes must be initialized in transmit mode and must not have
+     * their own transmission running. The scheduler runs at the highest
+     * refresh rate of its members; idle mode still applies per universe.
+     *
+     * @param handles Array of DMX handles, one per universe
+     * @param count Number of handles (1-DMX_MAX_UNIVERSES)
+     * @param out_handle Pointer to store the scheduler handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: A universe is already running or in receive mode
+     *      - ESP_ERR_NO_MEM: Out of memory
+     *      - ESP_FAIL: Task creation failed
+     */
+    esp_err_t dmx_scheduler_start(const dmx_handle_t *handles, uint8_t count,
+                                  dmx_scheduler_handle_t *out_handle);
+
+    /**
+     * @brief Stop the scheduler and release its universes
+     *
+     * @param handle Scheduler handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_scheduler_stop(dmx_scheduler_handle_t handle);
+
+    /**
+     * @brief Get timing statistics of one scheduled universe
+     *
+     * @param handle Scheduler handle
+     * @param universe Index into the handles passed to dmx_scheduler_start()
+     * @param out_stats Pointer to store the statistics
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_scheduler_get_stats(dmx_scheduler_handle_t handle, uint8_t universe,
+                                      dmx_stats_t *out_stats);
+
+    /**
+     * @brief Log timing statistics of all scheduled universes
+     *
+     * @param handle Scheduler handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_scheduler_log_stats(dmx_scheduler_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_SCHEDULER_H
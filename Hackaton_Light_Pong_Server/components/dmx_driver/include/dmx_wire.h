@@ -0,0 +1,74 @@
+/**
+ * @file dmx_wire.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Virtual DMX wire for host builds and hardware-free benchmarks
+ *
+ * With CONFIG_DMX_DRIVER_VIRTUAL_WIRE (always on for the linux target) the
+ * driver does not touch UART or GPIO. Every frame is timestamped with a
+ * model of the 250 kbaud line and pushed into a per-universe ring, from
+ * which a test or benchmark reads it back. The same dmx_init(),
+ * dmx_transmit() and dmx_start_transmission() API is used unchanged, so the
+ * frame rate, jitter and update-to-wire latency of the full stack can be
+ * measured without hardware: write a marker value, then read frames until
+ * it appears and compare the frame timestamps with the write time.
+ */
+
+#ifndef DMX_WIRE_H
+#define DMX_WIRE_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DMX_WIRE_RING_FRAMES 16 // Frames buffered per universe before the oldest is dropped
+#define DMX_WIRE_SLOT_US 44     // One slot on the wire: 11 bits at 250 kbaud
+
+    /**
+     * @brief One frame as it appeared on the virtual wire
+     */
+    typedef struct
+    {
+        int64_t start_us; ///< esp_timer time the start code started shifting out
+        int64_t end_us;   ///< esp_timer time the last slot left the line
+        uint16_t length;  ///< Slots including the start code
+        uint8_t data[DMX_UNIVERSE_SIZE + 1];
+    } dmx_wire_frame_t;
+
+    /**
+     * @brief Read the oldest frame from the virtual wire of a universe
+     *
+     * @param handle DMX handle
+     * @param out_frame Pointer to store the frame
+     * @param timeout Maximum time to wait for a frame
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Driver built with the UART backend
+     *      - ESP_ERR_TIMEOUT: No frame within timeout
+     */
+    esp_err_t dmx_wire_read(dmx_handle_t handle, dmx_wire_frame_t *out_frame, TickType_t timeout);
+
+    /**
+     * @brief Number of frames dropped because the ring was full
+     *
+     * @param handle DMX handle
+     * @param out_overruns Pointer to store the count
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Driver built with the UART backend
+     */
+    esp_err_t dmx_wire_get_overruns(dmx_handle_t handle, uint32_t *out_overruns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_WIRE_H
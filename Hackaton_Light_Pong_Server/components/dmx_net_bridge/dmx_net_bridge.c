@@ -0,0 +1,410 @@
+/**
+ * @file dmx_net_bridge.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Art-Net / sACN (E1.31) network ingest implementation
+ */
+
+#include "dmx_net_bridge.h"
+#include "dmx_net_proto.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "DMX_NET";
+
+#define NET_TASK_STACK_SIZE 4096
+#define NET_TASK_PRIORITY 5
+#define NET_PACKET_BUFFER_SIZE 640 // Largest E1.31 data packet is 638 bytes
+#define NET_SELECT_TIMEOUT_MS 100
+
+/**
+ * @brief Network bridge context
+ */
+typedef struct
+{
+    dmx_net_config_t config;
+    int artnet_sock;
+    int sacn_sock;
+    uint8_t packet[NET_PACKET_BUFFER_SIZE];
+    uint8_t sacn_last_sequence;
+    bool sacn_have_sequence;
+    portMUX_TYPE latency_lock;  // Guards pending_arrival_us and the latency statistics
+    int64_t pending_arrival_us; // Arrival of the oldest packet not yet in a frame
+    int64_t rate_window_start_us;
+    uint32_t rate_window_packets;
+    uint64_t latency_sum_us;
+    uint32_t latency_count;
+    dmx_net_stats_t stats;
+    TaskHandle_t task_handle;
+    volatile bool is_running;
+} dmx_net_bridge_t;
+
+/**
+ * @brief Open a non-blocking UDP socket bound to port
+ */
+static int net_open_socket(uint16_t port)
+{
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0)
+    {
+        return -1;
+    }
+
+    int reuse = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        close(sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+/**
+ * @brief Join the E1.31 multicast group 239.255.<hi>.<lo> of a universe
+ */
+static void net_join_sacn_group(int sock, uint16_t universe)
+{
+    struct ip_mreq mreq = {0};
+    mreq.imr_multiaddr.s_addr = htonl(0xEFFF0000 | universe);
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0)
+    {
+        ESP_LOGW(TAG, "Failed to join sACN multicast group for universe %d (unicast still works)",
+                 universe);
+    }
+}
+
+/**
+ * @brief Frame slot callback: resolve the pending arrival against this slot's frame
+ *
+ * Runs right before the frame snapshot, and the arrival is only recorded
+ * once the data is in the back buffer, so the first slot that sees an
+ * arrival is the one whose frame carries the data.
+ */
+static void net_frame_slot(int64_t slot_us, void *user_ctx)
+{
+    dmx_net_bridge_t *bridge = (dmx_net_bridge_t *)user_ctx;
+    // Later than slot_us if the transmission task runs late; the frame follows now
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&bridge->latency_lock);
+    if (bridge->pending_arrival_us != 0)
+    {
+        uint32_t latency = (uint32_t)(now - bridge->pending_arrival_us);
+        bridge->pending_arrival_us = 0;
+
+        bridge->stats.latency_last_us = latency;
+        if (latency > bridge->stats.latency_max_us)
+        {
+            bridge->stats.latency_max_us = latency;
+        }
+        bridge->latency_sum_us += latency;
+        bridge->latency_count++;
+        bridge->stats.latency_mean_us = (uint32_t)(bridge->latency_sum_us / bridge->latency_count);
+    }
+    portEXIT_CRITICAL(&bridge->latency_lock);
+}
+
+/**
+ * @brief Write a decoded frame into the DMX back buffer
+ */
+static void net_apply_frame(dmx_net_bridge_t *bridge, const dmx_net_frame_t *frame, int64_t arrival_us)
+{
+    if (bridge->config.source != NULL)
+    {
+        dmx_source_set_channels(bridge->config.source, 1, frame->data, frame->length);
+    }
+    else
+    {
+        dmx_set_channels(bridge->config.dmx_handle, 1, frame->data, frame->length);
+    }
+
+    portENTER_CRITICAL(&bridge->latency_lock);
+    if (bridge->pending_arrival_us == 0)
+    {
+        bridge->pending_arrival_us = arrival_us;
+    }
+    portEXIT_CRITICAL(&bridge->latency_lock);
+    bridge->rate_window_packets++;
+}
+
+/**
+ * @brief Receive and apply one datagram from sock
+ */
+static void net_handle_packet(dmx_net_bridge_t *bridge, int sock)
+{
+    int len = recv(sock, bridge->packet, sizeof(bridge->packet), 0);
+    if (len <= 0)
+    {
+        return;
+    }
+
+    int64_t arrival_us = esp_timer_get_time();
+    dmx_net_frame_t frame;
+    esp_err_t ret;
+
+    if (sock == bridge->artnet_sock)
+    {
+        ret = dmx_net_parse_artnet(bridge->packet, len, &frame);
+        if (ret == ESP_OK && frame.universe == bridge->config.artnet_universe)
+        {
+            net_apply_frame(bridge, &frame, arrival_us);
+            bridge->stats.artnet_packets++;
+            return;
+        }
+    }
+    else
+    {
+        ret = dmx_net_parse_sacn(bridge->packet, len, &frame);
+        if (ret == ESP_OK && frame.universe == bridge->config.sacn_universe &&
+            frame.start_code == 0x00 && !(frame.options & (SACN_OPTION_PREVIEW | SACN_OPTION_TERMINATED)))
+        {
+            if (bridge->sacn_have_sequence &&
+                !dmx_net_sacn_sequence_ok(bridge->sacn_last_sequence, frame.sequence))
+            {
+                bridge->stats.out_of_order++;
+                return;
+            }
+            bridge->sacn_last_sequence = frame.sequence;
+            bridge->sacn_have_sequence = true;
+
+            net_apply_frame(bridge, &frame, arrival_us);
+            bridge->stats.sacn_packets++;
+            return;
+        }
+    }
+
+    if (ret == ESP_ERR_INVALID_RESPONSE)
+    {
+        bridge->stats.invalid_packets++;
+    }
+    else
+    {
+        bridge->stats.ignored_packets++;
+    }
+}
+
+/**
+ * @brief Bridge task: waits on both sockets and updates the packet rate
+ */
+static void dmx_net_task(void *arg)
+{
+    dmx_net_bridge_t *bridge = (dmx_net_bridge_t *)arg;
+
+    ESP_LOGI(TAG, "DMX network bridge task started");
+    bridge->rate_window_start_us = esp_timer_get_time();
+
+    while (bridge->is_running)
+    {
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        int max_fd = -1;
+
+        if (bridge->artnet_sock >= 0)
+        {
+            FD_SET(bridge->artnet_sock, &readfds);
+            max_fd = bridge->artnet_sock;
+        }
+        if (bridge->sacn_sock >= 0)
+        {
+            FD_SET(bridge->sacn_sock, &readfds);
+            if (bridge->sacn_sock > max_fd)
+            {
+                max_fd = bridge->sacn_sock;
+            }
+        }
+
+        struct timeval timeout = {
+            .tv_sec = 0,
+            .tv_usec = NET_SELECT_TIMEOUT_MS * 1000};
+
+        int ready = select(max_fd + 1, &readfds, NULL, NULL, &timeout);
+        if (ready > 0)
+        {
+            if (bridge->artnet_sock >= 0 && FD_ISSET(bridge->artnet_sock, &readfds))
+            {
+                net_handle_packet(bridge, bridge->artnet_sock);
+            }
+            if (bridge->sacn_sock >= 0 && FD_ISSET(bridge->sacn_sock, &readfds))
+            {
+                net_handle_packet(bridge, bridge->sacn_sock);
+            }
+        }
+
+        int64_t now = esp_timer_get_time();
+        if (now - bridge->rate_window_start_us >= 1000000)
+        {
+            bridge->stats.packet_rate_hz = (uint32_t)((bridge->rate_window_packets * 1000000LL) /
+                                                      (now - bridge->rate_window_start_us));
+            bridge->rate_window_packets = 0;
+            bridge->rate_window_start_us = now;
+        }
+    }
+
+    ESP_LOGI(TAG, "DMX network bridge task stopped");
+    vTaskDelete(NULL);
+}
+
+esp_err_t dmx_net_bridge_start(const dmx_net_config_t *config, dmx_net_bridge_handle_t *out_handle)
+{
+    if (config == NULL || out_handle == NULL || config->dmx_handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!config->enable_artnet && !config->enable_sacn)
+    {
+        ESP_LOGE(TAG, "Neither Art-Net nor sACN enabled");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (config->enable_sacn && (config->sacn_universe == 0 || config->sacn_universe > SACN_MAX_UNIVERSE))
+    {
+        ESP_LOGE(TAG, "Invalid sACN universe: %d", config->sacn_universe);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_net_bridge_t *bridge = (dmx_net_bridge_t *)calloc(1, sizeof(dmx_net_bridge_t));
+    if (bridge == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate bridge context");
+        return ESP_ERR_NO_MEM;
+    }
+
+    bridge->config = *config;
+    bridge->latency_lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    bridge->artnet_sock = -1;
+    bridge->sacn_sock = -1;
+
+    if (config->enable_artnet)
+    {
+        bridge->artnet_sock = net_open_socket(ARTNET_PORT);
+        if (bridge->artnet_sock < 0)
+        {
+            ESP_LOGE(TAG, "Failed to open Art-Net socket");
+            free(bridge);
+            return ESP_FAIL;
+        }
+    }
+
+    if (config->enable_sacn)
+    {
+        bridge->sacn_sock = net_open_socket(SACN_PORT);
+        if (bridge->sacn_sock < 0)
+        {
+            ESP_LOGE(TAG, "Failed to open sACN socket");
+            if (bridge->artnet_sock >= 0)
+            {
+                close(bridge->artnet_sock);
+            }
+            free(bridge);
+            return ESP_FAIL;
+        }
+        net_join_sacn_group(bridge->sacn_sock, config->sacn_universe);
+    }
+
+    esp_err_t err = dmx_add_tx_callback(config->dmx_handle, net_frame_slot, bridge);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to add frame slot callback: %s", esp_err_to_name(err));
+        if (bridge->artnet_sock >= 0)
+        {
+            close(bridge->artnet_sock);
+        }
+        if (bridge->sacn_sock >= 0)
+        {
+            close(bridge->sacn_sock);
+        }
+        free(bridge);
+        return err;
+    }
+
+    bridge->is_running = true;
+
+    BaseType_t ret = xTaskCreate(dmx_net_task, "dmx_net", NET_TASK_STACK_SIZE,
+                                 bridge, NET_TASK_PRIORITY, &bridge->task_handle);
+    if (ret != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create bridge task");
+        dmx_remove_tx_callback(config->dmx_handle, net_frame_slot, bridge);
+        if (bridge->artnet_sock >= 0)
+        {
+            close(bridge->artnet_sock);
+        }
+        if (bridge->sacn_sock >= 0)
+        {
+            close(bridge->sacn_sock);
+        }
+        free(bridge);
+        return ESP_FAIL;
+    }
+
+    *out_handle = (dmx_net_bridge_handle_t)bridge;
+    ESP_LOGI(TAG, "DMX network bridge started: Art-Net %s (universe %d), sACN %s (universe %d)",
+             config->enable_artnet ? "on" : "off", config->artnet_universe,
+             config->enable_sacn ? "on" : "off", config->sacn_universe);
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_net_bridge_stop(dmx_net_bridge_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_net_bridge_t *bridge = (dmx_net_bridge_t *)handle;
+
+    bridge->is_running = false;
+    dmx_remove_tx_callback(bridge->config.dmx_handle, net_frame_slot, bridge);
+
+    // The task wakes from select() at least every NET_SELECT_TIMEOUT_MS
+    vTaskDelay(pdMS_TO_TICKS(NET_SELECT_TIMEOUT_MS + 50));
+
+    if (bridge->artnet_sock >= 0)
+    {
+        close(bridge->artnet_sock);
+    }
+    if (bridge->sacn_sock >= 0)
+    {
+        close(bridge->sacn_sock);
+    }
+
+    free(bridge);
+    ESP_LOGI(TAG, "DMX network bridge stopped");
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_net_bridge_get_stats(dmx_net_bridge_handle_t handle, dmx_net_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_net_bridge_t *bridge = (dmx_net_bridge_t *)handle;
+    portENTER_CRITICAL(&bridge->latency_lock);
+    *out_stats = bridge->stats;
+    portEXIT_CRITICAL(&bridge->latency_lock);
+
+    return ESP_OK;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file dmx_net_proto.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Art-Net and sACN / E1.31 packet decoding implementation
+ */
+
+#include "dmx_net_proto.h"
+#include <string.h>
+
+static const uint8_t ARTNET_ID[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+static const uint8_t ACN_PACKET_ID[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+
+#define SACN_VECTOR_ROOT_DATA 0x00000004
+#define SACN_VECTOR_ROOT_EXTENDED 0x00000008
+#define SACN_VECTOR_FRAME_DATA 0x00000002
+#define SACN_VECTOR_DMP_SET_PROPERTY 0x02
+#define SACN_DMP_ADDRESS_TYPE 0xA1
+
+static inline uint16_t read_be16(const uint8_t *p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static inline uint32_t read_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+esp_err_t dmx_net_parse_artnet(const uint8_t *packet, size_t len, dmx_net_frame_t *out_frame)
+{
+    if (packet == NULL || out_frame == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (len < 10 || memcmp(packet, ARTNET_ID, sizeof(ARTNET_ID)) != 0)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    uint16_t opcode = (uint16_t)(packet[8] | (packet[9] << 8)); // Little endian
+    if (opcode != ARTNET_OPCODE_DMX)
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    if (len < ARTNET_HEADER_SIZE + 2 || read_be16(&packet[10]) < ARTNET_PROTOCOL_VERSION)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    uint16_t length = read_be16(&packet[16]);
+    if (length < 2 || length > 512 || (size_t)(ARTNET_HEADER_SIZE + length) > len)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    out_frame->sequence = packet[12];
+    out_frame->universe = (uint16_t)(((packet[15] & 0x7F) << 8) | packet[14]);
+    out_frame->priority = SACN_DEFAULT_PRIORITY;
+    out_frame->options = 0;
+    out_frame->start_code = 0x00;
+    out_frame->data = &packet[ARTNET_HEADER_SIZE];
+    out_frame->length = length;
+
+    return ESP_OK;
+}
+
+esp_err_t dmx_net_parse_sacn(const uint8_t *packet, size_t len, dmx_net_frame_t *out_frame)
+{
+    if (packet == NULL || out_frame == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Root layer
+    if (len < 22 || read_be16(&packet[0]) != 0x0010 || read_be16(&packet[2]) != 0x0000 ||
+        memcmp(&packet[4], ACN_PACKET_ID, sizeof(ACN_PACKET_ID)) != 0)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    uint32_t root_vector = read_be32(&packet[18]);
+    if (root_vector == SACN_VECTOR_ROOT_EXTENDED)
+    {
+        return ESP_ERR_NOT_SUPPORTED; // Synchronization / discovery
+    }
+    if (root_vector != SACN_VECTOR_ROOT_DATA || len < SACN_HEADER_SIZE)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    // Framing layer
+    if (read_be32(&packet[40]) != SACN_VECTOR_FRAME_DATA)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    uint16_t universe = read_be16(&packet[113]);
+    if (universe == 0 || universe > SACN_MAX_UNIVERSE)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    // DMP layer
+    if (packet[117] != SACN_VECTOR_DMP_SET_PROPERTY || packet[118] != SACN_DMP_ADDRESS_TYPE ||
+        read_be16(&packet[119]) != 0x0000 || read_be16(&packet[121]) != 0x0001)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    uint16_t count = read_be16(&packet[123]); // Start code + slots
+    if (count < 2 || count > 513 || (size_t)(SACN_HEADER_SIZE - 1 + count) > len)
+    {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    out_frame->priority = packet[108];
+    out_frame->sequence = packet[111];
+    out_frame->options = packet[112];
+    out_frame->universe = universe;
+    out_frame->start_code = packet[125];
+    out_frame->data = &packet[SACN_HEADER_SIZE];
+    out_frame->length = count - 1;
+
+    return ESP_OK;
+}
+
+int dmx_net_sacn_sequence_ok(uint8_t last, uint8_t current)
+{
+    int8_t diff = (int8_t)(current - last);
+    return !(diff <= 0 && diff > -20);
+}
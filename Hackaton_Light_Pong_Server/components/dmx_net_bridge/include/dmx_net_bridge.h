@@ -0,0 +1,102 @@
+/**
+ * @file dmx_net_bridge.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Art-Net / sACN (E1.31) network ingest feeding the DMX driver
+ *
+ * Listens for Art-Net OpDmx and E1.31 data packets on UDP and writes the
+ * slots of the configured universe straight into the DMX back buffer.
+ * Requires a network interface that is already up (Wi-Fi STA or Ethernet).
+ */
+
+#ifndef DMX_NET_BRIDGE_H
+#define DMX_NET_BRIDGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+#include "dmx_merge.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Network bridge configuration
+     */
+    typedef struct
+    {
+        dmx_handle_t dmx_handle;    ///< Universe to feed
+        dmx_source_handle_t source; ///< Optional merge source (NULL = write the back buffer directly)
+        bool enable_artnet;         ///< Listen for Art-Net on ARTNET_PORT
+        uint16_t artnet_universe;   ///< Art-Net 15-bit port-address to accept
+        bool enable_sacn;           ///< Listen for sACN on SACN_PORT (joins the multicast group)
+        uint16_t sacn_universe;     ///< sACN universe to accept (1-63999)
+    } dmx_net_config_t;
+
+    /**
+     * @brief Network bridge statistics
+     */
+    typedef struct
+    {
+        uint32_t artnet_packets;  ///< Art-Net OpDmx packets applied
+        uint32_t sacn_packets;    ///< sACN data packets applied
+        uint32_t ignored_packets; ///< Valid packets for other universes, start codes or opcodes
+        uint32_t invalid_packets; ///< Malformed packets
+        uint32_t out_of_order;    ///< sACN packets dropped by the sequence check
+        uint32_t packet_rate_hz;  ///< Applied packets per second over the last second
+        uint32_t latency_last_us; ///< Packet arrival to the frame slot that carries its data
+        uint32_t latency_max_us;
+        uint32_t latency_mean_us;
+    } dmx_net_stats_t;
+
+    /**
+     * @brief Network bridge handle
+     */
+    typedef void *dmx_net_bridge_handle_t;
+
+    /**
+     * @brief Start the network bridge
+     *
+     * Adds a frame slot callback to the DMX handle to measure latency, so
+     * continuous transmission must run for the latency statistics.
+     *
+     * @param config Bridge configuration
+     * @param out_handle Pointer to store the bridge handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory
+     *      - ESP_FAIL: Socket setup or task creation failed
+     *      - Others: Error from dmx_add_tx_callback()
+     */
+    esp_err_t dmx_net_bridge_start(const dmx_net_config_t *config, dmx_net_bridge_handle_t *out_handle);
+
+    /**
+     * @brief Stop the network bridge and close its sockets
+     *
+     * @param handle Bridge handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t dmx_net_bridge_stop(dmx_net_bridge_handle_t handle);
+
+    /**
+     * @brief Get network bridge statistics
+     *
+     * @param handle Bridge handle
+     * @param out_stats Pointer to store the statistics
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_net_bridge_get_stats(dmx_net_bridge_handle_t handle, dmx_net_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_NET_BRIDGE_H
@@ -0,0 +1,96 @@
+/**
+ * @file dmx_net_proto.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Art-Net (OpDmx) and sACN / E1.31 data packet decoding
+ *
+ * Pure decoding helpers without any socket or RTOS dependency, so they can
+ * be exercised on the ESP-IDF linux target as well. Decoded frames point
+ * into the packet buffer; slot data is never copied.
+ */
+
+#ifndef DMX_NET_PROTO_H
+#define DMX_NET_PROTO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Art-Net */
+#define ARTNET_PORT 6454
+#define ARTNET_OPCODE_DMX 0x5000
+#define ARTNET_PROTOCOL_VERSION 14
+#define ARTNET_HEADER_SIZE 18
+
+/* sACN / E1.31 */
+#define SACN_PORT 5568
+#define SACN_MAX_UNIVERSE 63999
+#define SACN_HEADER_SIZE 126 // Root + framing + DMP layer up to and including the start code
+#define SACN_OPTION_PREVIEW 0x80
+#define SACN_OPTION_TERMINATED 0x40
+#define SACN_DEFAULT_PRIORITY 100
+
+    /**
+     * @brief One decoded DMX universe update
+     */
+    typedef struct
+    {
+        uint16_t universe;  ///< Art-Net 15-bit port-address or sACN universe
+        uint8_t sequence;   ///< Sequence number (0 = disabled for Art-Net)
+        uint8_t priority;   ///< sACN priority (Art-Net: SACN_DEFAULT_PRIORITY)
+        uint8_t options;    ///< sACN options byte (Art-Net: 0)
+        uint8_t start_code; ///< DMX start code
+        const uint8_t *data; ///< Slot 1..length, points into the packet
+        uint16_t length;    ///< Number of slots (1-512)
+    } dmx_net_frame_t;
+
+    /**
+     * @brief Decode an Art-Net OpDmx packet
+     *
+     * @param packet Received UDP payload
+     * @param len Payload length
+     * @param out_frame Decoded frame (data points into packet)
+     * @return
+     *      - ESP_OK: Valid OpDmx packet
+     *      - ESP_ERR_NOT_SUPPORTED: Valid Art-Net packet with another opcode
+     *      - ESP_ERR_INVALID_RESPONSE: Not a well-formed Art-Net packet
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_net_parse_artnet(const uint8_t *packet, size_t len, dmx_net_frame_t *out_frame);
+
+    /**
+     * @brief Decode an sACN / E1.31 data packet
+     *
+     * @param packet Received UDP payload
+     * @param len Payload length
+     * @param out_frame Decoded frame (data points into packet)
+     * @return
+     *      - ESP_OK: Valid E1.31 data packet
+     *      - ESP_ERR_NOT_SUPPORTED: Valid ACN packet that is not E1.31 data (e.g. sync)
+     *      - ESP_ERR_INVALID_RESPONSE: Not a well-formed E1.31 packet
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t dmx_net_parse_sacn(const uint8_t *packet, size_t len, dmx_net_frame_t *out_frame);
+
+    /**
+     * @brief Check an sACN sequence number against the last accepted one
+     *
+     * Implements the E1.31 rule: a packet is out of order if it is between 1
+     * and 20 sequence numbers behind the last accepted packet.
+     *
+     * @param last Last accepted sequence number
+     * @param current Sequence number of the new packet
+     * @return 1 if the packet should be accepted, 0 otherwise
+     */
+    int dmx_net_sacn_sequence_ok(uint8_t last, uint8_t current);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_NET_PROTO_H
@@ -3,6 +3,11 @@
  * @author Matthias Hefel
  * @date 2026
  * @brief ESP-NOW communication handler with dynamic peer discovery
+ *
+ * The receive callback runs in the Wi-Fi task, so it only copies each packet
+ * with its arrival time into a single-producer/single-consumer ring and
+ * notifies the receiver task, which does the logging, peer registration and
+ * replies.
  */
 
 #include "espnow_handler.h"
@@ -13,24 +18,68 @@
 #include "nvs_flash.h"
 #include "esp_event.h"
 #include "esp_netif.h"
+#include "esp_timer.h"
+#include "latency_trace.h"
+#include "player_registry.h"
+#include "peer_link.h"
+#include "espnow_reliable.h"
+#include "freertos/task.h"
+#include <stdatomic.h>
 #include <string.h>
 
 static const char *TAG = "espnow_handler";
 
-// Maximum number of players
-#define MAX_PLAYERS 2
+// Paddles sending heartbeats expire after this much silence; checked by the receiver task
+#define ESPNOW_HEARTBEAT_TIMEOUT_MS 5000
+#define ESPNOW_EXPIRY_SWEEP_MS 1000
+
+// Received packets buffered between the Wi-Fi task and the receiver task (power of two)
+#define ESPNOW_RX_RING_SIZE 16
+#define ESPNOW_RX_RING_MASK (ESPNOW_RX_RING_SIZE - 1)
 
 // Broadcast MAC address
 static const uint8_t BROADCAST_MAC[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
 
+/**
+ * @brief One received packet
+ */
+typedef struct
+{
+    int64_t rx_us; // esp_timer time at the receive callback
+    uint8_t mac[6];
+    int8_t rssi;
+    uint8_t len;
+    uint8_t data[ESP_NOW_MAX_DATA_LEN];
+} espnow_rx_packet_t;
+
+// Receive ring: head is only written by on_receive(), tail only by the receiver task
+static espnow_rx_packet_t rx_ring[ESPNOW_RX_RING_SIZE];
+static atomic_uint rx_head;
+static atomic_uint rx_tail;
+static TaskHandle_t rx_worker = NULL;
+
+// Written by on_receive() only
+static espnow_rx_stats_t rx_stats;
+
 // Context for communication with game controller
 static EventGroupHandle_t paddle_events = NULL;
 static volatile uint8_t *last_btn_left_pressed = NULL;
 static volatile uint8_t *last_btn_right_pressed = NULL;
 
-// Dynamic player registry
-static uint8_t player_macs[MAX_PLAYERS][6];
-static uint8_t num_players = 0;
+/**
+ * @brief What a hit of each role raises
+ */
+typedef struct
+{
+    EventBits_t event_bit;
+    uint8_t button;                 // PADDLE_PROTO_BTN_* read from the paddle
+    volatile uint8_t **button_state; // Where the game reads the button from
+} espnow_role_map_t;
+
+static const espnow_role_map_t role_map[PLAYER_ROLE_COUNT] = {
+    [PLAYER_ROLE_TOP] = {PADDLE_TOP_HIT, PADDLE_PROTO_BTN_RIGHT, &last_btn_left_pressed},
+    [PLAYER_ROLE_BOTTOM] = {PADDLE_BOTTOM_HIT, PADDLE_PROTO_BTN_LEFT, &last_btn_right_pressed},
+};
 
 void espnow_set_context(EventGroupHandle_t events, volatile uint8_t *btn_left, volatile uint8_t *btn_right)
 {
@@ -41,155 +90,267 @@ void espnow_set_context(EventGroupHandle_t events, volatile uint8_t *btn_left, v
 
 uint8_t espnow_get_num_players(void)
 {
-    return num_players;
+    return player_registry_count();
 }
 
 uint8_t espnow_get_player_id(const uint8_t *mac_addr)
 {
-    for (uint8_t i = 0; i < num_players; i++)
+    return player_registry_find(mac_addr);
+}
+
+esp_err_t espnow_remove_player(uint8_t player_id)
+{
+    player_info_t info;
+    esp_err_t ret = player_registry_get(player_id, &info);
+    if (ret != ESP_OK)
     {
-        if (memcmp(player_macs[i], mac_addr, 6) == 0)
-        {
-            return i + 1;
-        }
+        return ret;
     }
-    return 0;
+
+    espnow_reliable_forget(player_id);
+    esp_now_del_peer(info.mac);
+    return player_registry_remove(player_id);
 }
 
-static void handle_hello_message(const uint8_t *mac_addr)
+static void send_assignment(uint8_t player_id, uint8_t status)
 {
-    // Check if player already registered
-    uint8_t existing_id = espnow_get_player_id(mac_addr);
-    if (existing_id > 0)
+    server_assign_t assign = {
+        .type = MSG_SERVER_ASSIGN,
+        .player_id = player_id,
+        .status = status};
+    esp_err_t ret;
+
+    if (player_id != 0)
     {
-        ESP_LOGI(TAG, "Player already registered as ID %d", existing_id);
-
-        // Send assignment confirmation via broadcast (client may not have added us as peer yet)
-        server_assign_t assign = {
-            .type = MSG_SERVER_ASSIGN,
-            .player_id = existing_id,
-            .status = 2};
-        esp_err_t ret = esp_now_send(BROADCAST_MAC, (uint8_t *)&assign, sizeof(assign));
-        if (ret != ESP_OK)
-        {
-            ESP_LOGW(TAG, "Failed to send assignment confirmation: %s", esp_err_to_name(ret));
-        }
-        return;
+        // Registered players get their ID acknowledged and retried; the paddle
+        // receives unicast from any sender, peer or not
+        ret = espnow_reliable_send(player_id, ESPNOW_RELIABLE_ASSIGN, &assign, sizeof(assign));
+    }
+    else
+    {
+        // Rejections go to a paddle that has no ID to address it by
+        ret = espnow_reliable_send_once(BROADCAST_MAC, &assign, sizeof(assign));
     }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Failed to send assignment (status %d): %s", status, esp_err_to_name(ret));
+    }
+}
 
-    if (num_players >= MAX_PLAYERS)
+static void handle_hello_message(const espnow_rx_packet_t *packet)
+{
+    const uint8_t *mac_addr = packet->mac;
+    uint8_t player_id = 0;
+    esp_err_t ret = player_registry_add(mac_addr, packet->rx_us, &player_id);
+
+    if (ret == ESP_ERR_INVALID_STATE)
     {
-        ESP_LOGW(TAG, "Game full, rejecting new player");
-
-        server_assign_t assign = {
-            .type = MSG_SERVER_ASSIGN,
-            .player_id = 0,
-            .status = 1};
-        esp_err_t ret = esp_now_send(BROADCAST_MAC, (uint8_t *)&assign, sizeof(assign));
-        if (ret != ESP_OK)
-        {
-            ESP_LOGW(TAG, "Failed to send game full message: %s", esp_err_to_name(ret));
-        }
+        // A paddle saying HELLO again has restarted and numbers its inputs from scratch
+        ESP_LOGI(TAG, "Player already registered as ID %d", player_id);
+        peer_link_reset(player_id);
+        send_assignment(player_id, 2);
+        return;
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Game full (%d players), rejecting new player", PLAYER_REGISTRY_MAX_PLAYERS);
+        send_assignment(0, 1);
         return;
     }
-
-    memcpy(player_macs[num_players], mac_addr, 6);
-    num_players++;
-    uint8_t assigned_id = num_players;
 
     esp_now_peer_info_t peer = {0};
     memcpy(peer.peer_addr, mac_addr, 6);
     peer.ifidx = ESP_IF_WIFI_STA;
     peer.channel = 0;
     peer.encrypt = false;
-    esp_err_t ret = esp_now_add_peer(&peer);
+    ret = esp_now_add_peer(&peer);
 
-    if (ret == ESP_OK)
+    if (ret == ESP_OK || ret == ESP_ERR_ESPNOW_EXIST)
     {
-        ESP_LOGI(TAG, "Player %d registered: %02X:%02X:%02X:%02X:%02X:%02X",
-                 assigned_id,
+        ESP_LOGI(TAG, "Player %d registered as role %d: %02X:%02X:%02X:%02X:%02X:%02X",
+                 player_id, player_registry_get_role(player_id),
                  mac_addr[0], mac_addr[1], mac_addr[2],
                  mac_addr[3], mac_addr[4], mac_addr[5]);
-
-        server_assign_t assign = {
-            .type = MSG_SERVER_ASSIGN,
-            .player_id = assigned_id,
-            .status = 0};
-        ret = esp_now_send(BROADCAST_MAC, (uint8_t *)&assign, sizeof(assign));
-        if (ret != ESP_OK)
-        {
-            ESP_LOGW(TAG, "Failed to send player assignment: %s", esp_err_to_name(ret));
-        }
+        peer_link_reset(player_id);
+        send_assignment(player_id, 0);
     }
     else
     {
+        // ESP-NOW's peer table is shared with the broadcast peer
         ESP_LOGE(TAG, "Failed to add peer: %s", esp_err_to_name(ret));
-        num_players--;
+        player_registry_remove(player_id);
+        send_assignment(0, 1);
     }
 }
 
-static void handle_paddle_input(const uint8_t *mac_addr, const uint8_t *data, int len)
+/**
+ * @brief Drop heartbeat sending paddles that have gone silent, freeing their slots
+ */
+static void expire_players(void)
 {
-    if (len < sizeof(input_event_t))
+    player_info_t expired[4];
+    uint8_t count;
+
+    do
     {
-        ESP_LOGW(TAG, "Invalid paddle input size: %d", len);
-        return;
-    }
+        count = player_registry_expire(esp_timer_get_time(), ESPNOW_HEARTBEAT_TIMEOUT_MS, expired,
+                                       sizeof(expired) / sizeof(expired[0]));
+        for (uint8_t i = 0; i < count; i++)
+        {
+            espnow_reliable_forget(expired[i].player_id);
+            esp_now_del_peer(expired[i].mac);
+            ESP_LOGI(TAG, "Player %d timed out: %02X:%02X:%02X:%02X:%02X:%02X", expired[i].player_id,
+                     expired[i].mac[0], expired[i].mac[1], expired[i].mac[2],
+                     expired[i].mac[3], expired[i].mac[4], expired[i].mac[5]);
+        }
+    } while (count == sizeof(expired) / sizeof(expired[0]));
+}
 
-    input_event_t *m = (input_event_t *)data;
-    uint8_t player_id = espnow_get_player_id(mac_addr);
+/**
+ * @brief Answer a paddle input that carries a sequence number, for round trip timing
+ */
+static void send_input_echo(const espnow_rx_packet_t *packet, uint8_t player_id, uint32_t seq)
+{
+    input_echo_t echo = {
+        .type = MSG_INPUT_ECHO,
+        .player_id = player_id,
+        .seq = seq,
+        .server_us = (uint32_t)(esp_timer_get_time() - packet->rx_us)};
 
-    if (player_id == 0)
+    esp_err_t ret = espnow_reliable_send_once(packet->mac, &echo, sizeof(echo));
+    if (ret != ESP_OK)
     {
-        ESP_LOGW(TAG, "Received input from unregistered player");
-        return;
+        ESP_LOGW(TAG, "Failed to send input echo: %s", esp_err_to_name(ret));
     }
+}
 
-    if (player_id == 1)
+/**
+ * @brief Raise the hit of a registered player, in either wire format
+ *
+ * Numbered inputs seen before, or overtaken by a newer one, are echoed so the
+ * paddle stops retransmitting, but do not raise another hit.
+ *
+ * @param player_id Registered player ID
+ * @param buttons PADDLE_PROTO_BTN_* bits
+ * @param seq Sequence number, or NULL if the input carries none
+ * @param seq_bits Width of the sequence number on the wire
+ */
+static void dispatch_paddle_input(const espnow_rx_packet_t *packet, uint8_t player_id, uint8_t buttons,
+                                  const uint32_t *seq, uint8_t seq_bits)
+{
+    peer_link_verdict_t verdict = PEER_LINK_NEW;
+    if (seq != NULL)
     {
-        if (last_btn_left_pressed != NULL)
-        {
-            *last_btn_left_pressed = m->btn_right_pressed;
-        }
-        ESP_LOGI(TAG, "LEFT PADDLE (Player 1) HIT! Button: %d", m->btn_right_pressed);
-
-        if (paddle_events != NULL)
+        verdict = peer_link_check(player_id, *seq, seq_bits);
+        if (verdict != PEER_LINK_NEW)
         {
-            xEventGroupSetBits(paddle_events, PADDLE_TOP_HIT);
+            ESP_LOGD(TAG, "Player %d input %lu dropped (verdict %d)", player_id, (unsigned long)*seq, verdict);
         }
     }
-    else if (player_id == 2)
+
+    player_role_t role = player_registry_get_role(player_id);
+    if (verdict == PEER_LINK_NEW && role != PLAYER_ROLE_NONE)
     {
-        if (last_btn_right_pressed != NULL)
+        const espnow_role_map_t *map = &role_map[role];
+        uint8_t button = (buttons & map->button) ? 1 : 0;
+
+        // Traced per side, like the game waits per side
+        latency_trace_begin(role - PLAYER_ROLE_TOP, packet->rx_us);
+        latency_trace_mark(role - PLAYER_ROLE_TOP, LATENCY_STAGE_DISPATCH);
+
+        if (*map->button_state != NULL)
         {
-            *last_btn_right_pressed = m->btn_left_pressed;
+            **map->button_state = button;
         }
-        ESP_LOGI(TAG, "RIGHT PADDLE (Player 2) HIT! Button: %d", m->btn_left_pressed);
+        ESP_LOGI(TAG, "%s PADDLE (Player %d) HIT! Button: %d",
+                 (role == PLAYER_ROLE_TOP) ? "LEFT" : "RIGHT", player_id, button);
 
         if (paddle_events != NULL)
         {
-            xEventGroupSetBits(paddle_events, PADDLE_BOTTOM_HIT);
+            xEventGroupSetBits(paddle_events, map->event_bit);
         }
+        latency_trace_mark(role - PLAYER_ROLE_TOP, LATENCY_STAGE_EVENT);
+    }
+
+    if (seq != NULL && verdict != PEER_LINK_STALE)
+    {
+        send_input_echo(packet, player_id, *seq);
     }
 }
 
-void on_receive(const esp_now_recv_info_t *recv_info, const uint8_t *data, int len)
+/**
+ * @brief Legacy float input_event_t, optionally followed by a sequence number
+ */
+static void handle_paddle_input(const espnow_rx_packet_t *packet, uint8_t player_id)
+{
+    int len = packet->len;
+
+    if (len < sizeof(input_event_t))
+    {
+        ESP_LOGW(TAG, "Invalid paddle input size: %d", len);
+        return;
+    }
+
+    const input_event_t *m = (const input_event_t *)packet->data;
+    uint8_t buttons = (m->btn_right_pressed ? PADDLE_PROTO_BTN_RIGHT : 0) |
+                      (m->btn_left_pressed ? PADDLE_PROTO_BTN_LEFT : 0);
+
+    if (len >= sizeof(input_event_seq_t))
+    {
+        uint32_t seq = ((const input_event_seq_t *)packet->data)->seq;
+        dispatch_paddle_input(packet, player_id, buttons, &seq, 32);
+    }
+    else
+    {
+        dispatch_paddle_input(packet, player_id, buttons, NULL, 0);
+    }
+}
+
+/**
+ * @brief Compact paddle_protocol frame
+ */
+static void handle_paddle_packed(const espnow_rx_packet_t *packet, uint8_t player_id)
 {
-    if (len < 1)
+    paddle_proto_frame_t frame;
+    esp_err_t ret = paddle_proto_decode(packet->data, packet->len, &frame);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Invalid paddle frame (len=%d): %s", packet->len, esp_err_to_name(ret));
         return;
+    }
 
-    const uint8_t *mac_addr = recv_info->src_addr;
+    uint32_t seq = frame.seq;
+    dispatch_paddle_input(packet, player_id, frame.buttons, &seq, 16);
+}
+
+/**
+ * @brief Process one packet from the receive ring in the receiver task
+ */
+static void espnow_handle_packet(const espnow_rx_packet_t *packet)
+{
+    const uint8_t *mac_addr = packet->mac;
+    const uint8_t *data = packet->data;
+    int len = packet->len;
     uint8_t msg_type = data[0];
 
+    // Any packet of a registered paddle shows it is still there
+    uint8_t player_id = player_registry_find(mac_addr);
+    if (player_id != 0)
+    {
+        player_registry_touch(player_id, packet->rx_us, msg_type == MSG_HEARTBEAT);
+        peer_link_packet(player_id, packet->rssi, packet->rx_us);
+    }
+
     switch (msg_type)
     {
     case MSG_HELLO:
         if (len == sizeof(hello_t))
         {
-            ESP_LOGI(TAG, "Received HELLO from %02X:%02X:%02X:%02X:%02X:%02X (len=%d)",
+            ESP_LOGI(TAG, "Received HELLO from %02X:%02X:%02X:%02X:%02X:%02X (len=%d, rssi=%d)",
                      mac_addr[0], mac_addr[1], mac_addr[2],
-                     mac_addr[3], mac_addr[4], mac_addr[5], len);
-            handle_hello_message(mac_addr);
+                     mac_addr[3], mac_addr[4], mac_addr[5], len, packet->rssi);
+            handle_hello_message(packet);
         }
         else
         {
@@ -198,7 +359,22 @@ void on_receive(const esp_now_recv_info_t *recv_info, const uint8_t *data, int l
         break;
 
     case MSG_PADDLE_INPUT:
-        handle_paddle_input(mac_addr, data, len);
+    case MSG_PADDLE_PACKED:
+        if (player_id == 0)
+        {
+            ESP_LOGW(TAG, "Received input from unregistered player");
+        }
+        else if (msg_type == MSG_PADDLE_INPUT)
+        {
+            handle_paddle_input(packet, player_id);
+        }
+        else
+        {
+            handle_paddle_packed(packet, player_id);
+        }
+        break;
+
+    case MSG_HEARTBEAT:
         break;
 
     default:
@@ -207,6 +383,62 @@ void on_receive(const esp_now_recv_info_t *recv_info, const uint8_t *data, int l
     }
 }
 
+void on_receive(const esp_now_recv_info_t *recv_info, const uint8_t *data, int len)
+{
+    int64_t start = esp_timer_get_time();
+
+    if (len < 1 || len > ESP_NOW_MAX_DATA_LEN)
+        return;
+
+    unsigned head = atomic_load_explicit(&rx_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&rx_tail, memory_order_acquire);
+
+    if (head - tail >= ESPNOW_RX_RING_SIZE)
+    {
+        // Receiver task is behind; drop the newest packet
+        rx_stats.overruns++;
+    }
+    else
+    {
+        espnow_rx_packet_t *packet = &rx_ring[head & ESPNOW_RX_RING_MASK];
+        packet->rx_us = start;
+        memcpy(packet->mac, recv_info->src_addr, 6);
+        packet->rssi = (recv_info->rx_ctrl != NULL) ? (int8_t)recv_info->rx_ctrl->rssi : 0;
+        packet->len = (uint8_t)len;
+        memcpy(packet->data, data, len);
+        atomic_store_explicit(&rx_head, head + 1, memory_order_release);
+
+        rx_stats.received++;
+        if (head + 1 - tail > rx_stats.ring_high_water)
+        {
+            rx_stats.ring_high_water = head + 1 - tail;
+        }
+        if (rx_worker != NULL)
+        {
+            xTaskNotifyGive(rx_worker);
+        }
+    }
+
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start);
+    rx_stats.callback_us_total += elapsed_us;
+    if (elapsed_us > rx_stats.callback_us_max)
+    {
+        rx_stats.callback_us_max = elapsed_us;
+    }
+}
+
+esp_err_t espnow_get_rx_stats(espnow_rx_stats_t *out_stats)
+{
+    if (out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Fields are single words written by one task; a snapshot may mix two packets
+    *out_stats = rx_stats;
+    return ESP_OK;
+}
+
 void add_peer(const uint8_t mac[6])
 {
     esp_now_peer_info_t peer = {0};
@@ -235,7 +467,9 @@ void espnow_receiver_task(void *pvParameters)
 
     // ESP-NOW init
     esp_now_init();
+    rx_worker = xTaskGetCurrentTaskHandle();
     esp_now_register_recv_cb((esp_now_recv_cb_t)on_receive);
+    espnow_reliable_init(rx_worker);
 
     // Add broadcast address as peer to enable broadcasting
     uint8_t broadcast_mac[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
@@ -256,24 +490,96 @@ void espnow_receiver_task(void *pvParameters)
              mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
     ESP_LOGI(TAG, "Waiting for player connections");
 
+    int64_t next_sweep_us = esp_timer_get_time() + ESPNOW_EXPIRY_SWEEP_MS * 1000;
+    int64_t next_send_us = INT64_MAX;
+
     while (1)
     {
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Sleep until a packet, a send completion or the next sweep or retry is due
+        int64_t wake_us = (next_send_us < next_sweep_us) ? next_send_us : next_sweep_us;
+        int64_t wait_us = wake_us - esp_timer_get_time();
+        TickType_t wait = 0;
+        if (wait_us > 0)
+        {
+            // Round up so a retry backoff shorter than a tick does not spin
+            wait = pdMS_TO_TICKS((wait_us + 999) / 1000);
+            wait = (wait > 0) ? wait : 1;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        if (esp_timer_get_time() >= next_sweep_us)
+        {
+            expire_players();
+            next_sweep_us = esp_timer_get_time() + ESPNOW_EXPIRY_SWEEP_MS * 1000;
+        }
+
+        unsigned tail = atomic_load_explicit(&rx_tail, memory_order_relaxed);
+        while (tail != atomic_load_explicit(&rx_head, memory_order_acquire))
+        {
+            espnow_handle_packet(&rx_ring[tail & ESPNOW_RX_RING_MASK]);
+            tail++;
+            // Hand the slot back to on_receive() only after it has been processed
+            atomic_store_explicit(&rx_tail, tail, memory_order_release);
+        }
+
+        next_send_us = espnow_reliable_service(esp_timer_get_time());
+    }
+}
+
+esp_err_t espnow_get_link_stats(uint8_t player_id, peer_link_stats_t *out_stats)
+{
+    player_info_t info;
+    esp_err_t ret = player_registry_get(player_id, &info);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+    return peer_link_get_stats(player_id, out_stats);
+}
+
+void espnow_log_link_stats(void)
+{
+    peer_link_stats_t stats;
+
+    for (uint8_t player_id = 1; player_id <= PLAYER_REGISTRY_MAX_PLAYERS; player_id++)
+    {
+        if (espnow_get_link_stats(player_id, &stats) != ESP_OK)
+        {
+            continue;
+        }
+        ESP_LOGI(TAG, "Player %d link: quality %d%%, loss %d%% (%lu lost), RSSI %d/%d/%d dBm, "
+                      "%lu dup, %lu late, %lu stale",
+                 player_id, stats.quality, stats.loss_pct, (unsigned long)stats.lost,
+                 stats.rssi_last, stats.rssi_avg, stats.rssi_min,
+                 (unsigned long)stats.duplicates, (unsigned long)stats.late, (unsigned long)stats.stale);
+    }
+
+    espnow_reliable_stats_t delivery;
+    if (espnow_reliable_get_stats(&delivery) == ESP_OK)
+    {
+        ESP_LOGI(TAG, "Delivery: %lu queued, %lu delivered, %lu coalesced, %lu sent, %lu retries, %lu dropped",
+                 (unsigned long)delivery.queued, (unsigned long)delivery.delivered,
+                 (unsigned long)delivery.coalesced, (unsigned long)delivery.sent,
+                 (unsigned long)delivery.retries, (unsigned long)delivery.dropped);
     }
 }
 
 esp_err_t espnow_broadcast_score(const void *score, size_t size)
 {
-    if (score == NULL || size == 0)
+    if (score == NULL || size == 0 || size > ESPNOW_RELIABLE_MAX_LEN)
     {
         ESP_LOGE(TAG, "Invalid score pointer or size");
         return ESP_ERR_INVALID_ARG;
     }
 
-    esp_err_t ret = esp_now_send(BROADCAST_MAC, (const uint8_t *)score, size);
-    if (ret != ESP_OK)
+    // One acknowledged unicast per player; a newer score replaces an undelivered one
+    for (uint8_t player_id = 1; player_id <= PLAYER_REGISTRY_MAX_PLAYERS; player_id++)
     {
-        ESP_LOGW(TAG, "Failed to broadcast score: %s", esp_err_to_name(ret));
+        player_info_t info;
+        if (player_registry_get(player_id, &info) == ESP_OK)
+        {
+            espnow_reliable_send(player_id, ESPNOW_RELIABLE_SCORE, score, size);
+        }
     }
-    return ret;
+    return ESP_OK;
 }
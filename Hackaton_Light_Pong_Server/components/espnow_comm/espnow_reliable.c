@@ -0,0 +1,363 @@
+/**
+ * @file espnow_reliable.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Acknowledged unicast delivery implementation
+ */
+
+#include "espnow_reliable.h"
+#include "player_registry.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_now.h"
+
+static const char *TAG = "espnow_reliable";
+
+// Longest wait for the send callback before a transmission counts as failed
+#define ESPNOW_RELIABLE_TX_TIMEOUT_US 100000
+
+// Frames handed to ESP-NOW and awaiting their send callback, a power of two
+#define ESPNOW_RELIABLE_TX_DEPTH 16
+#define ESPNOW_RELIABLE_TX_MASK (ESPNOW_RELIABLE_TX_DEPTH - 1)
+
+/**
+ * @brief Latest payload of one kind for one player
+ */
+typedef struct
+{
+    bool pending;     // Payload not yet delivered
+    uint8_t len;
+    uint8_t attempts; // Failed sends of this payload
+    uint32_t version; // Incremented per queued payload, tells a superseded send apart
+    int64_t due_us;   // Earliest time of the next send
+    uint8_t data[ESPNOW_RELIABLE_MAX_LEN];
+} espnow_reliable_slot_t;
+
+/**
+ * @brief The one outbox transmission waiting for its send callback
+ */
+typedef struct
+{
+    bool active;
+    uint8_t player_id;
+    uint8_t kind;
+    uint32_t version;
+    uint32_t ticket; // Identifies its completion among those of other frames
+    int64_t sent_us;
+} espnow_reliable_flight_t;
+
+/**
+ * @brief A frame handed to ESP-NOW, in send order
+ */
+typedef struct
+{
+    uint8_t mac[6];
+    uint32_t ticket;  // Ticket of an outbox transmission, 0 for a frame sent once
+    atomic_bool sent; // Cleared when esp_now_send() refused the frame, no callback follows
+} espnow_reliable_tx_t;
+
+static portMUX_TYPE reliable_lock = portMUX_INITIALIZER_UNLOCKED;
+static espnow_reliable_slot_t outbox[PLAYER_REGISTRY_MAX_PLAYERS][ESPNOW_RELIABLE_KINDS];
+static espnow_reliable_flight_t flight; // Worker task only
+static uint32_t next_ticket;            // Worker task only
+static espnow_reliable_stats_t stats;
+static TaskHandle_t reliable_worker = NULL;
+
+// Single-producer (worker) / single-consumer (send callback) FIFO of frames sent
+static espnow_reliable_tx_t tx_fifo[ESPNOW_RELIABLE_TX_DEPTH];
+static atomic_uint tx_head;
+static atomic_uint tx_tail;
+static atomic_uint tx_done; // Ticket << 1 | success of the last outbox completion
+
+/**
+ * @brief Send callback, runs in the Wi-Fi task
+ *
+ * ESP-NOW completes frames in send order, so the oldest pending frame to the
+ * same address is the one reported. Frames passed over on the way never got
+ * a callback; an outbox transmission among them runs into its timeout.
+ */
+static void espnow_reliable_sent(const esp_now_send_info_t *tx_info, esp_now_send_status_t status)
+{
+    if (tx_info == NULL || tx_info->des_addr == NULL)
+    {
+        return;
+    }
+
+    unsigned tail = atomic_load_explicit(&tx_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&tx_head, memory_order_acquire);
+    for (unsigned i = tail; i != head; i++)
+    {
+        const espnow_reliable_tx_t *tx = &tx_fifo[i & ESPNOW_RELIABLE_TX_MASK];
+        if (!atomic_load_explicit(&tx->sent, memory_order_relaxed) || memcmp(tx->mac, tx_info->des_addr, 6) != 0)
+        {
+            continue;
+        }
+
+        uint32_t ticket = tx->ticket;
+        atomic_store_explicit(&tx_tail, i + 1, memory_order_release);
+        if (ticket != 0)
+        {
+            atomic_store_explicit(&tx_done, (ticket << 1) | (status == ESP_NOW_SEND_SUCCESS),
+                                  memory_order_release);
+            if (reliable_worker != NULL)
+            {
+                xTaskNotifyGive(reliable_worker);
+            }
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Record a frame in the TX FIFO and hand it to ESP-NOW (worker task only)
+ */
+static esp_err_t espnow_reliable_transmit(const uint8_t *mac, const void *data, size_t len, uint32_t ticket)
+{
+    unsigned head = atomic_load_explicit(&tx_head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&tx_tail, memory_order_acquire) >= ESPNOW_RELIABLE_TX_DEPTH)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    espnow_reliable_tx_t *tx = &tx_fifo[head & ESPNOW_RELIABLE_TX_MASK];
+    memcpy(tx->mac, mac, 6);
+    tx->ticket = ticket;
+    atomic_store_explicit(&tx->sent, true, memory_order_relaxed);
+    // Published before sending, the callback may run before esp_now_send() returns
+    atomic_store_explicit(&tx_head, head + 1, memory_order_release);
+
+    esp_err_t ret = esp_now_send(mac, (const uint8_t *)data, len);
+    if (ret != ESP_OK)
+    {
+        atomic_store_explicit(&tx->sent, false, memory_order_relaxed);
+    }
+    return ret;
+}
+
+esp_err_t espnow_reliable_init(TaskHandle_t worker)
+{
+    if (worker == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    reliable_worker = worker;
+    return esp_now_register_send_cb(espnow_reliable_sent);
+}
+
+esp_err_t espnow_reliable_send_once(const uint8_t *mac, const void *data, size_t len)
+{
+    if (mac == NULL || data == NULL || len == 0 || len > ESP_NOW_MAX_DATA_LEN)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return espnow_reliable_transmit(mac, data, len, 0);
+}
+
+esp_err_t espnow_reliable_send(uint8_t player_id, espnow_reliable_kind_t kind, const void *data, size_t len)
+{
+    if (player_id < 1 || player_id > PLAYER_REGISTRY_MAX_PLAYERS || kind >= ESPNOW_RELIABLE_KINDS ||
+        data == NULL || len == 0 || len > ESPNOW_RELIABLE_MAX_LEN)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&reliable_lock);
+    espnow_reliable_slot_t *slot = &outbox[player_id - 1][kind];
+    if (slot->pending)
+    {
+        stats.coalesced++;
+    }
+    memcpy(slot->data, data, len);
+    slot->len = (uint8_t)len;
+    slot->pending = true;
+    slot->attempts = 0;
+    slot->version++;
+    slot->due_us = 0;
+    stats.queued++;
+    portEXIT_CRITICAL(&reliable_lock);
+
+    if (reliable_worker != NULL)
+    {
+        xTaskNotifyGive(reliable_worker);
+    }
+    return ESP_OK;
+}
+
+void espnow_reliable_forget(uint8_t player_id)
+{
+    if (player_id < 1 || player_id > PLAYER_REGISTRY_MAX_PLAYERS)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&reliable_lock);
+    for (int kind = 0; kind < ESPNOW_RELIABLE_KINDS; kind++)
+    {
+        outbox[player_id - 1][kind].pending = false;
+    }
+    portEXIT_CRITICAL(&reliable_lock);
+}
+
+/**
+ * @brief Settle the outcome of a transmission (lock held)
+ *
+ * @return true if the payload was given up
+ */
+static bool espnow_reliable_settle(uint8_t player_id, uint8_t kind, uint32_t version, bool ok, int64_t now_us)
+{
+    espnow_reliable_slot_t *slot = &outbox[player_id - 1][kind];
+
+    // Superseded or forgotten meanwhile: the newer payload goes out on its own
+    if (!slot->pending || slot->version != version)
+    {
+        return false;
+    }
+
+    if (ok)
+    {
+        slot->pending = false;
+        stats.delivered++;
+        return false;
+    }
+
+    slot->attempts++;
+    if (slot->attempts >= ESPNOW_RELIABLE_MAX_ATTEMPTS)
+    {
+        slot->pending = false;
+        stats.dropped++;
+        return true;
+    }
+    slot->due_us = now_us + ((int64_t)ESPNOW_RELIABLE_BACKOFF_MS * 1000 << (slot->attempts - 1));
+    return false;
+}
+
+/**
+ * @brief Settle a transmission and report a payload given up
+ */
+static void espnow_reliable_complete(uint8_t player_id, uint8_t kind, uint32_t version, bool ok, int64_t now_us)
+{
+    portENTER_CRITICAL(&reliable_lock);
+    bool dropped = espnow_reliable_settle(player_id, kind, version, ok, now_us);
+    portEXIT_CRITICAL(&reliable_lock);
+
+    if (dropped)
+    {
+        ESP_LOGW(TAG, "Player %d: message kind %d dropped after %d attempts", player_id, kind,
+                 ESPNOW_RELIABLE_MAX_ATTEMPTS);
+    }
+}
+
+int64_t espnow_reliable_service(int64_t now_us)
+{
+    if (flight.active)
+    {
+        uint32_t done = atomic_load_explicit(&tx_done, memory_order_acquire);
+        bool completed = (done >> 1) == flight.ticket;
+        if (!completed && now_us - flight.sent_us < ESPNOW_RELIABLE_TX_TIMEOUT_US)
+        {
+            return flight.sent_us + ESPNOW_RELIABLE_TX_TIMEOUT_US;
+        }
+
+        // A missing callback counts as a failed attempt
+        espnow_reliable_complete(flight.player_id, flight.kind, flight.version, completed && (done & 1), now_us);
+        flight.active = false;
+    }
+
+    // Start the next due payload; a failed start is settled and the search goes on
+    for (int tries = 0; tries < PLAYER_REGISTRY_MAX_PLAYERS * ESPNOW_RELIABLE_KINDS; tries++)
+    {
+        int64_t next_us = INT64_MAX;
+        int found = -1;
+        uint8_t data[ESPNOW_RELIABLE_MAX_LEN];
+        uint8_t len = 0;
+        uint32_t version = 0;
+        bool retry = false;
+
+        portENTER_CRITICAL(&reliable_lock);
+        for (int i = 0; i < PLAYER_REGISTRY_MAX_PLAYERS * ESPNOW_RELIABLE_KINDS; i++)
+        {
+            const espnow_reliable_slot_t *slot = &outbox[i / ESPNOW_RELIABLE_KINDS][i % ESPNOW_RELIABLE_KINDS];
+            if (!slot->pending)
+            {
+                continue;
+            }
+            if (slot->due_us <= now_us)
+            {
+                found = i;
+                break;
+            }
+            if (slot->due_us < next_us)
+            {
+                next_us = slot->due_us;
+            }
+        }
+        if (found >= 0)
+        {
+            const espnow_reliable_slot_t *slot = &outbox[found / ESPNOW_RELIABLE_KINDS][found % ESPNOW_RELIABLE_KINDS];
+            memcpy(data, slot->data, slot->len);
+            len = slot->len;
+            version = slot->version;
+            retry = slot->attempts > 0;
+        }
+        portEXIT_CRITICAL(&reliable_lock);
+
+        if (found < 0)
+        {
+            return next_us;
+        }
+
+        uint8_t player_id = (uint8_t)(found / ESPNOW_RELIABLE_KINDS + 1);
+        uint8_t kind = (uint8_t)(found % ESPNOW_RELIABLE_KINDS);
+        player_info_t info;
+        if (player_registry_get(player_id, &info) != ESP_OK)
+        {
+            espnow_reliable_forget(player_id);
+            continue;
+        }
+
+        // Tickets use 31 bits, 0 is reserved for frames sent once
+        next_ticket = (next_ticket + 1) & 0x7FFFFFFF;
+        next_ticket = (next_ticket != 0) ? next_ticket : 1;
+        esp_err_t ret = espnow_reliable_transmit(info.mac, data, len, next_ticket);
+
+        portENTER_CRITICAL(&reliable_lock);
+        stats.sent++;
+        if (retry)
+        {
+            stats.retries++;
+        }
+        portEXIT_CRITICAL(&reliable_lock);
+
+        if (ret == ESP_OK)
+        {
+            flight = (espnow_reliable_flight_t){
+                .active = true,
+                .player_id = player_id,
+                .kind = kind,
+                .version = version,
+                .ticket = next_ticket,
+                .sent_us = now_us};
+            return now_us + ESPNOW_RELIABLE_TX_TIMEOUT_US;
+        }
+        espnow_reliable_complete(player_id, kind, version, false, now_us);
+    }
+
+    return now_us + (int64_t)ESPNOW_RELIABLE_BACKOFF_MS * 1000;
+}
+
+esp_err_t espnow_reliable_get_stats(espnow_reliable_stats_t *out_stats)
+{
+    if (out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&reliable_lock);
+    *out_stats = stats;
+    portEXIT_CRITICAL(&reliable_lock);
+    return ESP_OK;
+}
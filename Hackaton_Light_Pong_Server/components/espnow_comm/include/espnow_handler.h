@@ -13,6 +13,10 @@
 #include "freertos/event_groups.h"
 #include "esp_now.h"
 #include "esp_err.h"
+#include "paddle_protocol.h"
+#include "player_registry.h"
+#include "peer_link.h"
+#include "espnow_reliable.h"
 
 // Event bits for paddle hits
 #define PADDLE_TOP_HIT BIT0
@@ -31,10 +35,13 @@ extern "C"
      */
     typedef enum
     {
-        MSG_HELLO = 0,        // Client registration request
-        MSG_PADDLE_INPUT = 1, // Paddle input data
-        MSG_GAME_SCORE = 2,   // Game score broadcast
-        MSG_SERVER_ASSIGN = 3 // Server player ID assignment
+        MSG_HELLO = 0,                             // Client registration request
+        MSG_PADDLE_INPUT = 1,                      // Paddle input data
+        MSG_GAME_SCORE = 2,                        // Game score broadcast
+        MSG_SERVER_ASSIGN = 3,                     // Server player ID assignment
+        MSG_INPUT_ECHO = 4,                        // Reply to a paddle input carrying a sequence number
+        MSG_PADDLE_PACKED = PADDLE_PROTO_MSG_TYPE, // Compact paddle input, see paddle_protocol.h
+        MSG_HEARTBEAT = 6                          // Client keep-alive
     } msg_type_t;
 
     /**
@@ -45,18 +52,33 @@ extern "C"
         uint8_t type; // MSG_HELLO
     } hello_t;
 
+    /**
+     * @brief Keep-alive from client
+     *
+     * A paddle that has sent one is dropped from the registry once it stays
+     * silent for a few seconds, freeing its player ID. Paddles that never
+     * send heartbeats stay registered.
+     */
+    typedef struct
+    {
+        uint8_t type; // MSG_HEARTBEAT
+    } heartbeat_t;
+
     /**
      * @brief Server assignment response
      */
     typedef struct
     {
         uint8_t type;      // MSG_SERVER_ASSIGN
-        uint8_t player_id; // Assigned player ID (1 or 2)
+        uint8_t player_id; // Assigned player ID (1 to PLAYER_REGISTRY_MAX_PLAYERS)
         uint8_t status;    // 0=accepted, 1=game_full, 2=already_registered
     } server_assign_t;
 
     /**
      * @brief Input event data structure from paddle controllers
+     *
+     * Legacy format, superseded by the compact frames of paddle_protocol.h
+     * (MSG_PADDLE_PACKED); still accepted.
      */
     typedef struct
     {
@@ -69,11 +91,52 @@ extern "C"
     } input_event_t;
 
     /**
-     * @brief Initialize ESP-NOW and start receiver task
+     * @brief Paddle input with a sequence number, answered with an input_echo_t
+     *
+     * Sent as MSG_PADDLE_INPUT; the server tells it apart from a plain
+     * input_event_t by its length.
+     */
+    typedef struct
+    {
+        input_event_t event;
+        uint32_t seq; // Chosen by the client, echoed unchanged
+    } input_event_seq_t;
+
+    /**
+     * @brief Reply to an input_event_seq_t or compact frame for round trip time measurement
+     *
+     * Sent by the receiver task once the paddle event has been raised. The
+     * client's round trip time minus server_us is the time on the air and in
+     * the two ESP-NOW stacks.
+     */
+    typedef struct
+    {
+        uint8_t type;       // MSG_INPUT_ECHO
+        uint8_t player_id;  // Player ID of the sender
+        uint8_t reserved[2];
+        uint32_t seq;       // Sequence number of the paddle input
+        uint32_t server_us; // Time from the receive callback to this reply
+    } input_echo_t;
+
+    /**
+     * @brief Receive path counters
+     */
+    typedef struct
+    {
+        uint32_t received;          ///< Packets queued for the receiver task
+        uint32_t overruns;          ///< Packets dropped because the ring was full
+        uint32_t callback_us_max;   ///< Longest receive callback
+        uint32_t callback_us_total; ///< Time spent in receive callbacks
+        uint32_t ring_high_water;   ///< Most packets queued at once
+    } espnow_rx_stats_t;
+
+    /**
+     * @brief Initialize ESP-NOW and process received packets
+     *
+     * Runs as the receiver task: packets queued by on_receive() are handled
+     * here, outside the Wi-Fi task.
      *
-     * @param paddle_events Event group handle for paddle hit synchronization
-     * @param btn_left Pointer to store left button state
-     * @param btn_right Pointer to store right button state
+     * @param pvParameters Unused
      */
     void espnow_receiver_task(void *pvParameters);
 
@@ -87,12 +150,25 @@ extern "C"
     /**
      * @brief ESP-NOW receive callback
      *
+     * Runs in the Wi-Fi task; only copies the packet into the receive ring
+     * and wakes the receiver task.
+     *
      * @param recv_info Reception info containing source MAC address
      * @param data Received data buffer
      * @param len Length of received data
      */
     void on_receive(const esp_now_recv_info_t *recv_info, const uint8_t *data, int len);
 
+    /**
+     * @brief Get the receive path counters
+     *
+     * @param out_stats Pointer to store the counters
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid pointer
+     */
+    esp_err_t espnow_get_rx_stats(espnow_rx_stats_t *out_stats);
+
     /**
      * @brief Get last button state for left paddle
      */
@@ -110,22 +186,55 @@ extern "C"
 
     /**
      * @brief Get number of registered players
-     * @return Number of registered players (0-2)
+     * @return Number of registered players (0 to PLAYER_REGISTRY_MAX_PLAYERS)
      */
     uint8_t espnow_get_num_players(void);
 
     /**
      * @brief Get player ID from MAC address
      * @param mac_addr MAC address to lookup
-     * @return Player ID (1 or 2), or 0 if not found
+     * @return Player ID (1 to PLAYER_REGISTRY_MAX_PLAYERS), or 0 if not found
      */
     uint8_t espnow_get_player_id(const uint8_t *mac_addr);
 
     /**
-     * @brief Broadcast game score to all connected players
+     * @brief Unregister a player and remove its ESP-NOW peer, freeing the player ID
+     *
+     * @param player_id Player ID
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_NOT_FOUND: No such player
+     */
+    esp_err_t espnow_remove_player(uint8_t player_id);
+
+    /**
+     * @brief Get the link quality of a player
+     *
+     * Duplicated and overtaken inputs are counted there and never raise a hit.
+     *
+     * @param player_id Player ID
+     * @param out_stats Pointer to store the link statistics
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid pointer
+     *      - ESP_ERR_NOT_FOUND: No such player
+     */
+    esp_err_t espnow_get_link_stats(uint8_t player_id, peer_link_stats_t *out_stats);
+
+    /**
+     * @brief Log the link quality of every registered player and the delivery counters
+     */
+    void espnow_log_link_stats(void);
+
+    /**
+     * @brief Send the game score to all registered players
+     *
+     * Queues an acknowledged unicast per player and returns without waiting;
+     * a score not yet delivered is replaced, so only the latest one is retried.
+     *
      * @param score Pointer to game score structure
-     * @param size Size of the score structure in bytes
-     * @return ESP_OK on success, error code otherwise
+     * @param size Size of the score structure in bytes (at most ESPNOW_RELIABLE_MAX_LEN)
+     * @return ESP_OK on success, ESP_ERR_INVALID_ARG on invalid arguments
      */
     esp_err_t espnow_broadcast_score(const void *score, size_t size);
 
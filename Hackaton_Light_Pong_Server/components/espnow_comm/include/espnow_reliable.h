@@ -0,0 +1,132 @@
+/**
+ * @file espnow_reliable.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Acknowledged unicast delivery of state messages to registered paddles
+ *
+ * Every player has one outbox slot per message kind. Sending copies the
+ * payload into the slot and returns; a newer payload replaces one that has
+ * not been delivered yet, so only the latest score is ever retried. The
+ * receiver task sends one slot at a time as ESP-NOW unicast, whose MAC layer
+ * acknowledgement is reported by the send callback, and retries failed
+ * deliveries with exponential backoff up to ESPNOW_RELIABLE_MAX_ATTEMPTS.
+ * Frames that need no acknowledgement go through espnow_reliable_send_once(),
+ * so that every send callback can be attributed to its frame.
+ */
+
+#ifndef ESPNOW_RELIABLE_H
+#define ESPNOW_RELIABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ESPNOW_RELIABLE_MAX_LEN 16     // Largest payload of a state message
+#define ESPNOW_RELIABLE_MAX_ATTEMPTS 6 // Sends of one payload before giving up
+#define ESPNOW_RELIABLE_BACKOFF_MS 10  // Wait after the first failure, doubled per retry
+
+    /**
+     * @brief Message kinds; each kind of a player is delivered independently
+     */
+    typedef enum
+    {
+        ESPNOW_RELIABLE_ASSIGN = 0, ///< Player ID assignment
+        ESPNOW_RELIABLE_SCORE,      ///< Game score
+        ESPNOW_RELIABLE_KINDS
+    } espnow_reliable_kind_t;
+
+    /**
+     * @brief Delivery counters
+     */
+    typedef struct
+    {
+        uint32_t queued;    ///< Payloads handed to espnow_reliable_send()
+        uint32_t coalesced; ///< Payloads replaced by a newer one before delivery
+        uint32_t sent;      ///< Transmissions, including retries
+        uint32_t delivered; ///< Payloads acknowledged by the paddle
+        uint32_t retries;   ///< Transmissions after a failed one
+        uint32_t dropped;   ///< Payloads given up after ESPNOW_RELIABLE_MAX_ATTEMPTS
+    } espnow_reliable_stats_t;
+
+    /**
+     * @brief Register the send callback; called by the receiver task during ESP-NOW setup
+     *
+     * @param worker Task calling espnow_reliable_service(), woken on completions and new payloads
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid task handle
+     *      - Others: Error from esp_now_register_send_cb()
+     */
+    esp_err_t espnow_reliable_init(TaskHandle_t worker);
+
+    /**
+     * @brief Send a frame once, without acknowledgement or retries
+     *
+     * Every frame of this node must go out through this module, from the worker
+     * task, so the send callbacks can be matched to the frames they report.
+     *
+     * @param mac Destination address, may be the broadcast address
+     * @param data Frame
+     * @param len Frame length (1 to ESP_NOW_MAX_DATA_LEN)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Too many frames awaiting their send callback
+     *      - Others: Error from esp_now_send()
+     */
+    esp_err_t espnow_reliable_send_once(const uint8_t *mac, const void *data, size_t len);
+
+    /**
+     * @brief Queue a payload for a player, replacing an undelivered one of the same kind
+     *
+     * Never blocks; delivery happens in the worker task.
+     *
+     * @param player_id Registered player ID
+     * @param kind Message kind
+     * @param data Payload
+     * @param len Payload length (1 to ESPNOW_RELIABLE_MAX_LEN)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t espnow_reliable_send(uint8_t player_id, espnow_reliable_kind_t kind, const void *data, size_t len);
+
+    /**
+     * @brief Drop everything queued for a player, e.g. when it leaves
+     *
+     * @param player_id Player ID
+     */
+    void espnow_reliable_forget(uint8_t player_id);
+
+    /**
+     * @brief Process a send completion and start the next due transmission
+     *
+     * Called by the worker task whenever it wakes up.
+     *
+     * @param now_us Current esp_timer time
+     * @return esp_timer time by which it must be called again, INT64_MAX if idle
+     */
+    int64_t espnow_reliable_service(int64_t now_us);
+
+    /**
+     * @brief Get the delivery counters
+     *
+     * @param out_stats Pointer to store the counters
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid pointer
+     */
+    esp_err_t espnow_reliable_get_stats(espnow_reliable_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESPNOW_RELIABLE_H
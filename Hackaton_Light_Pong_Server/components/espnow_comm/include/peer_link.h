@@ -0,0 +1,103 @@
+/**
+ * @file peer_link.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Per-player sequence tracking, duplicate suppression and link statistics
+ *
+ * Paddles number their inputs and retransmit them, so the same input can
+ * arrive twice and inputs can overtake each other. For every player a sliding
+ * window over the last PEER_LINK_WINDOW sequence numbers (a 64-bit bitmap
+ * anchored at the newest) tells new inputs from duplicates and late ones in
+ * constant time. Numbers that leave the window without having arrived count
+ * as lost. Together with the RSSI of every packet this gives a per-player
+ * link quality.
+ */
+
+#ifndef PEER_LINK_H
+#define PEER_LINK_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PEER_LINK_WINDOW 64 // Sequence numbers tracked behind the newest
+
+    /**
+     * @brief Verdict on a numbered packet
+     */
+    typedef enum
+    {
+        PEER_LINK_NEW = 0,   ///< Newer than anything seen, process it
+        PEER_LINK_DUPLICATE, ///< Already seen, drop it
+        PEER_LINK_LATE,      ///< Missing until now but older than the newest, drop it
+        PEER_LINK_STALE,     ///< Older than the window, drop it
+    } peer_link_verdict_t;
+
+    /**
+     * @brief Link statistics of one player
+     */
+    typedef struct
+    {
+        uint32_t packets;    ///< All packets, numbered or not
+        uint32_t accepted;   ///< Numbered packets processed (PEER_LINK_NEW)
+        uint32_t duplicates; ///< Numbered packets seen before
+        uint32_t late;       ///< Numbered packets arriving after a newer one
+        uint32_t stale;      ///< Numbered packets older than the window
+        uint32_t lost;       ///< Sequence numbers that never arrived
+        uint8_t loss_pct;    ///< Recent loss, averaged over roughly the last 16 numbers
+        uint8_t quality;     ///< 0-100 from recent loss and average RSSI
+        int8_t rssi_last;    ///< RSSI of the last packet in dBm
+        int8_t rssi_avg;     ///< Average RSSI in dBm
+        int8_t rssi_min;     ///< Weakest RSSI in dBm
+        int64_t last_rx_us;  ///< esp_timer time of the last packet
+    } peer_link_stats_t;
+
+    /**
+     * @brief Forget a player's sequence window and statistics
+     *
+     * Call when a player (re)registers, so a rebooted paddle starting its
+     * numbering again is not taken for a replay.
+     *
+     * @param player_id Player ID (1 to PLAYER_REGISTRY_MAX_PLAYERS)
+     */
+    void peer_link_reset(uint8_t player_id);
+
+    /**
+     * @brief Account any packet of a player
+     *
+     * @param player_id Player ID
+     * @param rssi RSSI in dBm
+     * @param rx_us esp_timer time of reception
+     */
+    void peer_link_packet(uint8_t player_id, int8_t rssi, int64_t rx_us);
+
+    /**
+     * @brief Classify a numbered packet and move the window
+     *
+     * @param player_id Player ID
+     * @param seq Sequence number
+     * @param seq_bits Width of the sequence number on the wire (16 or 32), wraps are handled
+     * @return Verdict; PEER_LINK_NEW for an unknown player
+     */
+    peer_link_verdict_t peer_link_check(uint8_t player_id, uint32_t seq, uint8_t seq_bits);
+
+    /**
+     * @brief Get the link statistics of a player
+     *
+     * @param player_id Player ID
+     * @param out_stats Pointer to store the statistics
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid player ID or pointer
+     */
+    esp_err_t peer_link_get_stats(uint8_t player_id, peer_link_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PEER_LINK_H
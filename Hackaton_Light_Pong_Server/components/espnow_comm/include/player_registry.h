@@ -0,0 +1,169 @@
+/**
+ * @file player_registry.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Registry of connected paddles with hashed MAC lookup and roles
+ *
+ * Players occupy numbered slots; a freed slot is reused by the next paddle
+ * that registers, so player IDs stay small. MAC addresses are looked up
+ * through an open addressing hash index in constant time. Each player has a
+ * role deciding which side of the field its hits count for; several players
+ * can share a role for team play, and roles can be reassigned between games.
+ * Paddles that send heartbeats expire when they fall silent; paddles that
+ * never sent one stay registered.
+ */
+
+#ifndef PLAYER_REGISTRY_H
+#define PLAYER_REGISTRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_now.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ESP-NOW's peer table minus the broadcast peer, which holds one entry for the
+// whole run: player IDs 1 to 19
+#define PLAYER_REGISTRY_MAX_PLAYERS (ESP_NOW_MAX_TOTAL_PEER_NUM - 1)
+
+    /**
+     * @brief Side of the field a player's hits count for
+     */
+    typedef enum
+    {
+        PLAYER_ROLE_NONE = 0, ///< Registered but not playing (waiting for a match)
+        PLAYER_ROLE_TOP,      ///< Hits raise PADDLE_TOP_HIT
+        PLAYER_ROLE_BOTTOM,   ///< Hits raise PADDLE_BOTTOM_HIT
+        PLAYER_ROLE_COUNT
+    } player_role_t;
+
+    /**
+     * @brief Role given to newly registered players
+     */
+    typedef enum
+    {
+        PLAYER_ROLES_DUEL = 0, ///< Player 1 top, player 2 bottom, everyone else none
+        PLAYER_ROLES_TEAMS,    ///< Odd player IDs top, even player IDs bottom
+        PLAYER_ROLES_MANUAL,   ///< None until set with player_registry_set_role()
+    } player_role_policy_t;
+
+    /**
+     * @brief Snapshot of one player
+     */
+    typedef struct
+    {
+        uint8_t player_id;    ///< Player ID (1 to PLAYER_REGISTRY_MAX_PLAYERS)
+        uint8_t mac[6];       ///< Paddle MAC address
+        player_role_t role;   ///< Current role
+        int64_t last_seen_us; ///< esp_timer time of the last packet
+        bool heartbeat;       ///< Paddle sends heartbeats and can expire
+    } player_info_t;
+
+    /**
+     * @brief Register a paddle in the lowest free slot
+     *
+     * @param mac Paddle MAC address
+     * @param now_us Current esp_timer time
+     * @param out_id Pointer to store the player ID, also set if already registered
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_INVALID_STATE: Already registered
+     *      - ESP_ERR_NO_MEM: All slots taken
+     */
+    esp_err_t player_registry_add(const uint8_t mac[6], int64_t now_us, uint8_t *out_id);
+
+    /**
+     * @brief Free a player's slot
+     *
+     * @param player_id Player ID
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_NOT_FOUND: No such player
+     */
+    esp_err_t player_registry_remove(uint8_t player_id);
+
+    /**
+     * @brief Look up a paddle
+     *
+     * @param mac Paddle MAC address
+     * @return Player ID, or 0 if not registered
+     */
+    uint8_t player_registry_find(const uint8_t mac[6]);
+
+    /**
+     * @brief Record that a packet of a player arrived
+     *
+     * @param player_id Player ID
+     * @param now_us Current esp_timer time
+     * @param heartbeat The packet was a heartbeat, enabling expiry for this player
+     */
+    void player_registry_touch(uint8_t player_id, int64_t now_us, bool heartbeat);
+
+    /**
+     * @brief Remove heartbeat sending players that have been silent too long
+     *
+     * @param now_us Current esp_timer time
+     * @param timeout_ms Silence after which a player expires
+     * @param out_expired Array receiving the expired players (may be NULL)
+     * @param max_expired Size of out_expired
+     * @return Number of players removed
+     */
+    uint8_t player_registry_expire(int64_t now_us, uint32_t timeout_ms, player_info_t *out_expired,
+                                   uint8_t max_expired);
+
+    /**
+     * @brief Get a snapshot of a player
+     *
+     * @param player_id Player ID
+     * @param out_info Pointer to store the snapshot
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid pointer
+     *      - ESP_ERR_NOT_FOUND: No such player
+     */
+    esp_err_t player_registry_get(uint8_t player_id, player_info_t *out_info);
+
+    /**
+     * @brief Get a player's role
+     *
+     * @param player_id Player ID
+     * @return Role, PLAYER_ROLE_NONE if not registered
+     */
+    player_role_t player_registry_get_role(uint8_t player_id);
+
+    /**
+     * @brief Assign a player's role, e.g. for the next match of a tournament
+     *
+     * @param player_id Player ID
+     * @param role New role
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid role
+     *      - ESP_ERR_NOT_FOUND: No such player
+     */
+    esp_err_t player_registry_set_role(uint8_t player_id, player_role_t role);
+
+    /**
+     * @brief Choose the role given to players registering from now on
+     *
+     * @param policy Role policy
+     */
+    void player_registry_set_policy(player_role_policy_t policy);
+
+    /**
+     * @brief Get the number of registered players
+     *
+     * @return Number of players
+     */
+    uint8_t player_registry_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PLAYER_REGISTRY_H
@@ -0,0 +1,209 @@
+/**
+ * @file peer_link.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Per-player sequence tracking and link statistics implementation
+ */
+
+#include "peer_link.h"
+#include "player_registry.h"
+#include <stdbool.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+
+#define PEER_LINK_RESYNC_STALE 4  // Stale packets in a row that restart the window (paddle rebooted)
+#define PEER_LINK_LOSS_SHIFT 4    // Recent loss averages over about 2^4 sequence numbers
+#define PEER_LINK_LOSS_GAP_MAX 32 // Gap beyond which the recent loss is saturated anyway
+#define PEER_LINK_RSSI_GOOD -60   // RSSI at and above which the quality is not reduced
+#define PEER_LINK_RSSI_BAD -90    // RSSI at and below which the quality is 0
+
+/**
+ * @brief Sequence window and statistics of one player
+ */
+typedef struct
+{
+    bool seq_valid;
+    bool rssi_valid;
+    uint8_t stale_run;
+    uint32_t top;      // Newest sequence number, widened to 32 bits
+    uint64_t seen;     // Bit n set: top - n has arrived
+    uint32_t loss_q16; // Recent loss, 65536 = everything lost
+    int16_t rssi_q4;   // Average RSSI in 1/16 dBm
+    peer_link_stats_t stats;
+} peer_link_t;
+
+static portMUX_TYPE peer_link_lock = portMUX_INITIALIZER_UNLOCKED;
+static peer_link_t links[PLAYER_REGISTRY_MAX_PLAYERS];
+
+static inline bool peer_link_valid_id(uint8_t player_id)
+{
+    return player_id >= 1 && player_id <= PLAYER_REGISTRY_MAX_PLAYERS;
+}
+
+/**
+ * @brief Feed one sequence number into the recent loss average
+ */
+static inline void peer_link_loss_sample(peer_link_t *link, bool lost)
+{
+    link->loss_q16 -= link->loss_q16 >> PEER_LINK_LOSS_SHIFT;
+    if (lost)
+    {
+        link->loss_q16 += 65536 >> PEER_LINK_LOSS_SHIFT;
+    }
+}
+
+void peer_link_reset(uint8_t player_id)
+{
+    if (!peer_link_valid_id(player_id))
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&peer_link_lock);
+    memset(&links[player_id - 1], 0, sizeof(peer_link_t));
+    portEXIT_CRITICAL(&peer_link_lock);
+}
+
+void peer_link_packet(uint8_t player_id, int8_t rssi, int64_t rx_us)
+{
+    if (!peer_link_valid_id(player_id))
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&peer_link_lock);
+    peer_link_t *link = &links[player_id - 1];
+    link->stats.packets++;
+    link->stats.last_rx_us = rx_us;
+    link->stats.rssi_last = rssi;
+    if (!link->rssi_valid)
+    {
+        link->rssi_valid = true;
+        link->rssi_q4 = rssi * 16;
+        link->stats.rssi_min = rssi;
+    }
+    else
+    {
+        link->rssi_q4 += (rssi * 16 - link->rssi_q4) / 8;
+        if (rssi < link->stats.rssi_min)
+        {
+            link->stats.rssi_min = rssi;
+        }
+    }
+    portEXIT_CRITICAL(&peer_link_lock);
+}
+
+peer_link_verdict_t peer_link_check(uint8_t player_id, uint32_t seq, uint8_t seq_bits)
+{
+    if (!peer_link_valid_id(player_id))
+    {
+        return PEER_LINK_NEW;
+    }
+
+    peer_link_verdict_t verdict;
+
+    portENTER_CRITICAL(&peer_link_lock);
+    peer_link_t *link = &links[player_id - 1];
+
+    // Distance from the newest, in the wire width so wraps look like small steps
+    int32_t diff = (seq_bits == 16) ? (int16_t)(uint16_t)(seq - link->top) : (int32_t)(seq - link->top);
+
+    if (link->seq_valid && diff < 0 && -(int64_t)diff >= PEER_LINK_WINDOW &&
+        ++link->stale_run >= PEER_LINK_RESYNC_STALE)
+    {
+        // Numbering restarted without a new HELLO
+        link->seq_valid = false;
+    }
+
+    if (!link->seq_valid)
+    {
+        // Numbers before the first one were never expected
+        link->seq_valid = true;
+        link->top = seq;
+        link->seen = ~0ULL;
+        link->stale_run = 0;
+        link->stats.accepted++;
+        peer_link_loss_sample(link, false);
+        verdict = PEER_LINK_NEW;
+    }
+    else if (diff > 0)
+    {
+        // Numbers shifted out of the window without having arrived are lost
+        if (diff < PEER_LINK_WINDOW)
+        {
+            uint64_t leaving = ~0ULL << (PEER_LINK_WINDOW - diff);
+            link->stats.lost += __builtin_popcountll(~link->seen & leaving);
+            link->seen = (link->seen << diff) | 1;
+        }
+        else
+        {
+            link->stats.lost += (PEER_LINK_WINDOW - __builtin_popcountll(link->seen)) + (diff - PEER_LINK_WINDOW);
+            link->seen = 1;
+        }
+
+        // The recent average counts a gap when it opens; late arrivals pull it back
+        int32_t gap = (diff - 1 < PEER_LINK_LOSS_GAP_MAX) ? diff - 1 : PEER_LINK_LOSS_GAP_MAX;
+        for (int32_t i = 0; i < gap; i++)
+        {
+            peer_link_loss_sample(link, true);
+        }
+        peer_link_loss_sample(link, false);
+
+        link->top += diff;
+        link->stale_run = 0;
+        link->stats.accepted++;
+        verdict = PEER_LINK_NEW;
+    }
+    else if (diff == 0 || (diff > -PEER_LINK_WINDOW && (link->seen & (1ULL << -diff))))
+    {
+        link->stats.duplicates++;
+        verdict = PEER_LINK_DUPLICATE;
+    }
+    else if (diff > -PEER_LINK_WINDOW)
+    {
+        link->seen |= 1ULL << -diff;
+        link->stale_run = 0;
+        link->stats.late++;
+        peer_link_loss_sample(link, false);
+        verdict = PEER_LINK_LATE;
+    }
+    else
+    {
+        link->stats.stale++;
+        verdict = PEER_LINK_STALE;
+    }
+    portEXIT_CRITICAL(&peer_link_lock);
+
+    return verdict;
+}
+
+esp_err_t peer_link_get_stats(uint8_t player_id, peer_link_stats_t *out_stats)
+{
+    if (!peer_link_valid_id(player_id) || out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&peer_link_lock);
+    const peer_link_t *link = &links[player_id - 1];
+    *out_stats = link->stats;
+    uint32_t loss_q16 = link->loss_q16;
+    bool rssi_valid = link->rssi_valid;
+    int16_t rssi_q4 = link->rssi_q4;
+    portEXIT_CRITICAL(&peer_link_lock);
+
+    out_stats->loss_pct = (uint8_t)((loss_q16 * 100 + 32768) >> 16);
+    out_stats->rssi_avg = rssi_valid ? (int8_t)(rssi_q4 / 16) : 0;
+
+    // Quality: share of inputs arriving, scaled down as the signal weakens
+    int32_t signal = 100;
+    if (rssi_valid)
+    {
+        signal = (out_stats->rssi_avg - PEER_LINK_RSSI_BAD) * 100 / (PEER_LINK_RSSI_GOOD - PEER_LINK_RSSI_BAD);
+        signal = (signal < 0) ? 0 : (signal > 100) ? 100
+                                                   : signal;
+    }
+    out_stats->quality = (uint8_t)((100 - out_stats->loss_pct) * signal / 100);
+
+    return ESP_OK;
+}
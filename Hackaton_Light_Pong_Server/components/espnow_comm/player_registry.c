@@ -0,0 +1,319 @@
+/**
+ * @file player_registry.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Registry of connected paddles implementation
+ */
+
+#include "player_registry.h"
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+
+// Hash index size, a power of two keeping the load factor at or below 5/8
+#define PLAYER_INDEX_SIZE 32
+#define PLAYER_INDEX_MASK (PLAYER_INDEX_SIZE - 1)
+
+/**
+ * @brief One player slot
+ */
+typedef struct
+{
+    bool in_use;
+    bool heartbeat;
+    uint8_t mac[6];
+    player_role_t role;
+    int64_t last_seen_us;
+} player_slot_t;
+
+/**
+ * @brief Registry state, shared by the receiver and game tasks under lock
+ */
+typedef struct
+{
+    portMUX_TYPE lock;
+    player_slot_t slots[PLAYER_REGISTRY_MAX_PLAYERS];
+    uint8_t index[PLAYER_INDEX_SIZE]; // Slot number + 1, 0 for an empty bucket
+    uint8_t count;
+    player_role_policy_t policy;
+} player_registry_t;
+
+static player_registry_t registry = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+    .policy = PLAYER_ROLES_DUEL,
+};
+
+/**
+ * @brief FNV-1a of a MAC address, folded to a bucket
+ */
+static uint32_t player_hash(const uint8_t mac[6])
+{
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < 6; i++)
+    {
+        h = (h ^ mac[i]) * 16777619u;
+    }
+    return (h ^ (h >> 16)) & PLAYER_INDEX_MASK;
+}
+
+/**
+ * @brief Bucket holding a MAC, or the empty bucket ending its probe sequence (lock held)
+ */
+static uint32_t player_index_probe(const uint8_t mac[6])
+{
+    uint32_t bucket = player_hash(mac);
+    while (registry.index[bucket] != 0 &&
+           memcmp(registry.slots[registry.index[bucket] - 1].mac, mac, 6) != 0)
+    {
+        bucket = (bucket + 1) & PLAYER_INDEX_MASK;
+    }
+    return bucket;
+}
+
+/**
+ * @brief Remove a bucket, shifting later entries of the probe sequence back (lock held)
+ */
+static void player_index_delete(uint32_t hole)
+{
+    uint32_t bucket = hole;
+
+    registry.index[hole] = 0;
+    while (true)
+    {
+        bucket = (bucket + 1) & PLAYER_INDEX_MASK;
+        if (registry.index[bucket] == 0)
+        {
+            return;
+        }
+
+        // Move the entry into the hole unless its home bucket lies between the two
+        uint32_t home = player_hash(registry.slots[registry.index[bucket] - 1].mac);
+        if (((bucket - home) & PLAYER_INDEX_MASK) >= ((bucket - hole) & PLAYER_INDEX_MASK))
+        {
+            registry.index[hole] = registry.index[bucket];
+            registry.index[bucket] = 0;
+            hole = bucket;
+        }
+    }
+}
+
+/**
+ * @brief Role of a new player under the current policy
+ */
+static player_role_t player_default_role(uint8_t player_id)
+{
+    switch (registry.policy)
+    {
+    case PLAYER_ROLES_DUEL:
+        return (player_id == 1) ? PLAYER_ROLE_TOP : (player_id == 2) ? PLAYER_ROLE_BOTTOM
+                                                                     : PLAYER_ROLE_NONE;
+    case PLAYER_ROLES_TEAMS:
+        return (player_id & 1) ? PLAYER_ROLE_TOP : PLAYER_ROLE_BOTTOM;
+    default:
+        return PLAYER_ROLE_NONE;
+    }
+}
+
+/**
+ * @brief Free a slot and its bucket (lock held)
+ */
+static void player_release(uint8_t slot)
+{
+    player_index_delete(player_index_probe(registry.slots[slot].mac));
+    registry.slots[slot].in_use = false;
+    registry.count--;
+}
+
+esp_err_t player_registry_add(const uint8_t mac[6], int64_t now_us, uint8_t *out_id)
+{
+    if (mac == NULL || out_id == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL(&registry.lock);
+    uint32_t bucket = player_index_probe(mac);
+    if (registry.index[bucket] != 0)
+    {
+        *out_id = registry.index[bucket];
+        ret = ESP_ERR_INVALID_STATE;
+    }
+    else if (registry.count >= PLAYER_REGISTRY_MAX_PLAYERS)
+    {
+        ret = ESP_ERR_NO_MEM;
+    }
+    else
+    {
+        uint8_t slot = 0;
+        while (registry.slots[slot].in_use)
+        {
+            slot++;
+        }
+
+        player_slot_t *player = &registry.slots[slot];
+        memcpy(player->mac, mac, 6);
+        player->in_use = true;
+        player->heartbeat = false;
+        player->last_seen_us = now_us;
+        player->role = player_default_role(slot + 1);
+        registry.index[bucket] = slot + 1;
+        registry.count++;
+        *out_id = slot + 1;
+    }
+    portEXIT_CRITICAL(&registry.lock);
+
+    return ret;
+}
+
+esp_err_t player_registry_remove(uint8_t player_id)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    portENTER_CRITICAL(&registry.lock);
+    if (player_id >= 1 && player_id <= PLAYER_REGISTRY_MAX_PLAYERS && registry.slots[player_id - 1].in_use)
+    {
+        player_release(player_id - 1);
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&registry.lock);
+
+    return ret;
+}
+
+uint8_t player_registry_find(const uint8_t mac[6])
+{
+    if (mac == NULL)
+    {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&registry.lock);
+    uint8_t player_id = registry.index[player_index_probe(mac)];
+    portEXIT_CRITICAL(&registry.lock);
+
+    return player_id;
+}
+
+void player_registry_touch(uint8_t player_id, int64_t now_us, bool heartbeat)
+{
+    if (player_id < 1 || player_id > PLAYER_REGISTRY_MAX_PLAYERS)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&registry.lock);
+    player_slot_t *player = &registry.slots[player_id - 1];
+    if (player->in_use)
+    {
+        player->last_seen_us = now_us;
+        player->heartbeat |= heartbeat;
+    }
+    portEXIT_CRITICAL(&registry.lock);
+}
+
+uint8_t player_registry_expire(int64_t now_us, uint32_t timeout_ms, player_info_t *out_expired,
+                               uint8_t max_expired)
+{
+    uint8_t expired = 0;
+
+    portENTER_CRITICAL(&registry.lock);
+    for (uint8_t slot = 0; slot < PLAYER_REGISTRY_MAX_PLAYERS; slot++)
+    {
+        player_slot_t *player = &registry.slots[slot];
+        if (!player->in_use || !player->heartbeat || now_us - player->last_seen_us < (int64_t)timeout_ms * 1000)
+        {
+            continue;
+        }
+        if (out_expired != NULL)
+        {
+            // Leave the rest for the next sweep rather than dropping them unreported
+            if (expired >= max_expired)
+            {
+                break;
+            }
+            out_expired[expired] = (player_info_t){
+                .player_id = slot + 1,
+                .role = player->role,
+                .last_seen_us = player->last_seen_us,
+                .heartbeat = true};
+            memcpy(out_expired[expired].mac, player->mac, 6);
+        }
+        player_release(slot);
+        expired++;
+    }
+    portEXIT_CRITICAL(&registry.lock);
+
+    return expired;
+}
+
+esp_err_t player_registry_get(uint8_t player_id, player_info_t *out_info)
+{
+    if (out_info == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    portENTER_CRITICAL(&registry.lock);
+    if (player_id >= 1 && player_id <= PLAYER_REGISTRY_MAX_PLAYERS && registry.slots[player_id - 1].in_use)
+    {
+        const player_slot_t *player = &registry.slots[player_id - 1];
+        out_info->player_id = player_id;
+        memcpy(out_info->mac, player->mac, 6);
+        out_info->role = player->role;
+        out_info->last_seen_us = player->last_seen_us;
+        out_info->heartbeat = player->heartbeat;
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&registry.lock);
+
+    return ret;
+}
+
+player_role_t player_registry_get_role(uint8_t player_id)
+{
+    player_role_t role = PLAYER_ROLE_NONE;
+
+    portENTER_CRITICAL(&registry.lock);
+    if (player_id >= 1 && player_id <= PLAYER_REGISTRY_MAX_PLAYERS && registry.slots[player_id - 1].in_use)
+    {
+        role = registry.slots[player_id - 1].role;
+    }
+    portEXIT_CRITICAL(&registry.lock);
+
+    return role;
+}
+
+esp_err_t player_registry_set_role(uint8_t player_id, player_role_t role)
+{
+    if (role >= PLAYER_ROLE_COUNT)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    portENTER_CRITICAL(&registry.lock);
+    if (player_id >= 1 && player_id <= PLAYER_REGISTRY_MAX_PLAYERS && registry.slots[player_id - 1].in_use)
+    {
+        registry.slots[player_id - 1].role = role;
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&registry.lock);
+
+    return ret;
+}
+
+void player_registry_set_policy(player_role_policy_t policy)
+{
+    portENTER_CRITICAL(&registry.lock);
+    registry.policy = policy;
+    portEXIT_CRITICAL(&registry.lock);
+}
+
+uint8_t player_registry_count(void)
+{
+    return registry.count;
+}
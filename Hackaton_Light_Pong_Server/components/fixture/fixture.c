@@ -0,0 +1,502 @@
+/**
+ * @file fixture.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Profile driven DMX fixture control implementation
+ */
+
+#include "fixture.h"
+#include "fixture_priv.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+
+static const char *TAG = "FIXTURE";
+
+/**
+ * @brief Check that every mapped attribute lies inside the footprint
+ */
+static bool fixture_profile_valid(const fixture_profile_t *profile)
+{
+    if (profile->footprint == 0 || profile->footprint > FIXTURE_MAX_FOOTPRINT)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < FIXTURE_ATTR_COUNT; i++)
+    {
+        const fixture_attr_def_t *def = &profile->attrs[i];
+        if (!(def->flags & FIXTURE_ATTR_F_PRESENT))
+        {
+            continue;
+        }
+
+        bool wide = (def->flags & FIXTURE_ATTR_F_16BIT) != 0;
+        if (def->offset >= profile->footprint ||
+            (wide && def->fine_offset >= profile->footprint) ||
+            (!wide && def->max > 255) ||
+            def->min > def->max || def->default_value < def->min || def->default_value > def->max)
+        {
+            ESP_LOGE(TAG, "Profile '%s': invalid attribute %d", profile->name, i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const fixture_attr_def_t *fixture_lookup(const fixture_context_t *ctx, fixture_attr_t attr)
+{
+    if ((unsigned)attr >= FIXTURE_ATTR_COUNT)
+    {
+        return NULL;
+    }
+
+    const fixture_attr_def_t *def = &ctx->profile->attrs[attr];
+    return (def->flags & FIXTURE_ATTR_F_PRESENT) ? def : NULL;
+}
+
+/**
+ * @brief Store one channel in the shadow state and emit it unless the layer already holds it
+ *
+ * Called with the shadow lock held. An emitted channel stays invalid until
+ * fixture_write_end() confirms that its write landed.
+ */
+static uint8_t fixture_encode_channel(fixture_context_t *ctx, uint8_t offset, uint8_t value,
+                                      dmx_channel_value_t *pair)
+{
+    const uint32_t bit = 1UL << offset;
+
+    if ((ctx->valid & bit) && ctx->channels[offset] == value)
+    {
+        atomic_fetch_add(&ctx->suppressed, 1);
+        return 0;
+    }
+
+    ctx->channels[offset] = value;
+    ctx->valid &= ~bit;
+    atomic_fetch_add(&ctx->applied, 1);
+    *pair = (dmx_channel_value_t){ctx->start_channel + offset, value};
+    return 1;
+}
+
+/**
+ * @brief fixture_encode() with the shadow lock already held
+ */
+static uint8_t fixture_encode_locked(fixture_context_t *ctx, const fixture_attr_def_t *def, uint16_t value,
+                                     dmx_channel_value_t *pairs)
+{
+    if (value < def->min)
+    {
+        value = def->min;
+    }
+    else if (value > def->max)
+    {
+        value = def->max;
+    }
+
+    if (def->flags & FIXTURE_ATTR_F_16BIT)
+    {
+        uint8_t count = fixture_encode_channel(ctx, def->offset, (uint8_t)(value >> 8), pairs);
+        return count + fixture_encode_channel(ctx, def->fine_offset, (uint8_t)value, &pairs[count]);
+    }
+
+    return fixture_encode_channel(ctx, def->offset, (uint8_t)value, pairs);
+}
+
+uint8_t fixture_encode(fixture_context_t *ctx, const fixture_attr_def_t *def, uint16_t value,
+                       dmx_channel_value_t *pairs)
+{
+    portENTER_CRITICAL(&ctx->shadow_lock);
+    uint8_t count = fixture_encode_locked(ctx, def, value, pairs);
+    portEXIT_CRITICAL(&ctx->shadow_lock);
+    return count;
+}
+
+/**
+ * @brief fixture_clear_valid() with the shadow lock already held
+ */
+static void fixture_clear_valid_locked(fixture_context_t *ctx, uint32_t mask)
+{
+    ctx->valid &= ~mask;
+    if (ctx->writers > 0)
+    {
+        // A write in flight must not mark these channels valid again
+        ctx->contended = true;
+    }
+}
+
+/**
+ * @brief Clear the valid bits in mask so the next writes of those channels go out
+ */
+static void fixture_clear_valid(fixture_context_t *ctx, uint32_t mask)
+{
+    portENTER_CRITICAL(&ctx->shadow_lock);
+    fixture_clear_valid_locked(ctx, mask);
+    portEXIT_CRITICAL(&ctx->shadow_lock);
+}
+
+void fixture_write_begin(fixture_context_t *ctx)
+{
+    portENTER_CRITICAL(&ctx->shadow_lock);
+    if (ctx->writers++ > 0)
+    {
+        ctx->contended = true;
+    }
+    portEXIT_CRITICAL(&ctx->shadow_lock);
+}
+
+/**
+ * @brief Close a write and mark the channels in mask valid if it had the fixture to itself
+ */
+static void fixture_write_finish(fixture_context_t *ctx, uint32_t mask, bool written)
+{
+    portENTER_CRITICAL(&ctx->shadow_lock);
+    // Overlapping writes may have landed in any order, so none of them knows
+    // what the layer holds; their channels stay invalid and go out next time
+    if (written && !ctx->contended)
+    {
+        ctx->valid |= mask;
+    }
+    if (--ctx->writers == 0)
+    {
+        ctx->contended = false;
+    }
+    portEXIT_CRITICAL(&ctx->shadow_lock);
+}
+
+void fixture_write_end(fixture_context_t *ctx, const dmx_channel_value_t *pairs, uint16_t count,
+                       bool written)
+{
+    uint32_t mask = 0;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        mask |= 1UL << (pairs[i].channel - ctx->start_channel);
+    }
+    fixture_write_finish(ctx, mask, written);
+}
+
+esp_err_t fixture_write_pairs(fixture_context_t *ctx, const dmx_channel_value_t *pairs, uint16_t count)
+{
+    if (count == 0)
+    {
+        return ESP_OK;
+    }
+
+    if (count == 1)
+    {
+        return (ctx->source != NULL) ? dmx_source_set_channel(ctx->source, pairs[0].channel, pairs[0].value)
+                                     : dmx_set_channel(ctx->dmx_handle, pairs[0].channel, pairs[0].value);
+    }
+
+    return (ctx->source != NULL) ? dmx_source_set_channels_sparse(ctx->source, pairs, count)
+                                 : dmx_set_channels_sparse(ctx->dmx_handle, pairs, count);
+}
+
+/**
+ * @brief Bit mask covering every channel of the footprint
+ */
+static uint32_t fixture_footprint_mask(const fixture_context_t *ctx)
+{
+    return (ctx->profile->footprint >= 32) ? UINT32_MAX : ((1UL << ctx->profile->footprint) - 1);
+}
+
+/**
+ * @brief Write the profile defaults to all channels of the footprint
+ */
+static esp_err_t fixture_write_defaults(fixture_context_t *ctx)
+{
+    dmx_channel_value_t pairs[2];
+    uint8_t values[FIXTURE_MAX_FOOTPRINT];
+
+    fixture_write_begin(ctx);
+
+    portENTER_CRITICAL(&ctx->shadow_lock);
+    memset(ctx->channels, 0, sizeof(ctx->channels));
+    ctx->valid = 0;
+    for (int i = 0; i < FIXTURE_ATTR_COUNT; i++)
+    {
+        const fixture_attr_def_t *def = &ctx->profile->attrs[i];
+        if (def->flags & FIXTURE_ATTR_F_PRESENT)
+        {
+            fixture_encode_locked(ctx, def, def->default_value, pairs);
+        }
+    }
+    memcpy(values, ctx->channels, ctx->profile->footprint);
+    portEXIT_CRITICAL(&ctx->shadow_lock);
+
+    esp_err_t ret = dmx_set_channels(ctx->dmx_handle, ctx->start_channel, values, ctx->profile->footprint);
+    fixture_write_finish(ctx, fixture_footprint_mask(ctx), ret == ESP_OK);
+    return ret;
+}
+
+esp_err_t fixture_init(const fixture_config_t *config, fixture_handle_t *out_handle)
+{
+    if (config == NULL || out_handle == NULL || config->dmx_handle == NULL || config->profile == NULL)
+    {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!fixture_profile_valid(config->profile))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (config->start_channel == 0 ||
+        config->start_channel > (DMX_UNIVERSE_SIZE - config->profile->footprint + 1))
+    {
+        ESP_LOGE(TAG, "Invalid start channel: %d", config->start_channel);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)calloc(1, sizeof(fixture_context_t));
+    if (ctx == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate context");
+        return ESP_ERR_NO_MEM;
+    }
+
+    ctx->shadow_lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    ctx->dmx_handle = config->dmx_handle;
+    ctx->source = config->source;
+    ctx->profile = config->profile;
+    ctx->start_channel = config->start_channel;
+
+    // A merge source starts without owning any channel so it does not
+    // override other sources until it actually sets something
+    if (ctx->source == NULL)
+    {
+        esp_err_t ret = fixture_write_defaults(ctx);
+        if (ret != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to write defaults: %s", esp_err_to_name(ret));
+            free(ctx);
+            return ret;
+        }
+    }
+
+    *out_handle = (fixture_handle_t)ctx;
+
+    ESP_LOGI(TAG, "%s initialized: DMX channels %d-%d", ctx->profile->name,
+             ctx->start_channel, ctx->start_channel + ctx->profile->footprint - 1);
+
+    return ESP_OK;
+}
+
+esp_err_t fixture_deinit(fixture_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+
+    if (ctx->source != NULL)
+    {
+        fixture_release(handle);
+    }
+    else
+    {
+        fixture_write_defaults(ctx);
+    }
+
+    free(ctx);
+    return ESP_OK;
+}
+
+esp_err_t fixture_set_attr(fixture_handle_t handle, fixture_attr_t attr, uint16_t value)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+    const fixture_attr_def_t *def = fixture_lookup(ctx, attr);
+    if (def == NULL)
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    dmx_channel_value_t pairs[2];
+    fixture_write_begin(ctx);
+    uint8_t count = fixture_encode(ctx, def, value, pairs);
+    esp_err_t ret = fixture_write_pairs(ctx, pairs, count);
+    fixture_write_end(ctx, pairs, count, ret == ESP_OK);
+
+    return ret;
+}
+
+esp_err_t fixture_set_attrs(fixture_handle_t handle, const fixture_attr_value_t *values, uint8_t count)
+{
+    if (handle == NULL || values == NULL || count > FIXTURE_ATTR_COUNT)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (fixture_lookup(ctx, values[i].attr) == NULL)
+        {
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    dmx_channel_value_t pairs[2 * FIXTURE_ATTR_COUNT];
+    uint16_t pair_count = 0;
+    fixture_write_begin(ctx);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        pair_count += fixture_encode(ctx, fixture_lookup(ctx, values[i].attr), values[i].value,
+                                     &pairs[pair_count]);
+    }
+    esp_err_t ret = fixture_write_pairs(ctx, pairs, pair_count);
+    fixture_write_end(ctx, pairs, pair_count, ret == ESP_OK);
+
+    return ret;
+}
+
+esp_err_t fixture_get_attr(fixture_handle_t handle, fixture_attr_t attr, uint16_t *out_value)
+{
+    if (handle == NULL || out_value == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+    const fixture_attr_def_t *def = fixture_lookup(ctx, attr);
+    if (def == NULL)
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    portENTER_CRITICAL(&ctx->shadow_lock);
+    *out_value = ctx->channels[def->offset];
+    if (def->flags & FIXTURE_ATTR_F_16BIT)
+    {
+        *out_value = (*out_value << 8) | ctx->channels[def->fine_offset];
+    }
+    portEXIT_CRITICAL(&ctx->shadow_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t fixture_fade_attr(fixture_handle_t handle, fixture_attr_t attr, uint8_t value,
+                            uint32_t duration_ms, dmx_fade_curve_t curve)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+    const fixture_attr_def_t *def = fixture_lookup(ctx, attr);
+    if (def == NULL || (def->flags & FIXTURE_ATTR_F_16BIT))
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    if (value < def->min)
+    {
+        value = (uint8_t)def->min;
+    }
+    else if (value > def->max)
+    {
+        value = (uint8_t)def->max;
+    }
+    // The layer only holds the target once the fade is over
+    portENTER_CRITICAL(&ctx->shadow_lock);
+    ctx->channels[def->offset] = value;
+    fixture_clear_valid_locked(ctx, 1UL << def->offset);
+    portEXIT_CRITICAL(&ctx->shadow_lock);
+
+    uint16_t channel = ctx->start_channel + def->offset;
+    if (ctx->source != NULL)
+    {
+        return dmx_source_fade_channel(ctx->source, channel, value, duration_ms, curve);
+    }
+    return dmx_fade_channel(ctx->dmx_handle, channel, value, duration_ms, curve);
+}
+
+esp_err_t fixture_release(fixture_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+
+    if (ctx->source == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Released channels fall back to lower layers; the next write must go out
+    fixture_clear_valid(ctx, UINT32_MAX);
+    return dmx_source_release(ctx->source, ctx->start_channel, ctx->profile->footprint);
+}
+
+esp_err_t fixture_invalidate(fixture_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_clear_valid((fixture_context_t *)handle, UINT32_MAX);
+    return ESP_OK;
+}
+
+esp_err_t fixture_get_write_stats(fixture_handle_t handle, fixture_write_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+    out_stats->applied = atomic_load(&ctx->applied);
+    out_stats->suppressed = atomic_load(&ctx->suppressed);
+    return ESP_OK;
+}
+
+esp_err_t fixture_reset_write_stats(fixture_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+    atomic_store(&ctx->applied, 0);
+    atomic_store(&ctx->suppressed, 0);
+    return ESP_OK;
+}
+
+esp_err_t fixture_get_info(fixture_handle_t handle, const fixture_profile_t **out_profile,
+                           uint16_t *out_start_channel)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)handle;
+
+    if (out_profile != NULL)
+    {
+        *out_profile = ctx->profile;
+    }
+    if (out_start_channel != NULL)
+    {
+        *out_start_channel = ctx->start_channel;
+    }
+
+    return ESP_OK;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file fixture_group.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Fixture group implementation
+ */
+
+#include "fixture_group.h"
+#include "fixture_priv.h"
+#include <stdlib.h>
+#include "esp_log.h"
+
+static const char *TAG = "FIXTURE_GROUP";
+
+/**
+ * @brief Group member
+ */
+typedef struct
+{
+    fixture_context_t *fixture;
+    fixture_group_member_config_t transform;
+    uint16_t first_pair; // This member's pairs in the group's pair buffer, per call
+    uint8_t pair_count;
+} fixture_group_member_t;
+
+/**
+ * @brief Group context
+ */
+struct fixture_group
+{
+    fixture_group_member_t *members;
+    dmx_channel_value_t *pairs; // max_members * FIXTURE_GROUP_MAX_PAIRS, built per call
+    uint16_t count;
+    uint16_t max_members;
+};
+
+/**
+ * @brief Apply a member's mirror and offset to a pan/tilt value
+ */
+static uint16_t fixture_group_transform(const fixture_attr_def_t *def, int32_t offset, bool mirror,
+                                        uint16_t value)
+{
+    int32_t full = (def->flags & FIXTURE_ATTR_F_16BIT) ? 65535 : 255;
+    int32_t v = (value > full) ? full : value;
+
+    if (mirror)
+    {
+        v = full - v;
+    }
+    v += offset;
+
+    if (v < 0)
+    {
+        v = 0;
+    }
+    else if (v > full)
+    {
+        v = full;
+    }
+    return (uint16_t)v;
+}
+
+esp_err_t fixture_group_create(uint16_t max_members, fixture_group_handle_t *out_group)
+{
+    if (out_group == NULL || max_members == 0 || max_members > FIXTURE_GROUP_MAX_MEMBERS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct fixture_group *group = (struct fixture_group *)calloc(1, sizeof(struct fixture_group));
+    if (group != NULL)
+    {
+        group->members = (fixture_group_member_t *)calloc(max_members, sizeof(fixture_group_member_t));
+        group->pairs = (dmx_channel_value_t *)calloc((size_t)max_members * FIXTURE_GROUP_MAX_PAIRS,
+                                                     sizeof(dmx_channel_value_t));
+    }
+    if (group == NULL || group->members == NULL || group->pairs == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate group");
+        fixture_group_delete(group);
+        return ESP_ERR_NO_MEM;
+    }
+
+    group->max_members = max_members;
+    *out_group = group;
+    return ESP_OK;
+}
+
+esp_err_t fixture_group_delete(fixture_group_handle_t group)
+{
+    if (group == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    free(group->members);
+    free(group->pairs);
+    free(group);
+    return ESP_OK;
+}
+
+esp_err_t fixture_group_add(fixture_group_handle_t group, fixture_handle_t fixture,
+                            const fixture_group_member_config_t *config)
+{
+    if (group == NULL || fixture == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)fixture;
+
+    if (group->count > 0)
+    {
+        const fixture_context_t *first = group->members[0].fixture;
+        if (ctx->dmx_handle != first->dmx_handle || ctx->source != first->source)
+        {
+            ESP_LOGE(TAG, "Members must share the DMX handle and merge source");
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    if (group->count >= group->max_members)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    fixture_group_member_t *member = &group->members[group->count++];
+    member->fixture = ctx;
+    if (config != NULL)
+    {
+        member->transform = *config;
+    }
+    else
+    {
+        member->transform = (fixture_group_member_config_t){0};
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t fixture_group_set_attr(fixture_group_handle_t group, fixture_attr_t attr, uint16_t value)
+{
+    const fixture_attr_value_t values[] = {{attr, value}};
+    return fixture_group_set_attrs(group, values, 1);
+}
+
+esp_err_t fixture_group_set_attrs(fixture_group_handle_t group, const fixture_attr_value_t *values,
+                                  uint8_t count)
+{
+    if (group == NULL || values == NULL || count > FIXTURE_ATTR_COUNT)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Check the channel budget of every member before changing any shadow state
+    for (uint16_t m = 0; m < group->count; m++)
+    {
+        uint8_t channels = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            const fixture_attr_def_t *def = fixture_lookup(group->members[m].fixture, values[i].attr);
+            if (def != NULL)
+            {
+                channels += (def->flags & FIXTURE_ATTR_F_16BIT) ? 2 : 1;
+            }
+        }
+        if (channels > FIXTURE_GROUP_MAX_PAIRS)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    uint16_t pair_count = 0;
+    bool supported = false;
+    for (uint16_t m = 0; m < group->count; m++)
+    {
+        fixture_group_member_t *member = &group->members[m];
+        member->first_pair = pair_count;
+        fixture_write_begin(member->fixture);
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            const fixture_attr_def_t *def = fixture_lookup(member->fixture, values[i].attr);
+            if (def == NULL)
+            {
+                continue;
+            }
+            supported = true;
+
+            uint16_t value = values[i].value;
+            if (values[i].attr == FIXTURE_ATTR_PAN)
+            {
+                value = fixture_group_transform(def, member->transform.pan_offset,
+                                                member->transform.mirror_pan, value);
+            }
+            else if (values[i].attr == FIXTURE_ATTR_TILT)
+            {
+                value = fixture_group_transform(def, member->transform.tilt_offset,
+                                                member->transform.mirror_tilt, value);
+            }
+
+            pair_count += fixture_encode(member->fixture, def, value, &group->pairs[pair_count]);
+        }
+        member->pair_count = (uint8_t)(pair_count - member->first_pair);
+    }
+
+    // Every member shares the DMX handle and source of the first one
+    esp_err_t ret = ESP_OK;
+    if (supported)
+    {
+        ret = fixture_write_pairs(group->members[0].fixture, group->pairs, pair_count);
+    }
+    else if (group->count > 0)
+    {
+        ret = ESP_ERR_NOT_SUPPORTED;
+    }
+
+    for (uint16_t m = 0; m < group->count; m++)
+    {
+        fixture_group_member_t *member = &group->members[m];
+        fixture_write_end(member->fixture, &group->pairs[member->first_pair], member->pair_count,
+                          ret == ESP_OK);
+    }
+    return ret;
+}
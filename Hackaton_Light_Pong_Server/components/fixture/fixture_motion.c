@@ -0,0 +1,500 @@
+/**
+ * @file fixture_motion.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Pan/tilt trajectory planner implementation
+ */
+
+#include "fixture_motion.h"
+#include "fixture_priv.h"
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "FIXTURE_MOTION";
+
+#define FIXTURE_MOTION_ONE 32768 // 1.0 in the Q15 phase and curve values
+#define FIXTURE_MOTION_US 1000000ULL
+
+/**
+ * @brief One axis of the running move
+ */
+typedef struct
+{
+    uint16_t from;
+    int32_t delta; // target - from
+    int32_t arc;   // Displacement at the midpoint (FIXTURE_MOTION_ARC)
+} fixture_motion_axis_t;
+
+/**
+ * @brief Planner state; the move is shared with the transmission task under lock
+ */
+struct fixture_motion
+{
+    fixture_context_t *fixture;
+    const fixture_attr_def_t *pan_def;
+    const fixture_attr_def_t *tilt_def;
+    fixture_motion_model_t model;
+    portMUX_TYPE lock;
+    bool moving;
+    uint8_t profile;
+    uint32_t start_us;    // Low 32 bits of esp_timer; differences are wrap-safe
+    uint32_t duration_us;
+    uint64_t recip;       // 2^47 / duration_us, phase = (t * recip) >> 32 in Q15
+    int64_t arrival_us;
+    fixture_motion_axis_t pan;
+    fixture_motion_axis_t tilt;
+};
+
+/**
+ * @brief Integer square root
+ */
+static uint64_t fixture_motion_isqrt(uint64_t value)
+{
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Shortest time one axis can follow the path
+ *
+ * Peak speed and acceleration of each path over duration T:
+ * - linear: d/T, speed steps at the ends
+ * - ease (smoothstep): 1.5 d/T, 6 d/T^2
+ * - arc: (d + 4b)/T, 8 b/T^2 (b = midpoint bulge), speed steps at the ends
+ * A speed step of v makes the head trail by v / 2a once it has caught up.
+ */
+static uint64_t fixture_motion_axis_min_us(uint8_t profile, uint32_t distance, uint32_t bulge,
+                                           uint32_t velocity, uint32_t accel)
+{
+    uint64_t velocity_num2; // 2 * peak speed * T
+    uint64_t accel_num;     // peak acceleration * T^2
+
+    switch (profile)
+    {
+    case FIXTURE_MOTION_EASE:
+        velocity_num2 = 3ULL * distance;
+        accel_num = 6ULL * distance;
+        break;
+
+    case FIXTURE_MOTION_ARC:
+        velocity_num2 = 2ULL * (distance + 4ULL * bulge);
+        accel_num = 8ULL * bulge;
+        break;
+
+    default:
+        velocity_num2 = 2ULL * distance;
+        accel_num = 0;
+        break;
+    }
+
+    uint64_t t_velocity = (velocity_num2 * FIXTURE_MOTION_US) / (2ULL * velocity);
+    uint64_t t_accel = fixture_motion_isqrt((accel_num * FIXTURE_MOTION_US * FIXTURE_MOTION_US) / accel);
+    return (t_velocity > t_accel) ? t_velocity : t_accel;
+}
+
+/**
+ * @brief Time the head trails the setpoints after a move of duration_us
+ */
+static uint64_t fixture_motion_axis_lag_us(uint8_t profile, uint32_t distance, uint32_t bulge,
+                                           uint32_t accel, uint64_t duration_us)
+{
+    if (profile == FIXTURE_MOTION_EASE || duration_us == 0)
+    {
+        return 0;
+    }
+
+    uint64_t step = (profile == FIXTURE_MOTION_ARC) ? distance + 4ULL * bulge : distance;
+    return (step * FIXTURE_MOTION_US * FIXTURE_MOTION_US) / (duration_us * 2ULL * accel);
+}
+
+/**
+ * @brief Position of one axis at phase x (Q15)
+ */
+static uint16_t fixture_motion_axis_at(const fixture_motion_axis_t *axis, uint8_t profile, uint32_t x)
+{
+    uint32_t s = x;
+
+    if (profile == FIXTURE_MOTION_EASE)
+    {
+        // Smoothstep x^2 * (3 - 2x); stays within 32 bits for x <= 1.0
+        uint32_t x2 = (x * x) >> 15;
+        s = (x2 * (3 * FIXTURE_MOTION_ONE - 2 * x)) >> 15;
+    }
+
+    int64_t pos = axis->from + (((int64_t)axis->delta * s) >> 15);
+    if (profile == FIXTURE_MOTION_ARC)
+    {
+        // 4 b x (1 - x): b at the midpoint, 0 at both ends
+        pos += ((int64_t)4 * axis->arc * x * (FIXTURE_MOTION_ONE - x)) >> 30;
+    }
+
+    if (pos < 0)
+    {
+        pos = 0;
+    }
+    else if (pos > 65535)
+    {
+        pos = 65535;
+    }
+    return (uint16_t)pos;
+}
+
+/**
+ * @brief Setpoint of the running move at time now; call with lock held
+ *
+ * @return true once the move's duration has passed
+ */
+static bool fixture_motion_sample(const struct fixture_motion *motion, uint32_t now, uint16_t *pan,
+                                  uint16_t *tilt)
+{
+    // Signed: a move may start after the slot timestamp was taken
+    int32_t elapsed = (int32_t)(now - motion->start_us);
+    bool done = false;
+    uint32_t x;
+
+    if (elapsed <= 0)
+    {
+        x = 0;
+    }
+    else if ((uint32_t)elapsed >= motion->duration_us)
+    {
+        x = FIXTURE_MOTION_ONE;
+        done = true;
+    }
+    else
+    {
+        x = (uint32_t)(((uint64_t)elapsed * motion->recip) >> 32);
+    }
+
+    *pan = fixture_motion_axis_at(&motion->pan, motion->profile, x);
+    *tilt = fixture_motion_axis_at(&motion->tilt, motion->profile, x);
+    return done;
+}
+
+/**
+ * @brief Current setpoint: the running move, otherwise the fixture's last written position
+ */
+static void fixture_motion_current(struct fixture_motion *motion, uint32_t now, uint16_t *pan, uint16_t *tilt)
+{
+    bool moving;
+
+    portENTER_CRITICAL(&motion->lock);
+    moving = motion->moving;
+    if (moving)
+    {
+        fixture_motion_sample(motion, now, pan, tilt);
+    }
+    portEXIT_CRITICAL(&motion->lock);
+
+    if (!moving)
+    {
+        fixture_get_attr((fixture_handle_t)motion->fixture, FIXTURE_ATTR_PAN, pan);
+        fixture_get_attr((fixture_handle_t)motion->fixture, FIXTURE_ATTR_TILT, tilt);
+    }
+}
+
+/**
+ * @brief Frame slot callback: write this slot's setpoint
+ */
+static void fixture_motion_frame(int64_t slot_us, void *user_ctx)
+{
+    struct fixture_motion *motion = (struct fixture_motion *)user_ctx;
+    uint16_t pan;
+    uint16_t tilt;
+
+    portENTER_CRITICAL(&motion->lock);
+    if (!motion->moving)
+    {
+        portEXIT_CRITICAL(&motion->lock);
+        return;
+    }
+    if (fixture_motion_sample(motion, (uint32_t)slot_us, &pan, &tilt))
+    {
+        motion->moving = false;
+    }
+    portEXIT_CRITICAL(&motion->lock);
+
+    // Slow moves keep the same 16-bit value for several frames; the shadow
+    // state then emits no pairs and idle mode is left alone
+    dmx_channel_value_t pairs[4];
+    fixture_write_begin(motion->fixture);
+    uint16_t count = fixture_encode(motion->fixture, motion->pan_def, pan, pairs);
+    count += fixture_encode(motion->fixture, motion->tilt_def, tilt, &pairs[count]);
+    esp_err_t ret = fixture_write_pairs(motion->fixture, pairs, count);
+    fixture_write_end(motion->fixture, pairs, count, ret == ESP_OK);
+}
+
+/**
+ * @brief Check a model for values the planner would divide by
+ */
+static bool fixture_motion_model_valid(const fixture_motion_model_t *model)
+{
+    return model != NULL && model->pan_velocity > 0 && model->tilt_velocity > 0 &&
+           model->pan_accel > 0 && model->tilt_accel > 0;
+}
+
+/**
+ * @brief Check a move request
+ */
+static bool fixture_motion_target_valid(const fixture_motion_target_t *target)
+{
+    return target != NULL && (unsigned)target->profile <= FIXTURE_MOTION_ARC &&
+           target->duration_ms <= FIXTURE_MOTION_MAX_MS &&
+           abs(target->arc_pan) <= 65535 && abs(target->arc_tilt) <= 65535;
+}
+
+/**
+ * @brief Fill the axes of a move from the given start and compute its timing
+ *
+ * @return Setpoint travel time in microseconds; *lag_us receives the extra
+ *         time the head needs (tracking lag plus latency)
+ */
+static uint32_t fixture_motion_prepare(const struct fixture_motion *motion, const fixture_motion_target_t *target,
+                                       uint16_t pan, uint16_t tilt, fixture_motion_axis_t *pan_axis,
+                                       fixture_motion_axis_t *tilt_axis, uint32_t *lag_us)
+{
+    const fixture_motion_model_t *model = &motion->model;
+    uint8_t profile = (uint8_t)target->profile;
+    bool arc = (profile == FIXTURE_MOTION_ARC);
+
+    *pan_axis = (fixture_motion_axis_t){pan, (int32_t)target->pan - pan, arc ? target->arc_pan : 0};
+    *tilt_axis = (fixture_motion_axis_t){tilt, (int32_t)target->tilt - tilt, arc ? target->arc_tilt : 0};
+
+    uint32_t pan_dist = abs(pan_axis->delta);
+    uint32_t tilt_dist = abs(tilt_axis->delta);
+    uint32_t pan_bulge = abs(pan_axis->arc);
+    uint32_t tilt_bulge = abs(tilt_axis->arc);
+
+    uint64_t duration = (uint64_t)target->duration_ms * 1000;
+    uint64_t t_pan = fixture_motion_axis_min_us(profile, pan_dist, pan_bulge, model->pan_velocity, model->pan_accel);
+    uint64_t t_tilt = fixture_motion_axis_min_us(profile, tilt_dist, tilt_bulge, model->tilt_velocity,
+                                                 model->tilt_accel);
+    if (t_pan > duration)
+    {
+        duration = t_pan;
+    }
+    if (t_tilt > duration)
+    {
+        duration = t_tilt;
+    }
+    if (duration > (uint64_t)FIXTURE_MOTION_MAX_MS * 1000)
+    {
+        duration = (uint64_t)FIXTURE_MOTION_MAX_MS * 1000;
+    }
+
+    uint64_t lag_pan = fixture_motion_axis_lag_us(profile, pan_dist, pan_bulge, model->pan_accel, duration);
+    uint64_t lag_tilt = fixture_motion_axis_lag_us(profile, tilt_dist, tilt_bulge, model->tilt_accel, duration);
+    *lag_us = (uint32_t)((lag_pan > lag_tilt) ? lag_pan : lag_tilt) + model->latency_ms * 1000;
+
+    return (uint32_t)duration;
+}
+
+esp_err_t fixture_motion_create(fixture_handle_t fixture, const fixture_motion_model_t *model,
+                                fixture_motion_handle_t *out_motion)
+{
+    if (fixture == NULL || out_motion == NULL || !fixture_motion_model_valid(model))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fixture_context_t *ctx = (fixture_context_t *)fixture;
+    const fixture_attr_def_t *pan_def = fixture_lookup(ctx, FIXTURE_ATTR_PAN);
+    const fixture_attr_def_t *tilt_def = fixture_lookup(ctx, FIXTURE_ATTR_TILT);
+    if (pan_def == NULL || tilt_def == NULL ||
+        !(pan_def->flags & FIXTURE_ATTR_F_16BIT) || !(tilt_def->flags & FIXTURE_ATTR_F_16BIT))
+    {
+        ESP_LOGE(TAG, "%s has no 16-bit pan/tilt", ctx->profile->name);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    struct fixture_motion *motion = (struct fixture_motion *)calloc(1, sizeof(struct fixture_motion));
+    if (motion == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate planner");
+        return ESP_ERR_NO_MEM;
+    }
+
+    motion->fixture = ctx;
+    motion->pan_def = pan_def;
+    motion->tilt_def = tilt_def;
+    motion->model = *model;
+    motion->lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+
+    esp_err_t ret = dmx_add_tx_callback(ctx->dmx_handle, fixture_motion_frame, motion);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "No frame slot callback left on the universe");
+        free(motion);
+        return ret;
+    }
+
+    *out_motion = motion;
+    return ESP_OK;
+}
+
+esp_err_t fixture_motion_delete(fixture_motion_handle_t motion)
+{
+    if (motion == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_remove_tx_callback(motion->fixture->dmx_handle, fixture_motion_frame, motion);
+
+    free(motion);
+    return ESP_OK;
+}
+
+esp_err_t fixture_motion_set_model(fixture_motion_handle_t motion, const fixture_motion_model_t *model)
+{
+    if (motion == NULL || !fixture_motion_model_valid(model))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&motion->lock);
+    motion->model = *model;
+    portEXIT_CRITICAL(&motion->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t fixture_motion_get_model(fixture_motion_handle_t motion, fixture_motion_model_t *out_model)
+{
+    if (motion == NULL || out_model == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&motion->lock);
+    *out_model = motion->model;
+    portEXIT_CRITICAL(&motion->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t fixture_motion_plan(fixture_motion_handle_t motion, const fixture_motion_target_t *target,
+                              fixture_motion_plan_t *out_plan)
+{
+    if (motion == NULL || out_plan == NULL || !fixture_motion_target_valid(target))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint16_t pan;
+    uint16_t tilt;
+    fixture_motion_axis_t pan_axis;
+    fixture_motion_axis_t tilt_axis;
+    uint32_t lag_us;
+
+    fixture_motion_current(motion, (uint32_t)esp_timer_get_time(), &pan, &tilt);
+    uint32_t duration_us = fixture_motion_prepare(motion, target, pan, tilt, &pan_axis, &tilt_axis, &lag_us);
+
+    out_plan->duration_ms = (duration_us + 999) / 1000;
+    out_plan->arrival_ms = (duration_us + lag_us + 999) / 1000;
+    return ESP_OK;
+}
+
+esp_err_t fixture_motion_move(fixture_motion_handle_t motion, const fixture_motion_target_t *target,
+                              int64_t *out_arrival_us)
+{
+    if (motion == NULL || !fixture_motion_target_valid(target))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int64_t now = esp_timer_get_time();
+    uint16_t pan;
+    uint16_t tilt;
+    fixture_motion_axis_t pan_axis;
+    fixture_motion_axis_t tilt_axis;
+    uint32_t lag_us;
+
+    fixture_motion_current(motion, (uint32_t)now, &pan, &tilt);
+    uint32_t duration_us = fixture_motion_prepare(motion, target, pan, tilt, &pan_axis, &tilt_axis, &lag_us);
+    uint64_t recip = (duration_us > 0) ? ((1ULL << 47) / duration_us) : 0;
+    int64_t arrival_us = now + duration_us + lag_us;
+
+    if (target->duration_ms > 0 && duration_us > target->duration_ms * 1000)
+    {
+        ESP_LOGD(TAG, "Move stretched from %lu to %lu ms", (unsigned long)target->duration_ms,
+                 (unsigned long)(duration_us / 1000));
+    }
+
+    portENTER_CRITICAL(&motion->lock);
+    motion->pan = pan_axis;
+    motion->tilt = tilt_axis;
+    motion->profile = (uint8_t)target->profile;
+    motion->start_us = (uint32_t)now;
+    motion->duration_us = duration_us;
+    motion->recip = recip;
+    motion->arrival_us = arrival_us;
+    motion->moving = true;
+    portEXIT_CRITICAL(&motion->lock);
+
+    if (out_arrival_us != NULL)
+    {
+        *out_arrival_us = arrival_us;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t fixture_motion_stop(fixture_motion_handle_t motion)
+{
+    if (motion == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The shadow channels hold the last setpoint written, the head stays there
+    portENTER_CRITICAL(&motion->lock);
+    motion->moving = false;
+    portEXIT_CRITICAL(&motion->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t fixture_motion_get_state(fixture_motion_handle_t motion, bool *out_moving, int64_t *out_arrival_us)
+{
+    if (motion == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&motion->lock);
+    if (out_moving != NULL)
+    {
+        *out_moving = motion->moving;
+    }
+    if (out_arrival_us != NULL)
+    {
+        *out_arrival_us = motion->arrival_us;
+    }
+    portEXIT_CRITICAL(&motion->lock);
+
+    return ESP_OK;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file fixture_priv.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Internal fixture definitions shared between fixture sources
+ */
+
+#ifndef FIXTURE_PRIV_H
+#define FIXTURE_PRIV_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "fixture.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Fixture context
+     */
+    typedef struct
+    {
+        dmx_handle_t dmx_handle;                 // DMX driver handle
+        dmx_source_handle_t source;              // Merge source, NULL writes the back buffer directly
+        const fixture_profile_t *profile;        // Channel layout
+        uint16_t start_channel;                  // DMX start address
+        portMUX_TYPE shadow_lock;                // Guards channels and valid against the DMX TX task
+        uint8_t channels[FIXTURE_MAX_FOOTPRINT]; // Last values written, by channel offset
+        uint32_t valid;                          // Bit per channel offset: layer holds channels[i]
+        uint8_t writers;                         // Writes between fixture_write_begin() and _end()
+        bool contended;                          // Writes overlapped, none of them may set valid bits
+        atomic_uint_least32_t applied;           // Channel writes sent to the universe
+        atomic_uint_least32_t suppressed;        // Channel writes skipped, value unchanged
+    } fixture_context_t;
+
+    /**
+     * @brief Look up an attribute in the fixture's profile
+     *
+     * @param ctx Fixture context
+     * @param attr Attribute
+     * @return Attribute definition, NULL if the profile lacks it
+     */
+    const fixture_attr_def_t *fixture_lookup(const fixture_context_t *ctx, fixture_attr_t attr);
+
+    /**
+     * @brief Open a write of the fixture's channels
+     *
+     * Every fixture_encode() / fixture_write_pairs() sequence is bracketed by
+     * fixture_write_begin() and fixture_write_end(). Fixture setters and motion
+     * frame callbacks may write the same fixture concurrently; the bracket
+     * tells when they overlapped so the shadow state is never trusted for
+     * channels whose final layer value depends on the order the writes landed.
+     * Never blocks, so it may be called from DMX TX callbacks.
+     *
+     * @param ctx Fixture context
+     */
+    void fixture_write_begin(fixture_context_t *ctx);
+
+    /**
+     * @brief Clamp a value, store it in the shadow channels and emit the changed channel/value pairs
+     *
+     * Channels whose layer already holds the value are skipped and counted as
+     * suppressed. Emitted channels are invalid until fixture_write_end()
+     * confirms the write. Must be called between fixture_write_begin() and
+     * fixture_write_end().
+     *
+     * @param ctx Fixture context
+     * @param def Attribute definition from fixture_lookup()
+     * @param value Value in the attribute's resolution
+     * @param pairs Receives up to 1 (8-bit) or 2 (16-bit) pairs
+     * @return Number of pairs written
+     */
+    uint8_t fixture_encode(fixture_context_t *ctx, const fixture_attr_def_t *def, uint16_t value,
+                           dmx_channel_value_t *pairs);
+
+    /**
+     * @brief Write channel/value pairs through the fixture's source or directly
+     *
+     * A single channel takes the lock-free path, anything else one atomic
+     * update; no pairs is a no-op. The pairs may belong to several fixtures
+     * sharing the DMX handle and source of ctx.
+     *
+     * @param ctx Fixture context providing the DMX handle and source
+     * @param pairs Channel/value pairs
+     * @param count Number of pairs
+     * @return Result of the DMX driver call
+     */
+    esp_err_t fixture_write_pairs(fixture_context_t *ctx, const dmx_channel_value_t *pairs, uint16_t count);
+
+    /**
+     * @brief Close a write opened with fixture_write_begin()
+     *
+     * Marks the written channels valid, so unchanged values are suppressed
+     * from now on, only if the write succeeded and no other write of the
+     * fixture overlapped it. Otherwise they stay invalid and the next write
+     * of those channels goes out again.
+     *
+     * @param ctx Fixture context
+     * @param pairs Pairs emitted by fixture_encode() for ctx
+     * @param count Number of pairs
+     * @param written The write of the pairs succeeded
+     */
+    void fixture_write_end(fixture_context_t *ctx, const dmx_channel_value_t *pairs, uint16_t count,
+                           bool written);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXTURE_PRIV_H
@@ -0,0 +1,41 @@
+/**
+ * @file fixture_profiles.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Built-in fixture profile tables
+ */
+
+#include "fixture_profiles.h"
+
+const fixture_profile_t fixture_profile_mh_x25 = {
+    .name = "MH X25 12ch",
+    .footprint = 12,
+    .attrs = {
+        [FIXTURE_ATTR_PAN] = FIXTURE_ATTR_16BIT(0, 2, 0, 65535, 0),
+        [FIXTURE_ATTR_TILT] = FIXTURE_ATTR_16BIT(1, 3, 0, 65535, 0),
+        [FIXTURE_ATTR_SPEED] = FIXTURE_ATTR_8BIT(4, 0, 255, 0),
+        [FIXTURE_ATTR_COLOR] = FIXTURE_ATTR_8BIT(5, 0, 255, 0),
+        [FIXTURE_ATTR_SHUTTER] = FIXTURE_ATTR_8BIT(6, 0, 255, 0),
+        [FIXTURE_ATTR_DIMMER] = FIXTURE_ATTR_8BIT(7, 0, 255, 0),
+        [FIXTURE_ATTR_GOBO] = FIXTURE_ATTR_8BIT(8, 0, 255, 0),
+        [FIXTURE_ATTR_GOBO_ROTATION] = FIXTURE_ATTR_8BIT(9, 0, 255, 0),
+        [FIXTURE_ATTR_SPECIAL] = FIXTURE_ATTR_8BIT(10, 0, 255, 0),
+        [FIXTURE_ATTR_PROGRAM] = FIXTURE_ATTR_8BIT(11, 0, 255, 0),
+    },
+};
+
+const fixture_profile_t fixture_profile_rgb_head_11ch = {
+    .name = "RGB head 11ch",
+    .footprint = 11,
+    .attrs = {
+        [FIXTURE_ATTR_PAN] = FIXTURE_ATTR_16BIT(0, 9, 0, 65535, 125 << 8),
+        [FIXTURE_ATTR_TILT] = FIXTURE_ATTR_16BIT(1, 10, 0, 65535, 125 << 8),
+        [FIXTURE_ATTR_SPEED] = FIXTURE_ATTR_8BIT(2, 0, 255, 0),
+        [FIXTURE_ATTR_RED] = FIXTURE_ATTR_8BIT(3, 0, 255, 255),
+        [FIXTURE_ATTR_GREEN] = FIXTURE_ATTR_8BIT(4, 0, 255, 0),
+        [FIXTURE_ATTR_BLUE] = FIXTURE_ATTR_8BIT(5, 0, 255, 0),
+        [FIXTURE_ATTR_COLOR_MACRO] = FIXTURE_ATTR_8BIT(6, 0, 255, 0),
+        [FIXTURE_ATTR_EFFECT] = FIXTURE_ATTR_8BIT(7, 0, 255, 11), // 11-20 neutral
+        [FIXTURE_ATTR_DIMMER] = FIXTURE_ATTR_8BIT(8, 0, 255, 255),
+    },
+};
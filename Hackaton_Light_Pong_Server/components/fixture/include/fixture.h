@@ -0,0 +1,283 @@
+/**
+ * @file fixture.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Profile driven DMX fixture control
+ *
+ * A fixture profile is a constant table mapping each attribute (pan, dimmer,
+ * color, ...) to its channel offset, resolution, valid range and default.
+ * The generic fixture_set_attr()/fixture_set_attrs() look the attribute up
+ * in the profile and write all affected channels in a single DMX update, so
+ * a new fixture type only needs a new profile table (see fixture_profiles.h).
+ *
+ * Each fixture keeps a shadow copy of the values it wrote. Channels that
+ * already hold the requested value are not written again, so re-setting an
+ * unchanged attribute costs neither a lock nor an idle-mode wakeup. A
+ * channel only counts as written once its DMX write succeeded without
+ * another write of the same fixture (e.g. from a motion) overlapping it.
+ */
+
+#ifndef FIXTURE_H
+#define FIXTURE_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+#include "dmx_merge.h"
+#include "dmx_fade.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FIXTURE_MAX_FOOTPRINT 32 // Channels of the largest supported mode
+
+    /**
+     * @brief Fixture attributes; each profile maps the ones it supports
+     */
+    typedef enum
+    {
+        FIXTURE_ATTR_PAN = 0,       ///< Pan position
+        FIXTURE_ATTR_TILT,          ///< Tilt position
+        FIXTURE_ATTR_SPEED,         ///< Pan/tilt speed
+        FIXTURE_ATTR_COLOR,         ///< Color wheel
+        FIXTURE_ATTR_SHUTTER,       ///< Shutter/strobe
+        FIXTURE_ATTR_DIMMER,        ///< Intensity
+        FIXTURE_ATTR_GOBO,          ///< Gobo wheel
+        FIXTURE_ATTR_GOBO_ROTATION, ///< Gobo rotation
+        FIXTURE_ATTR_SPECIAL,       ///< Special functions, resets
+        FIXTURE_ATTR_PROGRAM,       ///< Built-in programs
+        FIXTURE_ATTR_RED,           ///< Red emitter
+        FIXTURE_ATTR_GREEN,         ///< Green emitter
+        FIXTURE_ATTR_BLUE,          ///< Blue emitter
+        FIXTURE_ATTR_COLOR_MACRO,   ///< Color macros
+        FIXTURE_ATTR_EFFECT,        ///< LED effects, strobe, reset
+        FIXTURE_ATTR_COUNT
+    } fixture_attr_t;
+
+/* Attribute flags */
+#define FIXTURE_ATTR_F_PRESENT 0x01 // Attribute exists in this profile
+#define FIXTURE_ATTR_F_16BIT 0x02   // Coarse and fine channel, values 0-65535
+
+    /**
+     * @brief Channel mapping of one attribute
+     *
+     * Values are in the attribute's resolution (0-255 or 0-65535) and are
+     * clamped to [min, max] when written.
+     */
+    typedef struct
+    {
+        uint8_t flags;          ///< FIXTURE_ATTR_F_*, 0 if the profile lacks the attribute
+        uint8_t offset;         ///< Channel offset from the start address (coarse byte)
+        uint8_t fine_offset;    ///< Channel offset of the fine byte (16-bit only)
+        uint16_t min;           ///< Lowest value sent
+        uint16_t max;           ///< Highest value sent
+        uint16_t default_value; ///< Value written at init
+    } fixture_attr_def_t;
+
+/* Profile table helpers */
+#define FIXTURE_ATTR_8BIT(off, lo, hi, def) \
+    {.flags = FIXTURE_ATTR_F_PRESENT, .offset = (off), .fine_offset = 0, .min = (lo), .max = (hi), .default_value = (def)}
+#define FIXTURE_ATTR_16BIT(off, fine, lo, hi, def)                                                            \
+    {.flags = FIXTURE_ATTR_F_PRESENT | FIXTURE_ATTR_F_16BIT, .offset = (off), .fine_offset = (fine), .min = (lo), \
+     .max = (hi), .default_value = (def)}
+
+    /**
+     * @brief Fixture profile (one DMX mode of one fixture type)
+     */
+    typedef struct
+    {
+        const char *name;                               ///< Profile name for logs
+        uint8_t footprint;                              ///< Channels used (1-FIXTURE_MAX_FOOTPRINT)
+        fixture_attr_def_t attrs[FIXTURE_ATTR_COUNT]; ///< Indexed by fixture_attr_t
+    } fixture_profile_t;
+
+    /**
+     * @brief Attribute/value pair for batched writes
+     */
+    typedef struct
+    {
+        fixture_attr_t attr; ///< Attribute
+        uint16_t value;      ///< Value in the attribute's resolution
+    } fixture_attr_value_t;
+
+    /**
+     * @brief Channel write counters of one fixture
+     */
+    typedef struct
+    {
+        uint32_t applied;    ///< Channel writes sent to the universe
+        uint32_t suppressed; ///< Channel writes skipped because the value was unchanged
+    } fixture_write_stats_t;
+
+    /**
+     * @brief Fixture configuration
+     */
+    typedef struct
+    {
+        dmx_handle_t dmx_handle;           ///< DMX driver handle
+        dmx_source_handle_t source;        ///< Optional merge source to write through (NULL = direct)
+        const fixture_profile_t *profile;  ///< Channel layout, must stay valid
+        uint16_t start_channel;            ///< DMX start address
+    } fixture_config_t;
+
+    /**
+     * @brief Fixture handle
+     */
+    typedef void *fixture_handle_t;
+
+    /**
+     * @brief Create a fixture from a profile
+     *
+     * Without a merge source all channels are set to the profile defaults. A
+     * merge source does not own any channel until an attribute is written.
+     *
+     * @param config Fixture configuration
+     * @param out_handle Pointer to store the fixture handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments, invalid profile or address
+     *      - ESP_ERR_NO_MEM: Out of memory
+     */
+    esp_err_t fixture_init(const fixture_config_t *config, fixture_handle_t *out_handle);
+
+    /**
+     * @brief Delete a fixture
+     *
+     * Releases the channels of a merge source, otherwise writes the defaults.
+     *
+     * @param handle Fixture handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_deinit(fixture_handle_t handle);
+
+    /**
+     * @brief Set one attribute
+     *
+     * A 16-bit attribute writes coarse and fine byte in the same frame.
+     * Channels already holding the value are skipped.
+     *
+     * @param handle Fixture handle
+     * @param attr Attribute
+     * @param value Value in the attribute's resolution, clamped to its range
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Profile has no such attribute
+     */
+    esp_err_t fixture_set_attr(fixture_handle_t handle, fixture_attr_t attr, uint16_t value);
+
+    /**
+     * @brief Set several attributes in one DMX update
+     *
+     * All values appear in the same frame. Nothing is written if any
+     * attribute is missing from the profile.
+     *
+     * @param handle Fixture handle
+     * @param values Attribute/value pairs
+     * @param count Number of pairs (at most FIXTURE_ATTR_COUNT)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Profile lacks one of the attributes
+     */
+    esp_err_t fixture_set_attrs(fixture_handle_t handle, const fixture_attr_value_t *values, uint8_t count);
+
+    /**
+     * @brief Get the last value written to an attribute
+     *
+     * @param handle Fixture handle
+     * @param attr Attribute
+     * @param out_value Value after clamping
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Profile has no such attribute
+     */
+    esp_err_t fixture_get_attr(fixture_handle_t handle, fixture_attr_t attr, uint16_t *out_value);
+
+    /**
+     * @brief Fade an 8-bit attribute inside the DMX frame loop
+     *
+     * @param handle Fixture handle
+     * @param attr Attribute
+     * @param value Target value, clamped to the attribute's range
+     * @param duration_ms Fade time in milliseconds
+     * @param curve Fade curve
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Attribute missing or 16-bit
+     *      - ESP_ERR_NO_MEM: Fade pool full
+     */
+    esp_err_t fixture_fade_attr(fixture_handle_t handle, fixture_attr_t attr, uint8_t value,
+                                uint32_t duration_ms, dmx_fade_curve_t curve);
+
+    /**
+     * @brief Release all channels of the merge source
+     *
+     * Lower priority sources take over the fixture again.
+     *
+     * @param handle Fixture handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     *      - ESP_ERR_INVALID_STATE: Fixture was not configured with a merge source
+     */
+    esp_err_t fixture_release(fixture_handle_t handle);
+
+    /**
+     * @brief Get the profile and start address of a fixture
+     *
+     * @param handle Fixture handle
+     * @param out_profile Profile, may be NULL
+     * @param out_start_channel Start address, may be NULL
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_get_info(fixture_handle_t handle, const fixture_profile_t **out_profile,
+                               uint16_t *out_start_channel);
+
+    /**
+     * @brief Forget the shadow state so the next write of every channel goes out
+     *
+     * Needed after the channels were changed behind the fixture's back, e.g.
+     * by dmx_clear_all() or another handle on the same channels.
+     *
+     * @param handle Fixture handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_invalidate(fixture_handle_t handle);
+
+    /**
+     * @brief Get the applied and suppressed channel write counters
+     *
+     * @param handle Fixture handle
+     * @param out_stats Pointer to store the counters
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t fixture_get_write_stats(fixture_handle_t handle, fixture_write_stats_t *out_stats);
+
+    /**
+     * @brief Reset the channel write counters
+     *
+     * @param handle Fixture handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_reset_write_stats(fixture_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXTURE_H
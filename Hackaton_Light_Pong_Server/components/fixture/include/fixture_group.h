@@ -0,0 +1,122 @@
+/**
+ * @file fixture_group.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Groups of fixtures driven with a single call
+ *
+ * A group applies one attribute change to all of its members and writes the
+ * channels of every member in one sparse DMX update, so all heads change in
+ * the same frame and the universe lock is taken once instead of per head.
+ * Members may mirror and offset pan/tilt to follow the same target from
+ * different positions. MH X25 handles are fixture handles and can be added
+ * directly.
+ */
+
+#ifndef FIXTURE_GROUP_H
+#define FIXTURE_GROUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "fixture.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FIXTURE_GROUP_MAX_MEMBERS 64
+#define FIXTURE_GROUP_MAX_PAIRS 8 // Channels per member one group call may write
+
+    /**
+     * @brief Per-member pan/tilt transform, applied as offset + (mirror ? full - v : v)
+     *
+     * Offsets are in the attribute's resolution (0-65535 for 16-bit pan/tilt);
+     * the result is clamped to the attribute's range.
+     */
+    typedef struct
+    {
+        int32_t pan_offset;  ///< Added to pan after mirroring
+        int32_t tilt_offset; ///< Added to tilt after mirroring
+        bool mirror_pan;     ///< Pan runs the other way
+        bool mirror_tilt;    ///< Tilt runs the other way
+    } fixture_group_member_config_t;
+
+    /**
+     * @brief Fixture group handle
+     */
+    typedef struct fixture_group *fixture_group_handle_t;
+
+    /**
+     * @brief Create an empty group
+     *
+     * @param max_members Capacity (1-FIXTURE_GROUP_MAX_MEMBERS)
+     * @param out_group Pointer to store the group handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory
+     */
+    esp_err_t fixture_group_create(uint16_t max_members, fixture_group_handle_t *out_group);
+
+    /**
+     * @brief Delete a group; the member fixtures stay untouched
+     *
+     * @param group Group handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_group_delete(fixture_group_handle_t group);
+
+    /**
+     * @brief Add a fixture to a group
+     *
+     * All members must write to the same DMX handle through the same merge
+     * source (or all directly), so one update covers the whole group.
+     *
+     * @param group Group handle
+     * @param fixture Fixture handle (or MH X25 handle)
+     * @param config Pan/tilt transform, NULL for none
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments or different universe/source
+     *      - ESP_ERR_NO_MEM: Group is full
+     */
+    esp_err_t fixture_group_add(fixture_group_handle_t group, fixture_handle_t fixture,
+                                const fixture_group_member_config_t *config);
+
+    /**
+     * @brief Set one attribute on all members
+     *
+     * @param group Group handle
+     * @param attr Attribute
+     * @param value Value before the member's pan/tilt transform
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: No member has the attribute
+     */
+    esp_err_t fixture_group_set_attr(fixture_group_handle_t group, fixture_attr_t attr, uint16_t value);
+
+    /**
+     * @brief Set several attributes on all members in one DMX update
+     *
+     * Members lacking an attribute skip it.
+     *
+     * @param group Group handle
+     * @param values Attribute/value pairs
+     * @param count Number of pairs, at most FIXTURE_GROUP_MAX_PAIRS channels per member
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments or too many channels per member
+     *      - ESP_ERR_NOT_SUPPORTED: No member has any of the attributes
+     */
+    esp_err_t fixture_group_set_attrs(fixture_group_handle_t group, const fixture_attr_value_t *values,
+                                      uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXTURE_GROUP_H
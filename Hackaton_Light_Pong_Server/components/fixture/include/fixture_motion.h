@@ -0,0 +1,186 @@
+/**
+ * @file fixture_motion.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Pan/tilt trajectory planner for moving heads
+ *
+ * Instead of jumping to a new position and letting the fixture's internal
+ * speed channel smear the motion, the planner writes a fresh 16-bit pan/tilt
+ * setpoint in every DMX frame slot (via dmx_add_tx_callback()), following a
+ * linear, eased or arced path. A velocity/acceleration model of the fixture
+ * stretches moves the head could not follow, so the time the beam arrives is
+ * known when the move starts. Run the fixture's own pan/tilt speed channel at
+ * its fastest setting so it does not add smoothing of its own.
+ */
+
+#ifndef FIXTURE_MOTION_H
+#define FIXTURE_MOTION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "fixture.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FIXTURE_MOTION_MAX_MS 60000 // Longest move
+
+    /**
+     * @brief Path shape between start and target
+     */
+    typedef enum
+    {
+        FIXTURE_MOTION_LINEAR = 0, ///< Constant speed, the head lags while it accelerates
+        FIXTURE_MOTION_EASE,       ///< Smoothstep, zero speed at both ends; followed exactly
+        FIXTURE_MOTION_ARC,        ///< Constant speed plus a parabolic sideways bulge (ball arc)
+    } fixture_motion_profile_t;
+
+    /**
+     * @brief Pan/tilt dynamics of a fixture in 16-bit position units
+     */
+    typedef struct
+    {
+        uint32_t pan_velocity;  ///< Top pan speed (units/s)
+        uint32_t tilt_velocity; ///< Top tilt speed (units/s)
+        uint32_t pan_accel;     ///< Pan acceleration (units/s^2)
+        uint32_t tilt_accel;    ///< Tilt acceleration (units/s^2)
+        uint32_t latency_ms;    ///< Delay from a DMX setpoint until the head starts to follow
+    } fixture_motion_model_t;
+
+    /**
+     * @brief One move
+     */
+    typedef struct
+    {
+        uint16_t pan;                     ///< Target pan (0-65535)
+        uint16_t tilt;                    ///< Target tilt (0-65535)
+        fixture_motion_profile_t profile; ///< Path shape
+        uint32_t duration_ms;             ///< Requested travel time, 0 for the fastest the model allows
+        int32_t arc_pan;                  ///< FIXTURE_MOTION_ARC: pan displacement at the midpoint
+        int32_t arc_tilt;                 ///< FIXTURE_MOTION_ARC: tilt displacement at the midpoint
+    } fixture_motion_target_t;
+
+    /**
+     * @brief Timing of a planned move
+     */
+    typedef struct
+    {
+        uint32_t duration_ms; ///< Setpoint travel time after stretching to the model
+        uint32_t arrival_ms;  ///< Time from the start until the head is at the target
+    } fixture_motion_plan_t;
+
+    /**
+     * @brief Motion planner handle
+     */
+    typedef struct fixture_motion *fixture_motion_handle_t;
+
+    /**
+     * @brief Create a planner for a fixture with 16-bit pan and tilt
+     *
+     * Adds the planner as a frame slot callback of the fixture's universe.
+     * Setpoints are only generated while continuous transmission is running.
+     *
+     * @param fixture Fixture handle (or MH X25 handle)
+     * @param model Pan/tilt dynamics of the fixture
+     * @param out_motion Pointer to store the planner handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Profile lacks 16-bit pan or tilt
+     *      - ESP_ERR_NO_MEM: Out of memory or frame slot callbacks
+     */
+    esp_err_t fixture_motion_create(fixture_handle_t fixture, const fixture_motion_model_t *model,
+                                    fixture_motion_handle_t *out_motion);
+
+    /**
+     * @brief Stop and delete a planner; the head keeps its last setpoint
+     *
+     * @param motion Planner handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_motion_delete(fixture_motion_handle_t motion);
+
+    /**
+     * @brief Replace the fixture model, e.g. after a calibration
+     *
+     * Applies to moves started afterwards.
+     *
+     * @param motion Planner handle
+     * @param model Pan/tilt dynamics of the fixture
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t fixture_motion_set_model(fixture_motion_handle_t motion, const fixture_motion_model_t *model);
+
+    /**
+     * @brief Get the fixture model in use
+     *
+     * @param motion Planner handle
+     * @param out_model Pointer to store the model
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t fixture_motion_get_model(fixture_motion_handle_t motion, fixture_motion_model_t *out_model);
+
+    /**
+     * @brief Compute the timing of a move from the current setpoint without starting it
+     *
+     * @param motion Planner handle
+     * @param target Move
+     * @param out_plan Pointer to store the timing
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t fixture_motion_plan(fixture_motion_handle_t motion, const fixture_motion_target_t *target,
+                                  fixture_motion_plan_t *out_plan);
+
+    /**
+     * @brief Start a move from the current setpoint, replacing a running one
+     *
+     * Returns immediately; the setpoints are written once per frame slot.
+     *
+     * @param motion Planner handle
+     * @param target Move
+     * @param out_arrival_us Pointer to store the esp_timer time the head reaches the target (may be NULL)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t fixture_motion_move(fixture_motion_handle_t motion, const fixture_motion_target_t *target,
+                                  int64_t *out_arrival_us);
+
+    /**
+     * @brief Stop a running move at its current setpoint
+     *
+     * @param motion Planner handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_motion_stop(fixture_motion_handle_t motion);
+
+    /**
+     * @brief Get the state of the last move
+     *
+     * @param motion Planner handle
+     * @param out_moving Pointer to store whether setpoints are still changing (may be NULL)
+     * @param out_arrival_us Pointer to store the arrival time of the last move (may be NULL)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t fixture_motion_get_state(fixture_motion_handle_t motion, bool *out_moving, int64_t *out_arrival_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXTURE_MOTION_H
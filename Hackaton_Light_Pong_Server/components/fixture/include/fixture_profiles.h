@@ -0,0 +1,35 @@
+/**
+ * @file fixture_profiles.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Built-in fixture profiles
+ *
+ * Adding a fixture type means adding a constant fixture_profile_t to
+ * fixture_profiles.c and declaring it here.
+ */
+
+#ifndef FIXTURE_PROFILES_H
+#define FIXTURE_PROFILES_H
+
+#include "fixture.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief MH X25 LED moving head, 12-channel mode
+     */
+    extern const fixture_profile_t fixture_profile_mh_x25;
+
+    /**
+     * @brief RGB moving head, 11-channel mode (pan/tilt fine on channels 10/11)
+     */
+    extern const fixture_profile_t fixture_profile_rgb_head_11ch;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXTURE_PROFILES_H
@@ -0,0 +1,115 @@
+/**
+ * @file latency_trace.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief End-to-end paddle input latency tracing
+ *
+ * Follows a paddle press from the ESP-NOW receive callback through the
+ * receiver task, the paddle event, the game task and the position command to
+ * the DMX frame that carries the new position. Each stage is timestamped with
+ * esp_timer; completed traces are kept in a window on the device, from which
+ * per-stage percentiles are computed on request. One trace can be in flight
+ * per channel (player); a new press on a channel replaces an unfinished trace.
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define LATENCY_TRACE_CHANNELS 2 // Traces in flight at once, one per player
+#define LATENCY_TRACE_WINDOW 64  // Completed traces kept for percentiles
+
+    /**
+     * @brief Stages of a paddle press, in order
+     */
+    typedef enum
+    {
+        LATENCY_STAGE_RX = 0,   ///< ESP-NOW receive callback (origin of the trace)
+        LATENCY_STAGE_DISPATCH, ///< Receiver task took the packet from the ring
+        LATENCY_STAGE_EVENT,    ///< Paddle hit event bit set
+        LATENCY_STAGE_WAKE,     ///< Game task woke up on the event bit
+        LATENCY_STAGE_COMMAND,  ///< New ball position handed to the fixture
+        LATENCY_STAGE_FRAME,    ///< Frame slot whose DMX frame carries the position
+        LATENCY_STAGE_COUNT
+    } latency_stage_t;
+
+    /**
+     * @brief Latency of one stage over the window, measured from LATENCY_STAGE_RX
+     */
+    typedef struct
+    {
+        uint32_t count;  ///< Traces in the window
+        uint32_t min_us; ///< Fastest
+        uint32_t p50_us; ///< Median
+        uint32_t p90_us; ///< 90th percentile
+        uint32_t p99_us; ///< 99th percentile
+        uint32_t max_us; ///< Slowest
+    } latency_trace_stats_t;
+
+    /**
+     * @brief Start tracing and hook the frame stage into a universe
+     *
+     * @param dmx_handle Universe the traced fixture is on
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     *      - ESP_ERR_INVALID_STATE: Already started
+     *      - ESP_ERR_NO_MEM: No frame slot callback left on the universe
+     */
+    esp_err_t latency_trace_init(dmx_handle_t dmx_handle);
+
+    /**
+     * @brief Begin a trace on a channel, replacing an unfinished one
+     *
+     * @param channel Channel (0 to LATENCY_TRACE_CHANNELS - 1)
+     * @param rx_us esp_timer time the packet was received
+     */
+    void latency_trace_begin(uint8_t channel, int64_t rx_us);
+
+    /**
+     * @brief Timestamp the next stage of a channel's trace
+     *
+     * Ignored unless the trace has just passed the previous stage, so marks
+     * from presses that are not being traced are harmless. Marking
+     * LATENCY_STAGE_COMMAND arms the frame stage, which is recorded from the
+     * next frame slot.
+     *
+     * @param channel Channel (0 to LATENCY_TRACE_CHANNELS - 1)
+     * @param stage Stage reached (LATENCY_STAGE_DISPATCH to LATENCY_STAGE_COMMAND)
+     */
+    void latency_trace_mark(uint8_t channel, latency_stage_t stage);
+
+    /**
+     * @brief Get the percentiles of a stage over the completed traces
+     *
+     * @param stage Stage (LATENCY_STAGE_DISPATCH to LATENCY_STAGE_FRAME)
+     * @param out_stats Pointer to store the percentiles
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t latency_trace_get_stats(latency_stage_t stage, latency_trace_stats_t *out_stats);
+
+    /**
+     * @brief Log the percentiles of every stage
+     */
+    void latency_trace_log(void);
+
+    /**
+     * @brief Drop all completed and unfinished traces
+     */
+    void latency_trace_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LATENCY_TRACE_H
@@ -0,0 +1,228 @@
+/**
+ * @file latency_trace.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief End-to-end paddle input latency tracing implementation
+ */
+
+#include "latency_trace.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "LATENCY";
+
+/**
+ * @brief Trace in flight on one channel
+ */
+typedef struct
+{
+    int8_t stage; // Last stage reached, -1 when idle
+    int64_t stamp_us[LATENCY_STAGE_COUNT];
+} latency_trace_flight_t;
+
+/**
+ * @brief Tracer state, shared by the receiver, game and transmission tasks under lock
+ */
+typedef struct
+{
+    bool started;
+    portMUX_TYPE lock;
+    latency_trace_flight_t flight[LATENCY_TRACE_CHANNELS];
+    // Completed traces: time of each stage after LATENCY_STAGE_RX
+    uint32_t window[LATENCY_TRACE_WINDOW][LATENCY_STAGE_COUNT];
+    uint32_t next;      // Window slot of the next completed trace
+    uint32_t completed; // Traces completed since the last reset
+    uint32_t replaced;  // Unfinished traces replaced by a newer press
+} latency_trace_t;
+
+static latency_trace_t tracer = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+    "rx", "dispatch", "event", "wake", "command", "frame"};
+
+/**
+ * @brief Move a trace that has reached its last stage into the window (lock held)
+ */
+static void latency_trace_complete(latency_trace_flight_t *flight)
+{
+    uint32_t *slot = tracer.window[tracer.next];
+    for (int stage = 0; stage < LATENCY_STAGE_COUNT; stage++)
+    {
+        slot[stage] = (uint32_t)(flight->stamp_us[stage] - flight->stamp_us[LATENCY_STAGE_RX]);
+    }
+    tracer.next = (tracer.next + 1) % LATENCY_TRACE_WINDOW;
+    tracer.completed++;
+    flight->stage = -1;
+}
+
+/**
+ * @brief Frame slot callback: the first slot after a command carries it
+ *
+ * The fixture's own slot callbacks were added before this one and have
+ * already written the channels when it runs.
+ */
+static void latency_trace_frame(int64_t slot_us, void *user_ctx)
+{
+    portENTER_CRITICAL(&tracer.lock);
+    for (int i = 0; i < LATENCY_TRACE_CHANNELS; i++)
+    {
+        latency_trace_flight_t *flight = &tracer.flight[i];
+        if (flight->stage == LATENCY_STAGE_COMMAND && flight->stamp_us[LATENCY_STAGE_COMMAND] <= slot_us)
+        {
+            flight->stamp_us[LATENCY_STAGE_FRAME] = slot_us;
+            latency_trace_complete(flight);
+        }
+    }
+    portEXIT_CRITICAL(&tracer.lock);
+}
+
+esp_err_t latency_trace_init(dmx_handle_t dmx_handle)
+{
+    if (dmx_handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (tracer.started)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    latency_trace_reset();
+
+    esp_err_t ret = dmx_add_tx_callback(dmx_handle, latency_trace_frame, NULL);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "No frame slot callback left on the universe");
+        return ret;
+    }
+
+    tracer.started = true;
+    return ESP_OK;
+}
+
+void latency_trace_begin(uint8_t channel, int64_t rx_us)
+{
+    if (!tracer.started || channel >= LATENCY_TRACE_CHANNELS)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&tracer.lock);
+    latency_trace_flight_t *flight = &tracer.flight[channel];
+    if (flight->stage >= 0)
+    {
+        tracer.replaced++;
+    }
+    flight->stage = LATENCY_STAGE_RX;
+    flight->stamp_us[LATENCY_STAGE_RX] = rx_us;
+    portEXIT_CRITICAL(&tracer.lock);
+}
+
+void latency_trace_mark(uint8_t channel, latency_stage_t stage)
+{
+    if (!tracer.started || channel >= LATENCY_TRACE_CHANNELS || stage <= LATENCY_STAGE_RX ||
+        stage >= LATENCY_STAGE_FRAME)
+    {
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&tracer.lock);
+    latency_trace_flight_t *flight = &tracer.flight[channel];
+    if (flight->stage == (int8_t)(stage - 1))
+    {
+        flight->stage = (int8_t)stage;
+        flight->stamp_us[stage] = now;
+    }
+    portEXIT_CRITICAL(&tracer.lock);
+}
+
+esp_err_t latency_trace_get_stats(latency_stage_t stage, latency_trace_stats_t *out_stats)
+{
+    if (stage <= LATENCY_STAGE_RX || stage >= LATENCY_STAGE_COUNT || out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t samples[LATENCY_TRACE_WINDOW];
+    uint32_t count;
+
+    portENTER_CRITICAL(&tracer.lock);
+    count = (tracer.completed < LATENCY_TRACE_WINDOW) ? tracer.completed : LATENCY_TRACE_WINDOW;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        samples[i] = tracer.window[i][stage];
+    }
+    portEXIT_CRITICAL(&tracer.lock);
+
+    memset(out_stats, 0, sizeof(*out_stats));
+    if (count == 0)
+    {
+        return ESP_OK;
+    }
+
+    // Insertion sort, the window is small
+    for (uint32_t i = 1; i < count; i++)
+    {
+        uint32_t value = samples[i];
+        uint32_t j = i;
+        while (j > 0 && samples[j - 1] > value)
+        {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = value;
+    }
+
+    // Nearest rank
+    out_stats->count = count;
+    out_stats->min_us = samples[0];
+    out_stats->p50_us = samples[(count * 50 + 99) / 100 - 1];
+    out_stats->p90_us = samples[(count * 90 + 99) / 100 - 1];
+    out_stats->p99_us = samples[(count * 99 + 99) / 100 - 1];
+    out_stats->max_us = samples[count - 1];
+    return ESP_OK;
+}
+
+void latency_trace_log(void)
+{
+    latency_trace_stats_t stats;
+
+    portENTER_CRITICAL(&tracer.lock);
+    uint32_t completed = tracer.completed;
+    uint32_t replaced = tracer.replaced;
+    portEXIT_CRITICAL(&tracer.lock);
+
+    ESP_LOGI(TAG, "Paddle latency: %" PRIu32 " traces completed, %" PRIu32 " replaced unfinished",
+             completed, replaced);
+
+    for (int stage = LATENCY_STAGE_DISPATCH; stage < LATENCY_STAGE_COUNT; stage++)
+    {
+        if (latency_trace_get_stats((latency_stage_t)stage, &stats) != ESP_OK || stats.count == 0)
+        {
+            continue;
+        }
+        ESP_LOGI(TAG, "  rx -> %-8s min %" PRIu32 " p50 %" PRIu32 " p90 %" PRIu32 " p99 %" PRIu32 " max %" PRIu32 " us",
+                 stage_names[stage], stats.min_us, stats.p50_us, stats.p90_us, stats.p99_us, stats.max_us);
+    }
+}
+
+void latency_trace_reset(void)
+{
+    portENTER_CRITICAL(&tracer.lock);
+    for (int i = 0; i < LATENCY_TRACE_CHANNELS; i++)
+    {
+        tracer.flight[i].stage = -1;
+    }
+    tracer.next = 0;
+    tracer.completed = 0;
+    tracer.replaced = 0;
+    portEXIT_CRITICAL(&tracer.lock);
+}
@@ -0,0 +1,249 @@
+/**
+ * @file light_cue.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Cue list / timeline engine for fixture effects
+ *
+ * An effect is a cue: static const tables of timed keyframes and step
+ * patterns per fixture attribute, kept in flash. A cue player renders the
+ * running cues of one fixture once per DMX frame slot (via
+ * dmx_add_tx_callback()), so starting an effect returns
+ * immediately and playback never blocks the caller. Cues run on layers; where
+ * several cues drive the same attribute the highest layer wins, the others
+ * keep running underneath. When the last cue has ended or been stopped, the
+ * fixture's channels are released to the layers below its merge source.
+ */
+
+#ifndef LIGHT_CUE_H
+#define LIGHT_CUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+#include "fixture.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define LIGHT_CUE_MAX_LAYERS 4 // Cues running at once per player
+#define LIGHT_CUE_FOREVER 0    // Passes value repeating a cue until it is stopped
+
+    /**
+     * @brief How a keyframe is reached from the previous one
+     */
+    typedef enum
+    {
+        LIGHT_CUE_STEP = 0, ///< Jump at the keyframe's time
+        LIGHT_CUE_LINEAR,   ///< Constant rate from the previous keyframe
+        LIGHT_CUE_EASE,     ///< Smoothstep from the previous keyframe
+    } light_cue_interp_t;
+
+    /**
+     * @brief One keyframe of a track
+     */
+    typedef struct
+    {
+        uint16_t time_ms; ///< Time from the start of the pass
+        uint16_t value;   ///< Attribute value in the attribute's resolution
+        uint8_t interp;   ///< light_cue_interp_t from the previous keyframe
+    } light_cue_key_t;
+
+    /**
+     * @brief Values stepped through at a fixed rate: color chases, gobo steps, strobes
+     *
+     * Costs one byte per distinct value instead of a keyframe per step, and
+     * the step is found by a division instead of a keyframe search.
+     */
+    typedef struct
+    {
+        uint16_t start_ms;     ///< Time of the first step within the pass
+        uint16_t step_ms;      ///< Hold time of each step
+        uint16_t steps;        ///< Steps played, cycling through the values
+        uint8_t value_count;   ///< Number of values
+        const uint8_t *values; ///< Values in the attribute's resolution
+    } light_cue_pattern_t;
+
+    /**
+     * @brief Keyframes of one attribute, sorted by time, plus an optional step pattern
+     *
+     * While the pattern runs it replaces the keyframes. Before the first
+     * keyframe the track holds its first value, after the last one its last
+     * value; a track without keyframes holds the pattern's first and last step.
+     */
+    typedef struct
+    {
+        fixture_attr_t attr;                ///< Attribute driven by the track
+        uint8_t key_count;                  ///< Number of keyframes (at least 1 without a pattern)
+        const light_cue_key_t *keys;        ///< Keyframes
+        const light_cue_pattern_t *pattern; ///< Step pattern, NULL for none
+    } light_cue_track_t;
+
+    /**
+     * @brief A cue; keep it in static const storage, the player does not copy it
+     */
+    typedef struct
+    {
+        const char *name;                ///< Cue name for logs
+        const light_cue_track_t *tracks; ///< One track per attribute
+        uint8_t track_count;             ///< Number of tracks
+        uint16_t length_ms;              ///< Length of one pass
+        uint8_t passes;                  ///< Passes to play, LIGHT_CUE_FOREVER to repeat until stopped
+    } light_cue_t;
+
+#define LIGHT_CUE_KEY(time, value) {(time), (value), LIGHT_CUE_STEP}
+#define LIGHT_CUE_RAMP(time, value) {(time), (value), LIGHT_CUE_LINEAR}
+#define LIGHT_CUE_FADE(time, value) {(time), (value), LIGHT_CUE_EASE}
+#define LIGHT_CUE_PATTERN(start, step, steps, values) \
+    {(start), (step), (steps), sizeof(values) / sizeof((values)[0]), (values)}
+#define LIGHT_CUE_TRACK(attr, keys) {(attr), sizeof(keys) / sizeof((keys)[0]), (keys), NULL}
+#define LIGHT_CUE_PATTERN_TRACK(attr, pattern) {(attr), 0, NULL, &(pattern)}
+#define LIGHT_CUE_MIXED_TRACK(attr, keys, pattern) {(attr), sizeof(keys) / sizeof((keys)[0]), (keys), &(pattern)}
+
+    /**
+     * @brief Cue player handle
+     */
+    typedef struct light_cue_player *light_cue_player_handle_t;
+
+    /**
+     * @brief Identifies one playback of a cue; 0 is never a valid id
+     */
+    typedef uint32_t light_cue_id_t;
+
+    /**
+     * @brief Frame rendering counters of a player
+     */
+    typedef struct
+    {
+        uint32_t frames;          ///< Frame slots with at least one cue playing
+        uint32_t render_us_total; ///< Time spent evaluating and writing those frames
+        uint32_t render_us_max;   ///< Longest single frame
+    } light_cue_stats_t;
+
+    /**
+     * @brief Cue player configuration
+     */
+    typedef struct
+    {
+        dmx_handle_t dmx_handle;  ///< Universe of the fixture, provides the frame slot tick
+        fixture_handle_t fixture; ///< Fixture to play on (or MH X25 handle)
+    } light_cue_player_config_t;
+
+    /**
+     * @brief Create a cue player for a fixture
+     *
+     * Cues only advance while continuous transmission is running.
+     *
+     * @param config Player configuration
+     * @param out_player Pointer to store the player handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory or frame slot callbacks
+     */
+    esp_err_t light_cue_player_create(const light_cue_player_config_t *config, light_cue_player_handle_t *out_player);
+
+    /**
+     * @brief Stop all cues and delete a player; the fixture keeps its last values
+     *
+     * @param player Player handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t light_cue_player_delete(light_cue_player_handle_t player);
+
+    /**
+     * @brief Start a cue on a layer, replacing the cue running there
+     *
+     * Returns immediately; the first values go out in the next frame slot.
+     *
+     * @param player Player handle
+     * @param cue Cue, must stay valid while it plays
+     * @param layer Layer (0 to LIGHT_CUE_MAX_LAYERS - 1), higher layers win
+     * @param out_id Pointer to store the playback id (may be NULL)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments or malformed cue
+     *      - ESP_ERR_NOT_SUPPORTED: Fixture lacks an attribute of the cue
+     */
+    esp_err_t light_cue_play(light_cue_player_handle_t player, const light_cue_t *cue, uint8_t layer,
+                             light_cue_id_t *out_id);
+
+    /**
+     * @brief Stop a cue; its attributes fall back to lower layers in the next frame slot
+     *
+     * Stopping a cue that has already ended is not an error.
+     *
+     * @param player Player handle
+     * @param id Playback id from light_cue_play()
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle or id
+     */
+    esp_err_t light_cue_stop(light_cue_player_handle_t player, light_cue_id_t id);
+
+    /**
+     * @brief Stop all cues of a player
+     *
+     * @param player Player handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t light_cue_stop_all(light_cue_player_handle_t player);
+
+    /**
+     * @brief Check whether a cue is still playing
+     *
+     * @param player Player handle
+     * @param id Playback id from light_cue_play()
+     * @param out_playing Pointer to store the result
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t light_cue_is_playing(light_cue_player_handle_t player, light_cue_id_t id, bool *out_playing);
+
+    /**
+     * @brief Block until a cue has ended or was stopped
+     *
+     * @param player Player handle
+     * @param id Playback id from light_cue_play()
+     * @param timeout Maximum time to wait
+     * @return
+     *      - ESP_OK: Cue is no longer playing
+     *      - ESP_ERR_INVALID_ARG: Invalid handle or id
+     *      - ESP_ERR_TIMEOUT: Still playing after timeout
+     */
+    esp_err_t light_cue_wait(light_cue_player_handle_t player, light_cue_id_t id, TickType_t timeout);
+
+    /**
+     * @brief Get the frame rendering counters
+     *
+     * @param player Player handle
+     * @param out_stats Pointer to store the counters
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t light_cue_get_stats(light_cue_player_handle_t player, light_cue_stats_t *out_stats);
+
+    /**
+     * @brief Reset the frame rendering counters
+     *
+     * @param player Player handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t light_cue_reset_stats(light_cue_player_handle_t player);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIGHT_CUE_H
@@ -9,20 +9,34 @@
 #define LIGHT_EFFECTS_H
 
 #include <stdint.h>
+#include "esp_err.h"
 #include "mh_x25_driver.h"
+#include "light_cue.h"
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+#define LIGHT_EFFECTS_LAYER_VICTORY 1 // Cue player layer of the victory animation
+
     /**
-     * @brief Play winning animation for the victor
+     * @brief Start the winning animation for the victor
+     *
+     * Returns immediately; the animation plays from the cue player's frame
+     * slot tick. When it ends, the light's channels are released to the
+     * layers below its merge source.
      *
      * @param winning_player Player number who won (1 or 2)
-     * @param light_handle Handle to MH X25 light
+     * @param player Cue player of the MH X25 effects light
+     * @param out_id Pointer to store the playback id (may be NULL)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_SUPPORTED: Light lacks a color, gobo or dimmer channel
      */
-    void play_winning_animation(uint8_t winning_player, mh_x25_handle_t light_handle);
+    esp_err_t play_winning_animation(uint8_t winning_player, light_cue_player_handle_t player,
+                                     light_cue_id_t *out_id);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,457 @@
+/**
+ * @file light_cue.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Cue list / timeline engine implementation
+ */
+
+#include "light_cue.h"
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+static const char *TAG = "light_cue";
+
+#define LIGHT_CUE_ONE 32768 // 1.0 in the Q15 interpolation phase
+
+/**
+ * @brief Cue running on one layer
+ */
+typedef struct
+{
+    const light_cue_t *cue; // NULL while the layer is idle
+    int64_t start_us;
+    uint16_t generation;    // Tells playbacks on the same layer apart
+} light_cue_layer_t;
+
+/**
+ * @brief Player state; layers are shared with the transmission task under lock
+ */
+struct light_cue_player
+{
+    dmx_handle_t dmx_handle;
+    fixture_handle_t fixture;
+    portMUX_TYPE lock;
+    light_cue_layer_t layers[LIGHT_CUE_MAX_LAYERS];
+    uint16_t generation;
+    bool holding;             // Channels written since the last release, frame slot only
+    EventGroupHandle_t ended; // Bit per layer, set when a playback on it ends
+    light_cue_stats_t stats;  // Written by the frame slot, copied under lock
+};
+
+static light_cue_id_t light_cue_make_id(uint16_t generation, uint8_t layer)
+{
+    return ((light_cue_id_t)generation << 8) | layer;
+}
+
+/**
+ * @brief Value of a track at time t within the pass
+ */
+static uint16_t light_cue_track_value(const light_cue_track_t *track, uint32_t t)
+{
+    const light_cue_pattern_t *pattern = track->pattern;
+
+    if (pattern != NULL)
+    {
+        uint32_t end_ms = pattern->start_ms + (uint32_t)pattern->steps * pattern->step_ms;
+        if (track->key_count == 0 || (t >= pattern->start_ms && t < end_ms))
+        {
+            uint32_t step = (t < pattern->start_ms) ? 0 : (t - pattern->start_ms) / pattern->step_ms;
+            if (step >= pattern->steps)
+            {
+                step = pattern->steps - 1;
+            }
+            return pattern->values[step % pattern->value_count];
+        }
+    }
+
+    const light_cue_key_t *keys = track->keys;
+    uint8_t next = 0;
+
+    while (next < track->key_count && keys[next].time_ms <= t)
+    {
+        next++;
+    }
+    if (next == 0)
+    {
+        return keys[0].value;
+    }
+    if (next == track->key_count || keys[next].interp == LIGHT_CUE_STEP)
+    {
+        return keys[next - 1].value;
+    }
+
+    const light_cue_key_t *from = &keys[next - 1];
+    const light_cue_key_t *to = &keys[next];
+    uint32_t x = ((t - from->time_ms) << 15) / (uint32_t)(to->time_ms - from->time_ms);
+
+    if (to->interp == LIGHT_CUE_EASE)
+    {
+        // Smoothstep x^2 * (3 - 2x), as in the motion planner
+        uint32_t x2 = (x * x) >> 15;
+        x = (x2 * (3 * LIGHT_CUE_ONE - 2 * x)) >> 15;
+    }
+
+    return (uint16_t)(from->value + ((((int64_t)to->value - from->value) * x) >> 15));
+}
+
+/**
+ * @brief Frame slot callback: render the running cues and retire ended ones
+ */
+static void light_cue_frame(int64_t slot_us, void *user_ctx)
+{
+    struct light_cue_player *player = (struct light_cue_player *)user_ctx;
+    light_cue_layer_t layers[LIGHT_CUE_MAX_LAYERS];
+    int64_t render_start = esp_timer_get_time();
+
+    portENTER_CRITICAL(&player->lock);
+    for (uint8_t i = 0; i < LIGHT_CUE_MAX_LAYERS; i++)
+    {
+        layers[i] = player->layers[i];
+    }
+    portEXIT_CRITICAL(&player->lock);
+
+    fixture_attr_value_t values[FIXTURE_ATTR_COUNT];
+    uint32_t claimed = 0; // Attributes already taken by a higher layer
+    uint8_t count = 0;
+    uint8_t ended = 0;
+    bool playing = false;
+
+    for (int layer = LIGHT_CUE_MAX_LAYERS - 1; layer >= 0; layer--)
+    {
+        const light_cue_t *cue = layers[layer].cue;
+        if (cue == NULL)
+        {
+            continue;
+        }
+
+        // Signed: a cue may start after the slot timestamp was taken
+        int64_t elapsed_ms = (slot_us - layers[layer].start_us) / 1000;
+        if (elapsed_ms < 0)
+        {
+            elapsed_ms = 0;
+        }
+        if (cue->passes != LIGHT_CUE_FOREVER && elapsed_ms >= (int64_t)cue->length_ms * cue->passes)
+        {
+            ended |= 1 << layer;
+            continue;
+        }
+        playing = true;
+
+        uint32_t t = (uint32_t)(elapsed_ms % cue->length_ms);
+        for (uint8_t i = 0; i < cue->track_count; i++)
+        {
+            const light_cue_track_t *track = &cue->tracks[i];
+            if (claimed & (1UL << track->attr))
+            {
+                continue;
+            }
+            claimed |= 1UL << track->attr;
+            values[count].attr = track->attr;
+            values[count].value = light_cue_track_value(track, t);
+            count++;
+        }
+    }
+
+    // Unchanged values are dropped by the fixture's shadow state
+    if (count > 0)
+    {
+        fixture_set_attrs(player->fixture, values, count);
+        player->holding = true;
+    }
+
+    if (ended != 0)
+    {
+        EventBits_t retired = 0;
+
+        portENTER_CRITICAL(&player->lock);
+        for (uint8_t i = 0; i < LIGHT_CUE_MAX_LAYERS; i++)
+        {
+            // Only retire the playback that ended, not one started meanwhile
+            if ((ended & (1 << i)) && player->layers[i].generation == layers[i].generation)
+            {
+                player->layers[i].cue = NULL;
+                retired |= 1 << i;
+            }
+        }
+        portEXIT_CRITICAL(&player->lock);
+        xEventGroupSetBits(player->ended, retired);
+    }
+
+    // Attributes of ended cues keep their last values until every layer is done
+    if (!playing && player->holding)
+    {
+        fixture_release(player->fixture);
+        player->holding = false;
+    }
+
+    if (playing)
+    {
+        uint32_t render_us = (uint32_t)(esp_timer_get_time() - render_start);
+
+        portENTER_CRITICAL(&player->lock);
+        player->stats.frames++;
+        player->stats.render_us_total += render_us;
+        if (render_us > player->stats.render_us_max)
+        {
+            player->stats.render_us_max = render_us;
+        }
+        portEXIT_CRITICAL(&player->lock);
+    }
+}
+
+/**
+ * @brief Check a cue's tables against the fixture it is played on
+ */
+static esp_err_t light_cue_validate(const struct light_cue_player *player, const light_cue_t *cue)
+{
+    if (cue->tracks == NULL || cue->track_count == 0 || cue->length_ms == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (uint8_t i = 0; i < cue->track_count; i++)
+    {
+        const light_cue_track_t *track = &cue->tracks[i];
+        const light_cue_pattern_t *pattern = track->pattern;
+        if ((unsigned)track->attr >= FIXTURE_ATTR_COUNT || (track->key_count > 0 && track->keys == NULL) ||
+            (track->key_count == 0 && pattern == NULL))
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (pattern != NULL &&
+            (pattern->values == NULL || pattern->value_count == 0 || pattern->steps == 0 || pattern->step_ms == 0))
+        {
+            ESP_LOGE(TAG, "%s: empty step pattern", cue->name);
+            return ESP_ERR_INVALID_ARG;
+        }
+        for (uint8_t k = 1; k < track->key_count; k++)
+        {
+            if (track->keys[k].time_ms < track->keys[k - 1].time_ms)
+            {
+                ESP_LOGE(TAG, "%s: keyframes out of order", cue->name);
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+
+        uint16_t value;
+        if (fixture_get_attr(player->fixture, track->attr, &value) != ESP_OK)
+        {
+            ESP_LOGE(TAG, "%s: fixture lacks attribute %d", cue->name, track->attr);
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t light_cue_player_create(const light_cue_player_config_t *config, light_cue_player_handle_t *out_player)
+{
+    if (config == NULL || config->dmx_handle == NULL || config->fixture == NULL || out_player == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct light_cue_player *player = (struct light_cue_player *)calloc(1, sizeof(struct light_cue_player));
+    if (player == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate player");
+        return ESP_ERR_NO_MEM;
+    }
+
+    player->dmx_handle = config->dmx_handle;
+    player->fixture = config->fixture;
+    player->lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+
+    player->ended = xEventGroupCreate();
+    if (player->ended == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to create event group");
+        free(player);
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t ret = dmx_add_tx_callback(player->dmx_handle, light_cue_frame, player);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "No frame slot callback left on the universe");
+        vEventGroupDelete(player->ended);
+        free(player);
+        return ret;
+    }
+
+    *out_player = player;
+    return ESP_OK;
+}
+
+esp_err_t light_cue_player_delete(light_cue_player_handle_t player)
+{
+    if (player == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dmx_remove_tx_callback(player->dmx_handle, light_cue_frame, player);
+
+    vEventGroupDelete(player->ended);
+    free(player);
+    return ESP_OK;
+}
+
+esp_err_t light_cue_play(light_cue_player_handle_t player, const light_cue_t *cue, uint8_t layer,
+                         light_cue_id_t *out_id)
+{
+    if (player == NULL || cue == NULL || layer >= LIGHT_CUE_MAX_LAYERS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = light_cue_validate(player, cue);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    portENTER_CRITICAL(&player->lock);
+    if (++player->generation == 0)
+    {
+        player->generation = 1;
+    }
+    player->layers[layer].cue = cue;
+    player->layers[layer].start_us = esp_timer_get_time();
+    player->layers[layer].generation = player->generation;
+    light_cue_id_t id = light_cue_make_id(player->generation, layer);
+    portEXIT_CRITICAL(&player->lock);
+
+    ESP_LOGD(TAG, "Playing %s on layer %d", cue->name, layer);
+
+    if (out_id != NULL)
+    {
+        *out_id = id;
+    }
+    return ESP_OK;
+}
+
+esp_err_t light_cue_stop(light_cue_player_handle_t player, light_cue_id_t id)
+{
+    uint8_t layer = id & 0xFF;
+
+    if (player == NULL || id == 0 || layer >= LIGHT_CUE_MAX_LAYERS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    bool stopped = false;
+
+    portENTER_CRITICAL(&player->lock);
+    if (player->layers[layer].cue != NULL && light_cue_make_id(player->layers[layer].generation, layer) == id)
+    {
+        player->layers[layer].cue = NULL;
+        stopped = true;
+    }
+    portEXIT_CRITICAL(&player->lock);
+
+    if (stopped)
+    {
+        xEventGroupSetBits(player->ended, 1 << layer);
+    }
+    return ESP_OK;
+}
+
+esp_err_t light_cue_stop_all(light_cue_player_handle_t player)
+{
+    if (player == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&player->lock);
+    for (uint8_t i = 0; i < LIGHT_CUE_MAX_LAYERS; i++)
+    {
+        player->layers[i].cue = NULL;
+    }
+    portEXIT_CRITICAL(&player->lock);
+
+    xEventGroupSetBits(player->ended, (1 << LIGHT_CUE_MAX_LAYERS) - 1);
+    return ESP_OK;
+}
+
+esp_err_t light_cue_is_playing(light_cue_player_handle_t player, light_cue_id_t id, bool *out_playing)
+{
+    uint8_t layer = id & 0xFF;
+
+    if (player == NULL || out_playing == NULL || id == 0 || layer >= LIGHT_CUE_MAX_LAYERS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&player->lock);
+    *out_playing = player->layers[layer].cue != NULL &&
+                   light_cue_make_id(player->layers[layer].generation, layer) == id;
+    portEXIT_CRITICAL(&player->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t light_cue_wait(light_cue_player_handle_t player, light_cue_id_t id, TickType_t timeout)
+{
+    uint8_t layer = id & 0xFF;
+
+    if (player == NULL || id == 0 || layer >= LIGHT_CUE_MAX_LAYERS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    TickType_t start = xTaskGetTickCount();
+
+    for (;;)
+    {
+        // A set bit may be left over from an earlier playback on the layer;
+        // clear it before the check, so an end after the check still wakes us
+        xEventGroupClearBits(player->ended, 1 << layer);
+
+        bool playing;
+        light_cue_is_playing(player, id, &playing);
+        if (!playing)
+        {
+            return ESP_OK;
+        }
+
+        TickType_t waited = xTaskGetTickCount() - start;
+        if (waited >= timeout)
+        {
+            return ESP_ERR_TIMEOUT;
+        }
+        xEventGroupWaitBits(player->ended, 1 << layer, pdFALSE, pdFALSE, timeout - waited);
+    }
+}
+
+esp_err_t light_cue_get_stats(light_cue_player_handle_t player, light_cue_stats_t *out_stats)
+{
+    if (player == NULL || out_stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&player->lock);
+    *out_stats = player->stats;
+    portEXIT_CRITICAL(&player->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t light_cue_reset_stats(light_cue_player_handle_t player)
+{
+    if (player == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&player->lock);
+    player->stats = (light_cue_stats_t){0};
+    portEXIT_CRITICAL(&player->lock);
+
+    return ESP_OK;
+}
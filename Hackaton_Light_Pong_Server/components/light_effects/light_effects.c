@@ -7,57 +7,105 @@
 
 #include "light_effects.h"
 #include "esp_log.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
 
 static const char *TAG = "light_effects";
 
-// Winning animation function
-void play_winning_animation(uint8_t winning_player, mh_x25_handle_t light_handle)
-{
-    ESP_LOGI(TAG, "Player %d wins - starting victory animation", winning_player);
+/*
+ * Victory animation, 9 s:
+ *   0 - 3600 ms  color chase through six colors, three times, gobo rotating
+ *   3600 - 6000  winner's color, eight gobo flashes
+ *   6000 - 9000  open gobo rotating, five slow dimmer pulses
+ *
+ * All tables are const and stay in flash; steps are patterns, so the
+ * chase and flashes cost a byte per distinct value rather than per step.
+ */
+#define VICTORY_FLASH_START_MS 3600
+#define VICTORY_PULSE_START_MS 6000
+#define VICTORY_LENGTH_MS 9000
 
-    uint8_t win_color = (winning_player == 1) ? MH_X25_COLOR_GREEN : MH_X25_COLOR_DARK_BLUE;
+static const uint8_t victory_chase_colors[] = {MH_X25_COLOR_RED, MH_X25_COLOR_GREEN, MH_X25_COLOR_DARK_BLUE,
+                                               MH_X25_COLOR_YELLOW, MH_X25_COLOR_PINK, MH_X25_COLOR_LIGHT_BLUE};
+static const light_cue_pattern_t victory_chase = LIGHT_CUE_PATTERN(0, 200, 18, victory_chase_colors);
 
-    for (int cycle = 0; cycle < 3; cycle++)
-    {
-        uint8_t colors[] = {MH_X25_COLOR_RED, MH_X25_COLOR_GREEN, MH_X25_COLOR_DARK_BLUE,
-                            MH_X25_COLOR_YELLOW, MH_X25_COLOR_PINK, MH_X25_COLOR_LIGHT_BLUE};
-
-        for (int i = 0; i < 6; i++)
-        {
-            mh_x25_set_color(light_handle, colors[i]);
-            mh_x25_set_gobo_rotation(light_handle, 200);
-            vTaskDelay(pdMS_TO_TICKS(200));
-        }
-    }
+static const uint8_t victory_gobos[] = {MH_X25_GOBO_2, MH_X25_GOBO_3, MH_X25_GOBO_4, MH_X25_GOBO_5};
+static const light_cue_pattern_t victory_gobo_steps = LIGHT_CUE_PATTERN(VICTORY_FLASH_START_MS, 300, 8, victory_gobos);
 
-    mh_x25_set_color(light_handle, win_color);
-    mh_x25_set_gobo_rotation(light_handle, 0);
+// Flashes: on for half of each gobo step
+static const uint8_t victory_strobe_levels[] = {MH_X25_DIMMER_FULL, MH_X25_DIMMER_OFF};
+static const light_cue_pattern_t victory_strobe = LIGHT_CUE_PATTERN(VICTORY_FLASH_START_MS, 150, 16,
+                                                                    victory_strobe_levels);
 
-    for (int i = 0; i < 8; i++)
-    {
-        mh_x25_set_gobo(light_handle, (i % 4) + 1);
-        mh_x25_set_dimmer(light_handle, MH_X25_DIMMER_FULL);
-        vTaskDelay(pdMS_TO_TICKS(150));
-        mh_x25_set_dimmer(light_handle, 0);
-        vTaskDelay(pdMS_TO_TICKS(150));
-    }
+static const light_cue_key_t victory_color_p1[] = {
+    LIGHT_CUE_KEY(VICTORY_FLASH_START_MS, MH_X25_COLOR_GREEN),
+};
+
+static const light_cue_key_t victory_color_p2[] = {
+    LIGHT_CUE_KEY(VICTORY_FLASH_START_MS, MH_X25_COLOR_DARK_BLUE),
+};
+
+static const light_cue_key_t victory_gobo_rotation[] = {
+    LIGHT_CUE_KEY(0, 200),
+    LIGHT_CUE_KEY(VICTORY_FLASH_START_MS, 0),
+    LIGHT_CUE_KEY(VICTORY_PULSE_START_MS, 200),
+};
 
-    mh_x25_set_gobo(light_handle, MH_X25_GOBO_OPEN);
-    mh_x25_set_gobo_rotation(light_handle, 200);
-    for (int i = 0; i < 5; i++)
+static const light_cue_key_t victory_gobo[] = {
+    LIGHT_CUE_KEY(0, MH_X25_GOBO_OPEN),
+};
+
+static const light_cue_key_t victory_dimmer[] = {
+    LIGHT_CUE_KEY(0, MH_X25_DIMMER_FULL),
+    // Pulses: eased up and down in 300 ms each
+    LIGHT_CUE_KEY(VICTORY_PULSE_START_MS, MH_X25_DIMMER_OFF),
+    LIGHT_CUE_FADE(6300, MH_X25_DIMMER_FULL),
+    LIGHT_CUE_FADE(6600, MH_X25_DIMMER_OFF),
+    LIGHT_CUE_FADE(6900, MH_X25_DIMMER_FULL),
+    LIGHT_CUE_FADE(7200, MH_X25_DIMMER_OFF),
+    LIGHT_CUE_FADE(7500, MH_X25_DIMMER_FULL),
+    LIGHT_CUE_FADE(7800, MH_X25_DIMMER_OFF),
+    LIGHT_CUE_FADE(8100, MH_X25_DIMMER_FULL),
+    LIGHT_CUE_FADE(8400, MH_X25_DIMMER_OFF),
+    LIGHT_CUE_FADE(8700, MH_X25_DIMMER_FULL),
+    LIGHT_CUE_FADE(9000, MH_X25_DIMMER_OFF),
+};
+
+static const light_cue_track_t victory_tracks_p1[] = {
+    LIGHT_CUE_MIXED_TRACK(FIXTURE_ATTR_COLOR, victory_color_p1, victory_chase),
+    LIGHT_CUE_MIXED_TRACK(FIXTURE_ATTR_GOBO, victory_gobo, victory_gobo_steps),
+    LIGHT_CUE_TRACK(FIXTURE_ATTR_GOBO_ROTATION, victory_gobo_rotation),
+    LIGHT_CUE_MIXED_TRACK(FIXTURE_ATTR_DIMMER, victory_dimmer, victory_strobe),
+};
+
+static const light_cue_track_t victory_tracks_p2[] = {
+    LIGHT_CUE_MIXED_TRACK(FIXTURE_ATTR_COLOR, victory_color_p2, victory_chase),
+    LIGHT_CUE_MIXED_TRACK(FIXTURE_ATTR_GOBO, victory_gobo, victory_gobo_steps),
+    LIGHT_CUE_TRACK(FIXTURE_ATTR_GOBO_ROTATION, victory_gobo_rotation),
+    LIGHT_CUE_MIXED_TRACK(FIXTURE_ATTR_DIMMER, victory_dimmer, victory_strobe),
+};
+
+static const light_cue_t victory_cue_p1 = {
+    .name = "victory_p1",
+    .tracks = victory_tracks_p1,
+    .track_count = sizeof(victory_tracks_p1) / sizeof(victory_tracks_p1[0]),
+    .length_ms = VICTORY_LENGTH_MS,
+    .passes = 1};
+
+static const light_cue_t victory_cue_p2 = {
+    .name = "victory_p2",
+    .tracks = victory_tracks_p2,
+    .track_count = sizeof(victory_tracks_p2) / sizeof(victory_tracks_p2[0]),
+    .length_ms = VICTORY_LENGTH_MS,
+    .passes = 1};
+
+esp_err_t play_winning_animation(uint8_t winning_player, light_cue_player_handle_t player, light_cue_id_t *out_id)
+{
+    if (player == NULL)
     {
-        mh_x25_set_dimmer(light_handle, MH_X25_DIMMER_FULL);
-        vTaskDelay(pdMS_TO_TICKS(300));
-        mh_x25_set_dimmer(light_handle, 0);
-        vTaskDelay(pdMS_TO_TICKS(300));
+        return ESP_ERR_INVALID_ARG;
     }
 
-    mh_x25_set_dimmer(light_handle, MH_X25_DIMMER_FULL);
-    mh_x25_set_color(light_handle, MH_X25_COLOR_WHITE);
-    mh_x25_set_gobo(light_handle, MH_X25_GOBO_OPEN);
-    mh_x25_set_gobo_rotation(light_handle, 0);
+    ESP_LOGI(TAG, "Player %d wins - starting victory animation", winning_player);
 
-    ESP_LOGI(TAG, "Victory animation complete, resetting game");
+    const light_cue_t *cue = (winning_player == 1) ? &victory_cue_p1 : &victory_cue_p2;
+    return light_cue_play(player, cue, LIGHT_EFFECTS_LAYER_VICTORY, out_id);
 }
@@ -20,6 +20,9 @@
  * - Channel 10: Gobo Rotation
  * - Channel 11: Special Functions
  * - Channel 12: Built-in Programs
+ *
+ * The layout is defined by fixture_profile_mh_x25; an MH X25 handle is a
+ * fixture handle and can be passed to the fixture_* calls as well.
  */
 
 #ifndef MH_X25_H
@@ -28,6 +31,9 @@
 #include <stdint.h>
 #include "esp_err.h"
 #include "dmx_driver.h"
+#include "dmx_merge.h"
+#include "dmx_fade.h"
+#include "fixture.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -114,13 +120,22 @@ extern "C"
 #define MH_X25_SPECIAL_RESET_GOBO_ROT 132       // 128-135 Gobo rotation reset
 #define MH_X25_SPECIAL_RESET_ALL 156            // 152-159 All channel reset
 
+/* Pan/Tilt Dynamics at MH_X25_SPEED_FAST for fixture_motion (16-bit units,
+   540° pan / 270° tilt over 0-65535), estimated from the datasheet */
+#define MH_X25_PAN_VELOCITY 30000  // ~250°/s
+#define MH_X25_TILT_VELOCITY 45000 // ~185°/s
+#define MH_X25_PAN_ACCEL 120000    // Full speed after ~250 ms
+#define MH_X25_TILT_ACCEL 180000   // Full speed after ~250 ms
+#define MH_X25_MOTION_LATENCY_MS 30
+
     /**
      * @brief MH X25 Device Configuration
      */
     typedef struct
     {
-        dmx_handle_t dmx_handle; ///< DMX driver handle
-        uint16_t start_channel;  ///< DMX start channel (1-501, allows for 12 channels)
+        dmx_handle_t dmx_handle;    ///< DMX driver handle
+        dmx_source_handle_t source; ///< Optional merge source to write through (NULL = direct)
+        uint16_t start_channel;     ///< DMX start channel (1-501, allows for 12 channels)
     } mh_x25_config_t;
 
     /**
@@ -153,6 +168,8 @@ extern "C"
     /**
      * @brief Set pan (horizontal rotation) position using 8-bit value
      *
+     * The fine channel is set to 0.
+     *
      * @param handle Device handle
      * @param pan Pan value (0-255, maps to 0° to max pan range)
      * @return
@@ -164,6 +181,8 @@ extern "C"
     /**
      * @brief Set tilt (vertical inclination) position using 8-bit value
      *
+     * The fine channel is set to 0.
+     *
      * @param handle Device handle
      * @param tilt Tilt value (0-255, maps to 0° to max tilt range)
      * @return
@@ -175,6 +194,8 @@ extern "C"
     /**
      * @brief Set both pan and tilt together using 8-bit values
      *
+     * The fine channel is set to 0.
+     *
      * @param handle Device handle
      * @param pan Pan value (0-255)
      * @param tilt Tilt value (0-255)
@@ -240,6 +261,23 @@ extern "C"
      */
     esp_err_t mh_x25_set_dimmer(mh_x25_handle_t handle, uint8_t dimmer);
 
+    /**
+     * @brief Fade the dimmer to a level inside the DMX frame loop
+     *
+     * Returns immediately; the driver interpolates once per DMX frame.
+     *
+     * @param handle Device handle
+     * @param dimmer Target dimmer level (0-255)
+     * @param duration_ms Fade time in milliseconds
+     * @param curve Fade curve
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Fade pool full
+     */
+    esp_err_t mh_x25_fade_dimmer(mh_x25_handle_t handle, uint8_t dimmer, uint32_t duration_ms,
+                                 dmx_fade_curve_t curve);
+
     /**
      * @brief Set gobo wheel position
      *
@@ -283,6 +321,33 @@ extern "C"
      */
     esp_err_t mh_x25_off(mh_x25_handle_t handle);
 
+    /**
+     * @brief Release all fixture channels of the merge source
+     *
+     * Lower priority sources take over the fixture again.
+     *
+     * @param handle Device handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     *      - ESP_ERR_INVALID_STATE: Device was not configured with a merge source
+     */
+    esp_err_t mh_x25_release(mh_x25_handle_t handle);
+
+    /**
+     * @brief Get how many channel writes reached the universe and how many were skipped
+     *
+     * Setters compare against the last written values and only touch the
+     * universe for channels that changed.
+     *
+     * @param handle Device handle
+     * @param out_stats Pointer to store the counters
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t mh_x25_get_write_stats(mh_x25_handle_t handle, fixture_write_stats_t *out_stats);
+
 #ifdef __cplusplus
 }
 #endif
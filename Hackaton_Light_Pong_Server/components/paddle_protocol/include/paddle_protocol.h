@@ -0,0 +1,138 @@
+/**
+ * @file paddle_protocol.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Compact paddle input wire format shared by paddles and server
+ *
+ * Replaces the float based input_event_t with a versioned little-endian
+ * frame: a 7 byte header with bit-packed buttons and a sequence number,
+ * followed by up to PADDLE_PROTO_MAX_SAMPLES IMU samples of six int16
+ * fixed-point values each. A paddle can thereby batch the samples taken
+ * since its last frame. The layout does not depend on compiler struct
+ * packing or the host's byte order.
+ *
+ * Frame layout:
+ *      0       Message type, PADDLE_PROTO_MSG_TYPE
+ *      1       Version (high nibble) | sample count (low nibble)
+ *      2       Buttons (PADDLE_PROTO_BTN_*)
+ *      3       Player ID assigned by the server
+ *      4-5     Sequence number
+ *      6       Sample period in ms, oldest sample first
+ *      7-      Samples: ax, ay, az, gx, gy, gz
+ */
+
+#ifndef PADDLE_PROTOCOL_H
+#define PADDLE_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PADDLE_PROTO_MSG_TYPE 5    // Message type byte, follows the espnow_handler message types
+#define PADDLE_PROTO_VERSION 1     // Version written by the encoder and accepted by the decoder
+#define PADDLE_PROTO_MAX_SAMPLES 8 // IMU samples per frame
+#define PADDLE_PROTO_HEADER_SIZE 7
+#define PADDLE_PROTO_SAMPLE_SIZE 12
+#define PADDLE_PROTO_MAX_SIZE (PADDLE_PROTO_HEADER_SIZE + PADDLE_PROTO_MAX_SAMPLES * PADDLE_PROTO_SAMPLE_SIZE)
+
+#define PADDLE_PROTO_BTN_RIGHT (1 << 0) // Set where input_event_t had btn_right_pressed != 0
+#define PADDLE_PROTO_BTN_LEFT (1 << 1)  // Set where input_event_t had btn_left_pressed != 0
+
+#define PADDLE_PROTO_ACCEL_PER_G 2048 // Accelerometer LSB per g, +-16 g
+#define PADDLE_PROTO_GYRO_PER_DPS 16  // Gyroscope LSB per deg/s, +-2048 deg/s
+
+    /**
+     * @brief One IMU sample in fixed point
+     */
+    typedef struct
+    {
+        int16_t ax, ay, az; ///< Acceleration in 1/PADDLE_PROTO_ACCEL_PER_G g
+        int16_t gx, gy, gz; ///< Rotation rate in 1/PADDLE_PROTO_GYRO_PER_DPS deg/s
+    } paddle_proto_sample_t;
+
+    /**
+     * @brief Decoded paddle frame
+     */
+    typedef struct
+    {
+        uint8_t player_id;        ///< Player ID assigned by the server, 0 before registration
+        uint8_t buttons;          ///< PADDLE_PROTO_BTN_* bits
+        uint16_t seq;             ///< Incremented by the paddle for every frame
+        uint8_t sample_period_ms; ///< Time between the samples
+        uint8_t sample_count;     ///< Samples in the frame (0 to PADDLE_PROTO_MAX_SAMPLES)
+        paddle_proto_sample_t samples[PADDLE_PROTO_MAX_SAMPLES]; ///< Oldest first
+    } paddle_proto_frame_t;
+
+    /**
+     * @brief Encode a frame
+     *
+     * @param frame Frame to encode
+     * @param buf Output buffer, PADDLE_PROTO_MAX_SIZE always suffices
+     * @param buf_size Size of the output buffer
+     * @param out_len Pointer to store the encoded length
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments or too many samples
+     *      - ESP_ERR_INVALID_SIZE: Buffer too small
+     */
+    esp_err_t paddle_proto_encode(const paddle_proto_frame_t *frame, uint8_t *buf, size_t buf_size, size_t *out_len);
+
+    /**
+     * @brief Decode a frame
+     *
+     * Bytes after the last sample are ignored, so later versions can append
+     * fields without breaking this decoder.
+     *
+     * @param buf Received bytes, starting with the message type
+     * @param len Number of received bytes
+     * @param out_frame Pointer to store the decoded frame
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments, wrong message type or too many samples
+     *      - ESP_ERR_INVALID_SIZE: Frame shorter than its header announces
+     *      - ESP_ERR_NOT_SUPPORTED: Unknown version
+     */
+    esp_err_t paddle_proto_decode(const uint8_t *buf, size_t len, paddle_proto_frame_t *out_frame);
+
+    /**
+     * @brief Convert an acceleration to fixed point, saturating
+     *
+     * @param g Acceleration in g
+     * @return Fixed-point value
+     */
+    int16_t paddle_proto_accel_from_g(float g);
+
+    /**
+     * @brief Convert a rotation rate to fixed point, saturating
+     *
+     * @param dps Rotation rate in deg/s
+     * @return Fixed-point value
+     */
+    int16_t paddle_proto_gyro_from_dps(float dps);
+
+    /**
+     * @brief Convert a fixed-point acceleration to g
+     */
+    static inline float paddle_proto_accel_to_g(int16_t value)
+    {
+        return (float)value / PADDLE_PROTO_ACCEL_PER_G;
+    }
+
+    /**
+     * @brief Convert a fixed-point rotation rate to deg/s
+     */
+    static inline float paddle_proto_gyro_to_dps(int16_t value)
+    {
+        return (float)value / PADDLE_PROTO_GYRO_PER_DPS;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PADDLE_PROTOCOL_H
@@ -0,0 +1,134 @@
+/**
+ * @file paddle_protocol.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Compact paddle input wire format implementation
+ */
+
+#include "paddle_protocol.h"
+
+static inline void paddle_proto_put16(uint8_t *p, int16_t value)
+{
+    p[0] = (uint8_t)((uint16_t)value);
+    p[1] = (uint8_t)((uint16_t)value >> 8);
+}
+
+static inline int16_t paddle_proto_get16(const uint8_t *p)
+{
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief Round and saturate a scaled value to int16
+ */
+static int16_t paddle_proto_quantize(float scaled)
+{
+    if (scaled != scaled)
+    {
+        return 0; // NaN from a failed sensor read
+    }
+    if (scaled >= INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (scaled <= INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+int16_t paddle_proto_accel_from_g(float g)
+{
+    return paddle_proto_quantize(g * PADDLE_PROTO_ACCEL_PER_G);
+}
+
+int16_t paddle_proto_gyro_from_dps(float dps)
+{
+    return paddle_proto_quantize(dps * PADDLE_PROTO_GYRO_PER_DPS);
+}
+
+esp_err_t paddle_proto_encode(const paddle_proto_frame_t *frame, uint8_t *buf, size_t buf_size, size_t *out_len)
+{
+    if (frame == NULL || buf == NULL || out_len == NULL || frame->sample_count > PADDLE_PROTO_MAX_SAMPLES)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t len = PADDLE_PROTO_HEADER_SIZE + (size_t)frame->sample_count * PADDLE_PROTO_SAMPLE_SIZE;
+    if (buf_size < len)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    buf[0] = PADDLE_PROTO_MSG_TYPE;
+    buf[1] = (uint8_t)((PADDLE_PROTO_VERSION << 4) | frame->sample_count);
+    buf[2] = frame->buttons;
+    buf[3] = frame->player_id;
+    buf[4] = (uint8_t)frame->seq;
+    buf[5] = (uint8_t)(frame->seq >> 8);
+    buf[6] = frame->sample_period_ms;
+
+    uint8_t *p = buf + PADDLE_PROTO_HEADER_SIZE;
+    for (uint8_t i = 0; i < frame->sample_count; i++)
+    {
+        const paddle_proto_sample_t *s = &frame->samples[i];
+        paddle_proto_put16(p + 0, s->ax);
+        paddle_proto_put16(p + 2, s->ay);
+        paddle_proto_put16(p + 4, s->az);
+        paddle_proto_put16(p + 6, s->gx);
+        paddle_proto_put16(p + 8, s->gy);
+        paddle_proto_put16(p + 10, s->gz);
+        p += PADDLE_PROTO_SAMPLE_SIZE;
+    }
+
+    *out_len = len;
+    return ESP_OK;
+}
+
+esp_err_t paddle_proto_decode(const uint8_t *buf, size_t len, paddle_proto_frame_t *out_frame)
+{
+    if (buf == NULL || out_frame == NULL || len < 1 || buf[0] != PADDLE_PROTO_MSG_TYPE)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (len < PADDLE_PROTO_HEADER_SIZE)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if ((buf[1] >> 4) != PADDLE_PROTO_VERSION)
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    uint8_t count = buf[1] & 0x0F;
+    if (count > PADDLE_PROTO_MAX_SAMPLES)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (len < PADDLE_PROTO_HEADER_SIZE + (size_t)count * PADDLE_PROTO_SAMPLE_SIZE)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    out_frame->sample_count = count;
+    out_frame->buttons = buf[2];
+    out_frame->player_id = buf[3];
+    out_frame->seq = (uint16_t)(buf[4] | (buf[5] << 8));
+    out_frame->sample_period_ms = buf[6];
+
+    const uint8_t *p = buf + PADDLE_PROTO_HEADER_SIZE;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        paddle_proto_sample_t *s = &out_frame->samples[i];
+        s->ax = paddle_proto_get16(p + 0);
+        s->ay = paddle_proto_get16(p + 2);
+        s->az = paddle_proto_get16(p + 4);
+        s->gx = paddle_proto_get16(p + 6);
+        s->gy = paddle_proto_get16(p + 8);
+        s->gz = paddle_proto_get16(p + 10);
+        p += PADDLE_PROTO_SAMPLE_SIZE;
+    }
+
+    return ESP_OK;
+}
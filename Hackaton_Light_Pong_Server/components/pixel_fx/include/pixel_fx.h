@@ -0,0 +1,186 @@
+/**
+ * @file pixel_fx.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Procedural pixel effect renderer with DMX and LED strip outputs
+ *
+ * Renders chase, rainbow, noise and wave patterns into an RGB framebuffer
+ * using only integer math (sine, hue and gamma come from 256 entry tables),
+ * then maps ranges of that framebuffer onto DMX channels or led_strip
+ * pixels. The same effect can thereby drive RGB fixtures on the universe and
+ * a WS2812 strip at once. Rendering is caller driven: call pixel_fx_render()
+ * once per frame, then write the outputs, all from the same task.
+ */
+
+#ifndef PIXEL_FX_H
+#define PIXEL_FX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "dmx_driver.h"
+#include "dmx_merge.h"
+#include "led_strip.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PIXEL_FX_MAX_PIXELS 1024 // Largest framebuffer
+
+    /**
+     * @brief Procedural effects
+     */
+    typedef enum
+    {
+        PIXEL_FX_OFF = 0, ///< All pixels black
+        PIXEL_FX_CHASE,   ///< Head with a fading tail running along the pixels
+        PIXEL_FX_RAINBOW, ///< Hue gradient scrolling along the pixels
+        PIXEL_FX_NOISE,   ///< Smooth value noise drifting over time
+        PIXEL_FX_WAVE,    ///< Sine brightness wave travelling along the pixels
+    } pixel_fx_effect_t;
+
+    /**
+     * @brief One pixel
+     */
+    typedef struct
+    {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    } pixel_fx_rgb_t;
+
+    /**
+     * @brief Effect parameters
+     */
+    typedef struct
+    {
+        pixel_fx_effect_t effect; ///< Effect to render
+        pixel_fx_rgb_t color;     ///< Color of chase, noise and wave (rainbow ignores it)
+        uint16_t speed;           ///< Chase: pixels/s; others: 1/256 cycles/s
+        uint8_t scale;            ///< Chase: tail length in pixels; others: 1/256 cycles per pixel
+        uint8_t brightness;       ///< Master level, 255 = full
+    } pixel_fx_params_t;
+
+    /**
+     * @brief Channel layout of a DMX mapping
+     */
+    typedef enum
+    {
+        PIXEL_FX_LAYOUT_RGB = 0,   ///< Three channels per pixel
+        PIXEL_FX_LAYOUT_INTENSITY, ///< One channel per pixel carrying its luma (dimmers)
+    } pixel_fx_layout_t;
+
+    /**
+     * @brief Mapping of a framebuffer range onto DMX channels
+     */
+    typedef struct
+    {
+        dmx_handle_t dmx_handle;    ///< DMX driver handle
+        dmx_source_handle_t source; ///< Optional merge source to write through (NULL = direct)
+        uint16_t start_channel;     ///< First DMX channel
+        uint16_t first_pixel;       ///< First framebuffer pixel
+        uint16_t pixel_count;       ///< Pixels to map
+        pixel_fx_layout_t layout;   ///< Channels per pixel
+        bool gamma;                 ///< Apply gamma 2.2, off for fixtures with their own dimmer curve
+    } pixel_fx_dmx_map_t;
+
+    /**
+     * @brief Pixel effect renderer handle
+     */
+    typedef struct pixel_fx *pixel_fx_handle_t;
+
+    /**
+     * @brief Create a renderer with a framebuffer of pixel_count pixels
+     *
+     * Starts with PIXEL_FX_OFF.
+     *
+     * @param pixel_count Framebuffer size (1-PIXEL_FX_MAX_PIXELS)
+     * @param out_fx Pointer to store the renderer handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NO_MEM: Out of memory
+     */
+    esp_err_t pixel_fx_create(uint16_t pixel_count, pixel_fx_handle_t *out_fx);
+
+    /**
+     * @brief Delete a renderer
+     *
+     * @param fx Renderer handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t pixel_fx_delete(pixel_fx_handle_t fx);
+
+    /**
+     * @brief Select the effect and its parameters for the next renders
+     *
+     * @param fx Renderer handle
+     * @param params Effect parameters
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t pixel_fx_set_params(pixel_fx_handle_t fx, const pixel_fx_params_t *params);
+
+    /**
+     * @brief Render the effect at a point in time into the framebuffer
+     *
+     * @param fx Renderer handle
+     * @param time_ms Effect time, e.g. esp_timer time in ms; only differences matter
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid handle
+     */
+    esp_err_t pixel_fx_render(pixel_fx_handle_t fx, uint32_t time_ms);
+
+    /**
+     * @brief Get the framebuffer
+     *
+     * @param fx Renderer handle
+     * @param out_pixels Pointer to store the framebuffer, valid until pixel_fx_delete()
+     * @param out_count Pointer to store the number of pixels (may be NULL)
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     */
+    esp_err_t pixel_fx_get_pixels(pixel_fx_handle_t fx, const pixel_fx_rgb_t **out_pixels, uint16_t *out_count);
+
+    /**
+     * @brief Write a framebuffer range to DMX channels in one update
+     *
+     * @param fx Renderer handle
+     * @param map Mapping
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments or range outside the framebuffer
+     *      - Others: Error from the DMX driver
+     */
+    esp_err_t pixel_fx_write_dmx(pixel_fx_handle_t fx, const pixel_fx_dmx_map_t *map);
+
+    /**
+     * @brief Write a framebuffer range to an LED strip and refresh it
+     *
+     * Gamma corrected. Blocks while the strip is being refreshed, so call it
+     * from the task that renders, not from a DMX frame slot callback.
+     *
+     * @param fx Renderer handle
+     * @param strip LED strip handle
+     * @param first_pixel First framebuffer pixel, written to strip index 0
+     * @param pixel_count Pixels to write
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments or range outside the framebuffer
+     *      - Others: Error from the LED strip driver
+     */
+    esp_err_t pixel_fx_write_strip(pixel_fx_handle_t fx, led_strip_handle_t strip, uint16_t first_pixel,
+                                   uint16_t pixel_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PIXEL_FX_H
@@ -0,0 +1,383 @@
+/**
+ * @file pixel_fx.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Procedural pixel effect renderer implementation
+ */
+
+#include "pixel_fx.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+
+static const char *TAG = "PIXEL_FX";
+
+#define PIXEL_FX_HASH_SEED 0x9E3779B1u
+
+/**
+ * @brief Renderer state; render and write from the same task
+ */
+struct pixel_fx
+{
+    uint16_t pixel_count;
+    pixel_fx_params_t params;
+    pixel_fx_rgb_t *pixels;
+    uint8_t scratch[DMX_UNIVERSE_SIZE]; // Channel values of one DMX write
+};
+
+// 128 + 127 * sin(2 * pi * i / 256)
+static const uint8_t pixel_fx_sin8[256] = {
+    128, 131, 134, 137, 140, 144, 147, 150, 153, 156, 159, 162, 165, 168, 171, 174,
+    177, 179, 182, 185, 188, 191, 193, 196, 199, 201, 204, 206, 209, 211, 213, 216,
+    218, 220, 222, 224, 226, 228, 230, 232, 234, 235, 237, 239, 240, 241, 243, 244,
+    245, 246, 248, 249, 250, 250, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+    255, 255, 255, 255, 254, 254, 254, 253, 253, 252, 251, 250, 250, 249, 248, 246,
+    245, 244, 243, 241, 240, 239, 237, 235, 234, 232, 230, 228, 226, 224, 222, 220,
+    218, 216, 213, 211, 209, 206, 204, 201, 199, 196, 193, 191, 188, 185, 182, 179,
+    177, 174, 171, 168, 165, 162, 159, 156, 153, 150, 147, 144, 140, 137, 134, 131,
+    128, 125, 122, 119, 116, 112, 109, 106, 103, 100,  97,  94,  91,  88,  85,  82,
+     79,  77,  74,  71,  68,  65,  63,  60,  57,  55,  52,  50,  47,  45,  43,  40,
+     38,  36,  34,  32,  30,  28,  26,  24,  22,  21,  19,  17,  16,  15,  13,  12,
+     11,  10,   8,   7,   6,   6,   5,   4,   3,   3,   2,   2,   2,   1,   1,   1,
+      1,   1,   1,   1,   2,   2,   2,   3,   3,   4,   5,   6,   6,   7,   8,  10,
+     11,  12,  13,  15,  16,  17,  19,  21,  22,  24,  26,  28,  30,  32,  34,  36,
+     38,  40,  43,  45,  47,  50,  52,  55,  57,  60,  63,  65,  68,  71,  74,  77,
+     79,  82,  85,  88,  91,  94,  97, 100, 103, 106, 109, 112, 116, 119, 122, 125,
+};
+
+// 255 * (i / 255)^2.2
+static const uint8_t pixel_fx_gamma8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+/**
+ * @brief Scale a value by a level, 255 keeps it unchanged
+ */
+static inline uint8_t pixel_fx_scale8(uint8_t value, uint8_t level)
+{
+    return (uint8_t)(((uint16_t)value * (uint16_t)(level + 1)) >> 8);
+}
+
+/**
+ * @brief Color scaled by a level
+ */
+static inline pixel_fx_rgb_t pixel_fx_dim(pixel_fx_rgb_t color, uint8_t level)
+{
+    pixel_fx_rgb_t out = {
+        pixel_fx_scale8(color.r, level),
+        pixel_fx_scale8(color.g, level),
+        pixel_fx_scale8(color.b, level),
+    };
+    return out;
+}
+
+/**
+ * @brief Fully saturated color of a hue (0-255 is one turn of the color wheel)
+ */
+static pixel_fx_rgb_t pixel_fx_hue(uint8_t hue)
+{
+    uint16_t pos = (uint16_t)hue * 6;
+    uint8_t up = (uint8_t)pos;
+    uint8_t down = 255 - up;
+    pixel_fx_rgb_t out;
+
+    switch (pos >> 8)
+    {
+    case 0:
+        out = (pixel_fx_rgb_t){255, up, 0};
+        break;
+    case 1:
+        out = (pixel_fx_rgb_t){down, 255, 0};
+        break;
+    case 2:
+        out = (pixel_fx_rgb_t){0, 255, up};
+        break;
+    case 3:
+        out = (pixel_fx_rgb_t){0, down, 255};
+        break;
+    case 4:
+        out = (pixel_fx_rgb_t){up, 0, 255};
+        break;
+    default:
+        out = (pixel_fx_rgb_t){255, 0, down};
+        break;
+    }
+
+    return out;
+}
+
+/**
+ * @brief Pseudo random lattice value of the noise field
+ */
+static inline uint8_t pixel_fx_lattice(uint32_t x, uint32_t y)
+{
+    uint32_t h = (x * 0x27D4EB2Du) ^ (y * 0x165667B1u) ^ PIXEL_FX_HASH_SEED;
+    h ^= h >> 15;
+    h *= 0x85EBCA77u;
+    h ^= h >> 13;
+    return (uint8_t)(h >> 24);
+}
+
+/**
+ * @brief Smoothstep of a fraction in 1/256, 3f^2 - 2f^3
+ */
+static inline uint32_t pixel_fx_smooth(uint32_t frac)
+{
+    return (frac * frac * (768 - 2 * frac)) >> 16;
+}
+
+/**
+ * @brief Value noise at a point in 1/256 lattice units
+ */
+static uint8_t pixel_fx_noise(uint32_t x, uint32_t y)
+{
+    uint32_t xi = x >> 8;
+    uint32_t yi = y >> 8;
+    int32_t fx = (int32_t)pixel_fx_smooth(x & 0xFF);
+    int32_t fy = (int32_t)pixel_fx_smooth(y & 0xFF);
+
+    int32_t a = pixel_fx_lattice(xi, yi);
+    int32_t b = pixel_fx_lattice(xi + 1, yi);
+    int32_t c = pixel_fx_lattice(xi, yi + 1);
+    int32_t d = pixel_fx_lattice(xi + 1, yi + 1);
+
+    int32_t top = a + (((b - a) * fx) >> 8);
+    int32_t bottom = c + (((d - c) * fx) >> 8);
+
+    return (uint8_t)(top + (((bottom - top) * fy) >> 8));
+}
+
+static void pixel_fx_render_chase(pixel_fx_handle_t fx, pixel_fx_rgb_t color, uint32_t time_ms)
+{
+    const pixel_fx_params_t *p = &fx->params;
+    // Head position in 1/256 pixels, wrapped to the framebuffer
+    uint32_t span = (uint32_t)fx->pixel_count << 8;
+    uint32_t head = (uint32_t)(((uint64_t)time_ms * p->speed * 256 / 1000) % span);
+    uint32_t tail = ((uint32_t)p->scale + 1) << 8;
+    uint32_t recip = (255u << 16) / tail;
+
+    for (uint16_t i = 0; i < fx->pixel_count; i++)
+    {
+        // Distance behind the head, wrapping around the end
+        uint32_t pos = (uint32_t)i << 8;
+        uint32_t behind = (head >= pos) ? head - pos : head + span - pos;
+
+        if (behind < tail)
+        {
+            fx->pixels[i] = pixel_fx_dim(color, (uint8_t)(255 - ((behind * recip) >> 16)));
+        }
+        else
+        {
+            fx->pixels[i] = (pixel_fx_rgb_t){0, 0, 0};
+        }
+    }
+}
+
+esp_err_t pixel_fx_create(uint16_t pixel_count, pixel_fx_handle_t *out_fx)
+{
+    if (pixel_count == 0 || pixel_count > PIXEL_FX_MAX_PIXELS || out_fx == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct pixel_fx *fx = (struct pixel_fx *)calloc(1, sizeof(struct pixel_fx));
+    if (fx == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate renderer");
+        return ESP_ERR_NO_MEM;
+    }
+
+    fx->pixels = (pixel_fx_rgb_t *)calloc(pixel_count, sizeof(pixel_fx_rgb_t));
+    if (fx->pixels == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate %u pixels", pixel_count);
+        free(fx);
+        return ESP_ERR_NO_MEM;
+    }
+
+    fx->pixel_count = pixel_count;
+    fx->params.effect = PIXEL_FX_OFF;
+    fx->params.brightness = 255;
+
+    *out_fx = fx;
+    return ESP_OK;
+}
+
+esp_err_t pixel_fx_delete(pixel_fx_handle_t fx)
+{
+    if (fx == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    free(fx->pixels);
+    free(fx);
+    return ESP_OK;
+}
+
+esp_err_t pixel_fx_set_params(pixel_fx_handle_t fx, const pixel_fx_params_t *params)
+{
+    if (fx == NULL || params == NULL || params->effect > PIXEL_FX_WAVE)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    fx->params = *params;
+    return ESP_OK;
+}
+
+esp_err_t pixel_fx_render(pixel_fx_handle_t fx, uint32_t time_ms)
+{
+    if (fx == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const pixel_fx_params_t *p = &fx->params;
+    pixel_fx_rgb_t color = pixel_fx_dim(p->color, p->brightness);
+    // Animation phase and per-pixel step in 1/65536 cycles
+    uint32_t phase = (uint32_t)((uint64_t)time_ms * p->speed * 256 / 1000);
+    uint32_t step = (uint32_t)p->scale << 8;
+
+    switch (p->effect)
+    {
+    case PIXEL_FX_CHASE:
+        pixel_fx_render_chase(fx, color, time_ms);
+        break;
+
+    case PIXEL_FX_RAINBOW:
+        for (uint16_t i = 0; i < fx->pixel_count; i++)
+        {
+            uint8_t hue = (uint8_t)((phase + i * step) >> 8);
+            fx->pixels[i] = pixel_fx_dim(pixel_fx_hue(hue), p->brightness);
+        }
+        break;
+
+    case PIXEL_FX_NOISE:
+        // Pixels sample along x, time drifts along y
+        for (uint16_t i = 0; i < fx->pixel_count; i++)
+        {
+            uint8_t level = pixel_fx_noise((i * step) >> 8, phase >> 8);
+            fx->pixels[i] = pixel_fx_dim(color, level);
+        }
+        break;
+
+    case PIXEL_FX_WAVE:
+        for (uint16_t i = 0; i < fx->pixel_count; i++)
+        {
+            uint8_t angle = (uint8_t)((i * step - phase) >> 8);
+            fx->pixels[i] = pixel_fx_dim(color, pixel_fx_sin8[angle]);
+        }
+        break;
+
+    case PIXEL_FX_OFF:
+    default:
+        memset(fx->pixels, 0, fx->pixel_count * sizeof(pixel_fx_rgb_t));
+        break;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t pixel_fx_get_pixels(pixel_fx_handle_t fx, const pixel_fx_rgb_t **out_pixels, uint16_t *out_count)
+{
+    if (fx == NULL || out_pixels == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *out_pixels = fx->pixels;
+    if (out_count != NULL)
+    {
+        *out_count = fx->pixel_count;
+    }
+    return ESP_OK;
+}
+
+esp_err_t pixel_fx_write_dmx(pixel_fx_handle_t fx, const pixel_fx_dmx_map_t *map)
+{
+    if (fx == NULL || map == NULL || (map->dmx_handle == NULL && map->source == NULL) || map->pixel_count == 0 ||
+        (uint32_t)map->first_pixel + map->pixel_count > fx->pixel_count)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t width = (map->layout == PIXEL_FX_LAYOUT_RGB) ? 3 : 1;
+    uint32_t length = width * map->pixel_count;
+    if (map->start_channel < 1 || map->start_channel + length - 1 > DMX_UNIVERSE_SIZE)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const pixel_fx_rgb_t *src = &fx->pixels[map->first_pixel];
+    uint8_t *dst = fx->scratch;
+
+    for (uint16_t i = 0; i < map->pixel_count; i++)
+    {
+        uint8_t r = src[i].r;
+        uint8_t g = src[i].g;
+        uint8_t b = src[i].b;
+
+        if (map->layout == PIXEL_FX_LAYOUT_RGB)
+        {
+            if (map->gamma)
+            {
+                r = pixel_fx_gamma8[r];
+                g = pixel_fx_gamma8[g];
+                b = pixel_fx_gamma8[b];
+            }
+            *dst++ = r;
+            *dst++ = g;
+            *dst++ = b;
+        }
+        else
+        {
+            // Rec. 709 luma weights in 1/256
+            uint8_t luma = (uint8_t)((54 * r + 183 * g + 19 * b) >> 8);
+            *dst++ = map->gamma ? pixel_fx_gamma8[luma] : luma;
+        }
+    }
+
+    if (map->source != NULL)
+    {
+        return dmx_source_set_channels(map->source, map->start_channel, fx->scratch, (uint16_t)length);
+    }
+    return dmx_set_channels(map->dmx_handle, map->start_channel, fx->scratch, (uint16_t)length);
+}
+
+esp_err_t pixel_fx_write_strip(pixel_fx_handle_t fx, led_strip_handle_t strip, uint16_t first_pixel,
+                               uint16_t pixel_count)
+{
+    if (fx == NULL || strip == NULL || pixel_count == 0 || (uint32_t)first_pixel + pixel_count > fx->pixel_count)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const pixel_fx_rgb_t *src = &fx->pixels[first_pixel];
+    for (uint16_t i = 0; i < pixel_count; i++)
+    {
+        esp_err_t ret = led_strip_set_pixel(strip, i, pixel_fx_gamma8[src[i].r], pixel_fx_gamma8[src[i].g],
+                                            pixel_fx_gamma8[src[i].b]);
+        if (ret != ESP_OK)
+        {
+            return ret;
+        }
+    }
+
+    return led_strip_refresh(strip);
+}
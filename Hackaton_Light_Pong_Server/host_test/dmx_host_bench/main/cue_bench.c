@@ -0,0 +1,131 @@
+/**
+ * @file cue_bench.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Keyframe tables vs. step patterns in the cue player on the host
+ */
+
+#include "cue_bench.h"
+#include <inttypes.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "mh_x25_driver.h"
+#include "light_cue.h"
+
+static const char *TAG = "cue_bench";
+
+#define BENCH_HEAD_CHANNEL 1 // MH X25 footprint ends before the other benchmarks' channel
+#define BENCH_CUE_STEPS 120  // Chase and strobe steps per track, as BENCH_CUE_BLOCKS lists them
+#define BENCH_CUE_STEP_MS 25 // Five frame slots per step at 200 Hz
+
+// The same chase plus strobe twice, both as const tables: one keyframe per
+// step, and each distinct value once stepped through by a pattern
+#define BENCH_CUE_KEY(step, value) LIGHT_CUE_KEY((step) * BENCH_CUE_STEP_MS, (value))
+#define BENCH_CUE_COLOR_BLOCK(s)                                                                   \
+    BENCH_CUE_KEY((s) + 0, MH_X25_COLOR_RED), BENCH_CUE_KEY((s) + 1, MH_X25_COLOR_GREEN),          \
+        BENCH_CUE_KEY((s) + 2, MH_X25_COLOR_DARK_BLUE), BENCH_CUE_KEY((s) + 3, MH_X25_COLOR_YELLOW), \
+        BENCH_CUE_KEY((s) + 4, MH_X25_COLOR_PINK), BENCH_CUE_KEY((s) + 5, MH_X25_COLOR_LIGHT_BLUE)
+#define BENCH_CUE_DIMMER_BLOCK(s)                                                                  \
+    BENCH_CUE_KEY((s) + 0, MH_X25_DIMMER_FULL), BENCH_CUE_KEY((s) + 1, MH_X25_DIMMER_OFF),         \
+        BENCH_CUE_KEY((s) + 2, MH_X25_DIMMER_FULL), BENCH_CUE_KEY((s) + 3, MH_X25_DIMMER_OFF),     \
+        BENCH_CUE_KEY((s) + 4, MH_X25_DIMMER_FULL), BENCH_CUE_KEY((s) + 5, MH_X25_DIMMER_OFF)
+// BENCH_CUE_STEPS keyframes in blocks of six steps
+#define BENCH_CUE_BLOCKS(block)                                                                    \
+    block(0), block(6), block(12), block(18), block(24), block(30), block(36), block(42), block(48), \
+        block(54), block(60), block(66), block(72), block(78), block(84), block(90), block(96),    \
+        block(102), block(108), block(114)
+
+static const light_cue_key_t color_keys[] = {BENCH_CUE_BLOCKS(BENCH_CUE_COLOR_BLOCK)};
+static const light_cue_key_t dimmer_keys[] = {BENCH_CUE_BLOCKS(BENCH_CUE_DIMMER_BLOCK)};
+static const light_cue_track_t key_tracks[] = {
+    LIGHT_CUE_TRACK(FIXTURE_ATTR_COLOR, color_keys),
+    LIGHT_CUE_TRACK(FIXTURE_ATTR_DIMMER, dimmer_keys),
+};
+static const light_cue_t key_cue = {"keyframes", key_tracks, 2, BENCH_CUE_STEPS * BENCH_CUE_STEP_MS, 1};
+
+static const uint8_t colors[] = {MH_X25_COLOR_RED, MH_X25_COLOR_GREEN, MH_X25_COLOR_DARK_BLUE,
+                                 MH_X25_COLOR_YELLOW, MH_X25_COLOR_PINK, MH_X25_COLOR_LIGHT_BLUE};
+static const uint8_t levels[] = {MH_X25_DIMMER_FULL, MH_X25_DIMMER_OFF};
+static const light_cue_pattern_t chase = LIGHT_CUE_PATTERN(0, BENCH_CUE_STEP_MS, BENCH_CUE_STEPS, colors);
+static const light_cue_pattern_t strobe = LIGHT_CUE_PATTERN(0, BENCH_CUE_STEP_MS, BENCH_CUE_STEPS, levels);
+static const light_cue_track_t pattern_tracks[] = {
+    LIGHT_CUE_PATTERN_TRACK(FIXTURE_ATTR_COLOR, chase),
+    LIGHT_CUE_PATTERN_TRACK(FIXTURE_ATTR_DIMMER, strobe),
+};
+static const light_cue_t pattern_cue = {"patterns", pattern_tracks, 2, BENCH_CUE_STEPS * BENCH_CUE_STEP_MS, 1};
+
+/**
+ * @brief Play a cue to its end and log its table size and render cost per frame slot
+ */
+static esp_err_t cue_bench_play(light_cue_player_handle_t player, const light_cue_t *cue, size_t table_bytes)
+{
+    light_cue_id_t id = 0;
+    light_cue_stats_t stats = {0};
+
+    light_cue_reset_stats(player);
+    esp_err_t ret = light_cue_play(player, cue, 0, &id);
+    if (ret == ESP_OK)
+    {
+        ret = light_cue_wait(player, id, pdMS_TO_TICKS(cue->length_ms * 2));
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Cue %s did not play: %s", cue->name, esp_err_to_name(ret));
+        return ret;
+    }
+
+    light_cue_get_stats(player, &stats);
+    if (stats.frames == 0)
+    {
+        ESP_LOGE(TAG, "Cue %s rendered no frames", cue->name);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ESP_LOGI(TAG, "Cue %s: %u bytes const tables; %" PRIu32 " frames, %" PRIu32 " ns avg, "
+                  "%" PRIu32 " us worst per frame",
+             cue->name, (unsigned)table_bytes, stats.frames,
+             (uint32_t)((uint64_t)stats.render_us_total * 1000 / stats.frames), stats.render_us_max);
+    return ESP_OK;
+}
+
+esp_err_t cue_bench_run(dmx_handle_t dmx_handle)
+{
+    mh_x25_handle_t head = NULL;
+    light_cue_player_handle_t player = NULL;
+    const mh_x25_config_t config = {
+        .dmx_handle = dmx_handle,
+        .start_channel = BENCH_HEAD_CHANNEL};
+
+    ESP_LOGI(TAG, "Running cue table benchmark");
+
+    esp_err_t ret = mh_x25_init(&config, &head);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to init head: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    const light_cue_player_config_t player_config = {
+        .dmx_handle = dmx_handle,
+        .fixture = head};
+    ret = light_cue_player_create(&player_config, &player);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to create player: %s", esp_err_to_name(ret));
+        mh_x25_deinit(head);
+        return ret;
+    }
+
+    // Both variants live in rodata; neither needs RAM beyond the player
+    ret = cue_bench_play(player, &key_cue, sizeof(color_keys) + sizeof(dimmer_keys) + sizeof(key_tracks));
+    if (ret == ESP_OK)
+    {
+        ret = cue_bench_play(player, &pattern_cue,
+                             sizeof(colors) + sizeof(levels) + sizeof(chase) + sizeof(strobe) +
+                                 sizeof(pattern_tracks));
+    }
+
+    light_cue_player_delete(player);
+    mh_x25_deinit(head);
+    return ret;
+}
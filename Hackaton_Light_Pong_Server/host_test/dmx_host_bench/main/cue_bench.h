@@ -0,0 +1,39 @@
+/**
+ * @file cue_bench.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Keyframe tables vs. step patterns in the cue player on the host
+ */
+
+#ifndef CUE_BENCH_H
+#define CUE_BENCH_H
+
+#include "esp_err.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Play the same chase plus strobe from const keyframes and from const patterns
+     *
+     * Logs the size of each variant's tables and the player's render time per
+     * frame slot. Patches an MH X25 at channel 1, so transmission must be
+     * running and nothing else may drive that footprint meanwhile.
+     *
+     * @param dmx_handle DMX handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_TIMEOUT: A cue did not play to its end
+     *      - ESP_ERR_INVALID_STATE: A cue rendered no frames
+     *      - Other: Error creating the fixture or the player
+     */
+    esp_err_t cue_bench_run(dmx_handle_t dmx_handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CUE_BENCH_H
@@ -0,0 +1,80 @@
+/**
+ * @file dmx_host_bench_main.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Host benchmarks of the DMX stack on the linux target
+ *
+ * Runs the driver with the game's frame settings on the virtual wire, feeds
+ * it through the network bridge from a loopback UDP sender, plays a cue from
+ * keyframes and from step patterns, then times the paddle protocol codec. Exits with a non-zero status if a benchmark failed,
+ * so it can run unattended.
+ */
+
+#include <stdlib.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "dmx_driver.h"
+#include "wire_bench.h"
+#include "protocol_bench.h"
+#include "net_bench.h"
+#include "cue_bench.h"
+
+static const char *TAG = "dmx_host_bench";
+
+#define HOST_BENCH_REFRESH_HZ 200 // Same as the game server
+#define HOST_BENCH_SETTLE_MS 200
+
+void app_main(void)
+{
+    dmx_handle_t dmx_handle = NULL;
+
+    // No idle mode: the rate benchmark needs a frame in every slot
+    dmx_config_t dmx_config = {
+        .tx_pin = GPIO_NUM_21,
+        .rx_pin = GPIO_NUM_20,
+        .enable_pin = GPIO_NUM_19,
+        .uart_num = UART_NUM_1,
+        .universe_size = 512,
+        .break_mode = DMX_BREAK_MODE_UART,
+        .refresh_mode = DMX_REFRESH_TRIMMED,
+        .refresh_rate_hz = HOST_BENCH_REFRESH_HZ,
+        .idle_rate_hz = 0};
+
+    esp_err_t ret = dmx_init(&dmx_config, &dmx_handle);
+    if (ret == ESP_OK)
+    {
+        ret = dmx_start_transmission(dmx_handle);
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to start DMX: %s", esp_err_to_name(ret));
+        exit(EXIT_FAILURE);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(HOST_BENCH_SETTLE_MS));
+
+    int failures = 0;
+    if (wire_bench_run(dmx_handle, HOST_BENCH_REFRESH_HZ) != ESP_OK)
+    {
+        failures++;
+    }
+    if (net_bench_run(dmx_handle) != ESP_OK)
+    {
+        failures++;
+    }
+    if (cue_bench_run(dmx_handle) != ESP_OK)
+    {
+        failures++;
+    }
+    if (protocol_bench_run() != ESP_OK)
+    {
+        failures++;
+    }
+
+    dmx_stop_transmission(dmx_handle);
+    dmx_deinit(dmx_handle);
+
+    ESP_LOGI(TAG, "Host benchmarks complete, %d failed", failures);
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
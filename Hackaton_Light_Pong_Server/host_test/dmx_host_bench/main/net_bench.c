@@ -0,0 +1,209 @@
+/**
+ * @file net_bench.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Art-Net / sACN ingest latency from a local UDP sender to the virtual wire
+ */
+
+#include "net_bench.h"
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "dmx_wire.h"
+#include "dmx_net_bridge.h"
+#include "dmx_net_proto.h"
+
+static const char *TAG = "net_bench";
+
+#define BENCH_CHANNEL 13 // First channel after the MH X25 footprint
+#define BENCH_SLOTS 16   // Slots per packet, covers BENCH_CHANNEL
+#define BENCH_SAMPLES 200
+#define BENCH_WIRE_TIMEOUT_MS 100
+#define BENCH_ARTNET_UNIVERSE 0
+#define BENCH_SACN_UNIVERSE 1
+#define BENCH_START_MS 100 // Bridge task up and sockets bound
+
+static dmx_wire_frame_t frame; // Too large for the caller's stack
+
+/**
+ * @brief Store a big-endian 16-bit value
+ */
+static void net_bench_be16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+}
+
+/**
+ * @brief Build an Art-Net OpDmx packet, returns its length
+ */
+static size_t net_bench_artnet(uint8_t *packet, uint8_t sequence, const uint8_t *slots)
+{
+    memset(packet, 0, ARTNET_HEADER_SIZE);
+    memcpy(packet, "Art-Net", 8);
+    packet[8] = (uint8_t)(ARTNET_OPCODE_DMX & 0xFF); // Little endian
+    packet[9] = (uint8_t)(ARTNET_OPCODE_DMX >> 8);
+    net_bench_be16(&packet[10], ARTNET_PROTOCOL_VERSION);
+    packet[12] = sequence;
+    packet[14] = (uint8_t)(BENCH_ARTNET_UNIVERSE & 0xFF);
+    packet[15] = (uint8_t)(BENCH_ARTNET_UNIVERSE >> 8);
+    net_bench_be16(&packet[16], BENCH_SLOTS);
+    memcpy(&packet[ARTNET_HEADER_SIZE], slots, BENCH_SLOTS);
+    return ARTNET_HEADER_SIZE + BENCH_SLOTS;
+}
+
+/**
+ * @brief Build an E1.31 data packet, returns its length
+ */
+static size_t net_bench_sacn(uint8_t *packet, uint8_t sequence, const uint8_t *slots)
+{
+    static const uint8_t acn_id[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+    const uint16_t len = SACN_HEADER_SIZE + BENCH_SLOTS;
+
+    memset(packet, 0, SACN_HEADER_SIZE);
+    // Root layer
+    net_bench_be16(&packet[0], 0x0010);
+    memcpy(&packet[4], acn_id, sizeof(acn_id));
+    net_bench_be16(&packet[16], 0x7000 | (len - 16));
+    packet[21] = 0x04; // VECTOR_ROOT_E131_DATA
+    // Framing layer
+    net_bench_be16(&packet[38], 0x7000 | (len - 38));
+    packet[43] = 0x02; // VECTOR_E131_DATA_PACKET
+    memcpy(&packet[44], "dmx_host_bench", 15);
+    packet[108] = SACN_DEFAULT_PRIORITY;
+    packet[111] = sequence;
+    net_bench_be16(&packet[113], BENCH_SACN_UNIVERSE);
+    // DMP layer
+    net_bench_be16(&packet[115], 0x7000 | (len - 115));
+    packet[117] = 0x02; // VECTOR_DMP_SET_PROPERTY
+    packet[118] = 0xA1;
+    net_bench_be16(&packet[121], 0x0001);
+    net_bench_be16(&packet[123], BENCH_SLOTS + 1);
+    packet[125] = 0x00; // Start code
+    memcpy(&packet[SACN_HEADER_SIZE], slots, BENCH_SLOTS);
+    return len;
+}
+
+/**
+ * @brief Send packets and time each from sendto() until its slot is on the wire
+ */
+static esp_err_t net_bench_feed(dmx_handle_t dmx_handle, int sock)
+{
+    uint8_t packet[SACN_HEADER_SIZE + BENCH_SLOTS];
+    uint8_t slots[BENCH_SLOTS] = {0};
+    int64_t worst_us = 0;
+    int64_t total_us = 0;
+
+    for (int i = 0; i < BENCH_SAMPLES; i++)
+    {
+        const bool artnet = (i % 2) == 0;
+        const uint8_t marker = (uint8_t)(i + 1);
+
+        slots[BENCH_CHANNEL - 1] = marker;
+        size_t len = artnet ? net_bench_artnet(packet, (uint8_t)i, slots)
+                            : net_bench_sacn(packet, (uint8_t)i, slots);
+
+        struct sockaddr_in dest = {0};
+        dest.sin_family = AF_INET;
+        dest.sin_port = htons(artnet ? ARTNET_PORT : SACN_PORT);
+        dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        while (dmx_wire_read(dmx_handle, &frame, 0) == ESP_OK)
+        {
+            // Drop frames queued before the packet
+        }
+
+        int64_t sent = esp_timer_get_time();
+        if (sendto(sock, packet, len, 0, (struct sockaddr *)&dest, sizeof(dest)) != (ssize_t)len)
+        {
+            ESP_LOGE(TAG, "sendto failed");
+            return ESP_FAIL;
+        }
+
+        bool seen = false;
+        while (!seen && dmx_wire_read(dmx_handle, &frame, pdMS_TO_TICKS(BENCH_WIRE_TIMEOUT_MS)) == ESP_OK)
+        {
+            seen = frame.length > BENCH_CHANNEL && frame.data[BENCH_CHANNEL] == marker;
+        }
+        if (!seen)
+        {
+            ESP_LOGE(TAG, "%s packet %d never reached the wire", artnet ? "Art-Net" : "sACN", i);
+            return ESP_ERR_TIMEOUT;
+        }
+
+        int64_t latency = frame.start_us + (int64_t)BENCH_CHANNEL * DMX_WIRE_SLOT_US - sent;
+        total_us += latency;
+        if (latency > worst_us)
+        {
+            worst_us = latency;
+        }
+    }
+
+    ESP_LOGI(TAG, "UDP send to wire: %d packets, mean %" PRId64 " us, worst %" PRId64 " us",
+             BENCH_SAMPLES, total_us / BENCH_SAMPLES, worst_us);
+    return ESP_OK;
+}
+
+esp_err_t net_bench_run(dmx_handle_t dmx_handle)
+{
+    dmx_net_bridge_handle_t bridge = NULL;
+    dmx_net_config_t config = {
+        .dmx_handle = dmx_handle,
+        .enable_artnet = true,
+        .artnet_universe = BENCH_ARTNET_UNIVERSE,
+        .enable_sacn = true,
+        .sacn_universe = BENCH_SACN_UNIVERSE};
+
+    ESP_LOGI(TAG, "Running network bridge benchmark");
+
+    esp_err_t ret = dmx_net_bridge_start(&config, &bridge);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to start bridge: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    vTaskDelay(pdMS_TO_TICKS(BENCH_START_MS));
+
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0)
+    {
+        ESP_LOGE(TAG, "Failed to open sender socket");
+        dmx_net_bridge_stop(bridge);
+        return ESP_FAIL;
+    }
+
+    ret = net_bench_feed(dmx_handle, sock);
+    close(sock);
+
+    dmx_net_stats_t stats;
+    dmx_net_bridge_get_stats(bridge, &stats);
+    dmx_net_bridge_stop(bridge);
+    dmx_set_channel(dmx_handle, BENCH_CHANNEL, 0);
+
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "Bridge: Art-Net %" PRIu32 ", sACN %" PRIu32 ", invalid %" PRIu32 ", ignored %" PRIu32
+             ", out of order %" PRIu32,
+             stats.artnet_packets, stats.sacn_packets, stats.invalid_packets, stats.ignored_packets,
+             stats.out_of_order);
+    ESP_LOGI(TAG, "Bridge arrival to frame: mean %" PRIu32 " us, max %" PRIu32 " us",
+             stats.latency_mean_us, stats.latency_max_us);
+
+    if (stats.artnet_packets + stats.sacn_packets != BENCH_SAMPLES)
+    {
+        ESP_LOGE(TAG, "Bridge applied %" PRIu32 " of %d packets",
+                 stats.artnet_packets + stats.sacn_packets, BENCH_SAMPLES);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
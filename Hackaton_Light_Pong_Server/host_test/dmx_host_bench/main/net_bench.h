@@ -0,0 +1,39 @@
+/**
+ * @file net_bench.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Art-Net / sACN ingest latency from a local UDP sender to the virtual wire
+ */
+
+#ifndef NET_BENCH_H
+#define NET_BENCH_H
+
+#include "esp_err.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Feed the network bridge over loopback UDP and log the latency to the wire
+     *
+     * Starts the bridge on dmx_handle, sends alternating Art-Net and sACN
+     * packets to 127.0.0.1 and reads the frames carrying them back with
+     * dmx_wire_read(). Transmission must be running without idle mode.
+     *
+     * @param dmx_handle DMX handle
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_TIMEOUT: A packet never reached the wire
+     *      - ESP_ERR_INVALID_STATE: The bridge counted other packets than were sent
+     *      - Others: Error from dmx_net_bridge_start() or the socket
+     */
+    esp_err_t net_bench_run(dmx_handle_t dmx_handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NET_BENCH_H
@@ -0,0 +1,88 @@
+/**
+ * @file protocol_bench.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Paddle protocol encode/decode benchmark on the host
+ *
+ * The legacy input_event_t comparison stays in the on-target benchmark,
+ * since its header needs ESP-NOW.
+ */
+
+#include "protocol_bench.h"
+#include <inttypes.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "paddle_protocol.h"
+
+static const char *TAG = "protocol_bench";
+
+#define BENCH_ROUNDS 100000
+
+// Keeps the compiler from dropping the measured work
+static volatile uint32_t bench_sink;
+
+/**
+ * @brief Compact format with a batch of samples
+ */
+static esp_err_t bench_compact(uint8_t samples)
+{
+    paddle_proto_frame_t frame = {
+        .player_id = 1,
+        .buttons = PADDLE_PROTO_BTN_RIGHT,
+        .sample_period_ms = 5,
+        .sample_count = samples};
+    paddle_proto_frame_t decoded;
+    uint8_t buf[PADDLE_PROTO_MAX_SIZE];
+    size_t len = 0;
+
+    for (uint8_t i = 0; i < samples; i++)
+    {
+        frame.samples[i].ax = paddle_proto_accel_from_g(0.1f * i);
+        frame.samples[i].az = paddle_proto_accel_from_g(1.0f);
+        frame.samples[i].gz = paddle_proto_gyro_from_dps(-90.0f * i);
+    }
+
+    int64_t encode_us = 0;
+    int64_t decode_us = 0;
+    for (int i = 0; i < BENCH_ROUNDS; i++)
+    {
+        frame.seq = (uint16_t)i;
+
+        int64_t start = esp_timer_get_time();
+        paddle_proto_encode(&frame, buf, sizeof(buf), &len);
+        int64_t encoded = esp_timer_get_time();
+        paddle_proto_decode(buf, len, &decoded);
+        decode_us += esp_timer_get_time() - encoded;
+        encode_us += encoded - start;
+
+        bench_sink += decoded.seq;
+    }
+
+    if (decoded.seq != frame.seq || decoded.sample_count != samples ||
+        memcmp(decoded.samples, frame.samples, samples * sizeof(paddle_proto_sample_t)) != 0)
+    {
+        ESP_LOGE(TAG, "Compact, %u sample(s): round trip mismatch", samples);
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Compact, %u sample(s): %u bytes, encode %" PRId64 " ns, decode %" PRId64 " ns",
+             samples, (unsigned)len, encode_us * 1000 / BENCH_ROUNDS, decode_us * 1000 / BENCH_ROUNDS);
+    return ESP_OK;
+}
+
+esp_err_t protocol_bench_run(void)
+{
+    static const uint8_t batches[] = {0, 1, 4, PADDLE_PROTO_MAX_SAMPLES};
+    esp_err_t ret = ESP_OK;
+
+    ESP_LOGI(TAG, "Running paddle protocol benchmarks");
+    for (size_t i = 0; i < sizeof(batches); i++)
+    {
+        if (bench_compact(batches[i]) != ESP_OK)
+        {
+            ret = ESP_FAIL;
+        }
+    }
+    return ret;
+}
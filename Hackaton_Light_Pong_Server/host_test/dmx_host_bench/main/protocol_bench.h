@@ -0,0 +1,31 @@
+/**
+ * @file protocol_bench.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Paddle protocol encode/decode benchmark on the host
+ */
+
+#ifndef PROTOCOL_BENCH_H
+#define PROTOCOL_BENCH_H
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Encode and decode compact paddle frames and log time and size per frame
+     *
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_FAIL: A frame did not survive the round trip
+     */
+    esp_err_t protocol_bench_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTOCOL_BENCH_H
@@ -0,0 +1,149 @@
+/**
+ * @file wire_bench.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Frame rate, jitter and update-to-wire latency on the virtual wire
+ */
+
+#include "wire_bench.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "dmx_wire.h"
+
+static const char *TAG = "wire_bench";
+
+#define BENCH_CHANNEL 13 // First channel after the MH X25 footprint
+#define BENCH_RATE_FRAMES 1000
+#define BENCH_LATENCY_SAMPLES 200
+#define BENCH_WIRE_TIMEOUT_MS 100
+
+static dmx_wire_frame_t frame; // Too large for the caller's stack
+
+/**
+ * @brief Drop frames that were queued before a measurement starts
+ */
+static void wire_bench_drain(dmx_handle_t dmx_handle)
+{
+    while (dmx_wire_read(dmx_handle, &frame, 0) == ESP_OK)
+    {
+    }
+}
+
+/**
+ * @brief Frame rate and start-to-start jitter of consecutive frames
+ */
+static esp_err_t wire_bench_rate(dmx_handle_t dmx_handle, uint16_t refresh_rate_hz)
+{
+    const int64_t target_us = 1000000 / refresh_rate_hz;
+    int64_t first_us = 0;
+    int64_t prev_us = 0;
+    int64_t jitter_sum_us = 0;
+    int64_t jitter_max_us = 0;
+    uint32_t overruns_before = 0;
+    uint32_t overruns_after = 0;
+    int frames = 0;
+
+    wire_bench_drain(dmx_handle);
+    dmx_wire_get_overruns(dmx_handle, &overruns_before);
+
+    while (frames < BENCH_RATE_FRAMES &&
+           dmx_wire_read(dmx_handle, &frame, pdMS_TO_TICKS(BENCH_WIRE_TIMEOUT_MS)) == ESP_OK)
+    {
+        if (frames == 0)
+        {
+            first_us = frame.start_us;
+        }
+        else
+        {
+            int64_t jitter = llabs((frame.start_us - prev_us) - target_us);
+            jitter_sum_us += jitter;
+            if (jitter > jitter_max_us)
+            {
+                jitter_max_us = jitter;
+            }
+        }
+        prev_us = frame.start_us;
+        frames++;
+    }
+
+    dmx_wire_get_overruns(dmx_handle, &overruns_after);
+
+    if (frames < 2)
+    {
+        ESP_LOGE(TAG, "Frame rate: no frames on the wire");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    int64_t span_us = prev_us - first_us;
+    int64_t rate_tenths = (frames - 1) * 10000000LL / span_us;
+    ESP_LOGI(TAG, "Frame rate: %d frames, %" PRId64 ".%" PRId64 " Hz (target %u Hz)",
+             frames, rate_tenths / 10, rate_tenths % 10, refresh_rate_hz);
+    ESP_LOGI(TAG, "Jitter: mean %" PRId64 " us, worst %" PRId64 " us, ring overruns %" PRIu32,
+             jitter_sum_us / (frames - 1), jitter_max_us, overruns_after - overruns_before);
+    return ESP_OK;
+}
+
+/**
+ * @brief Time from dmx_set_channel() until the slot is on the wire
+ */
+static esp_err_t wire_bench_latency(dmx_handle_t dmx_handle)
+{
+    int64_t worst_us = 0;
+    int64_t total_us = 0;
+    int samples = 0;
+
+    for (int i = 0; i < BENCH_LATENCY_SAMPLES; i++)
+    {
+        const uint8_t marker = (uint8_t)(i + 1);
+
+        wire_bench_drain(dmx_handle);
+
+        int64_t written = esp_timer_get_time();
+        dmx_set_channel(dmx_handle, BENCH_CHANNEL, marker);
+
+        while (dmx_wire_read(dmx_handle, &frame, pdMS_TO_TICKS(BENCH_WIRE_TIMEOUT_MS)) == ESP_OK)
+        {
+            if (frame.length > BENCH_CHANNEL && frame.data[BENCH_CHANNEL] == marker)
+            {
+                int64_t on_wire = frame.start_us + (int64_t)BENCH_CHANNEL * DMX_WIRE_SLOT_US;
+                int64_t latency = on_wire - written;
+                total_us += latency;
+                if (latency > worst_us)
+                {
+                    worst_us = latency;
+                }
+                samples++;
+                break;
+            }
+        }
+    }
+
+    dmx_set_channel(dmx_handle, BENCH_CHANNEL, 0);
+
+    if (samples == 0)
+    {
+        ESP_LOGE(TAG, "Update-to-wire: no marker frame seen");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    ESP_LOGI(TAG, "Update-to-wire: %d/%d samples, mean %" PRId64 " us, worst %" PRId64 " us",
+             samples, BENCH_LATENCY_SAMPLES, total_us / samples, worst_us);
+    return ESP_OK;
+}
+
+esp_err_t wire_bench_run(dmx_handle_t dmx_handle, uint16_t refresh_rate_hz)
+{
+    ESP_LOGI(TAG, "Running virtual wire benchmarks");
+
+    esp_err_t ret = wire_bench_rate(dmx_handle, refresh_rate_hz);
+    if (ret == ESP_OK)
+    {
+        ret = wire_bench_latency(dmx_handle);
+    }
+
+    dmx_log_stats(dmx_handle);
+    return ret;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file wire_bench.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Frame rate, jitter and update-to-wire latency on the virtual wire
+ */
+
+#ifndef WIRE_BENCH_H
+#define WIRE_BENCH_H
+
+#include "esp_err.h"
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Measure the running transmission task and log the results
+     *
+     * Reads frames back with dmx_wire_read(), so transmission must have been
+     * started without idle mode and nothing else may read the wire meanwhile.
+     *
+     * @param dmx_handle DMX handle
+     * @param refresh_rate_hz Configured refresh rate
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_TIMEOUT: No frames or no marker frame on the wire
+     */
+    esp_err_t wire_bench_run(dmx_handle_t dmx_handle, uint16_t refresh_rate_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIRE_BENCH_H
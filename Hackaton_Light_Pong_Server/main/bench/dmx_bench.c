@@ -0,0 +1,645 @@
+/**
+ * @file dmx_bench.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief On-target DMX driver benchmarks
+ */
+
+#include "dmx_bench.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "mh_x25_driver.h"
+#include "dmx_fade.h"
+#include "fixture_group.h"
+#include "light_cue.h"
+#include "pixel_fx.h"
+#include "hardware_config.h"
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE
+#include "dmx_wire.h"
+#endif
+
+static const char *TAG = "dmx_bench";
+
+#define BENCH_ITERATIONS 20000
+#define BENCH_YIELD_EVERY 100   // Spread the run over many DMX frames
+// First unpatched channel: does not disturb the fixture and grows a trimmed
+// universe by a single slot only
+#define BENCH_CHANNEL (MH_X25_START_CHANNEL + MH_X25_NUM_CHANNELS)
+#define BENCH_FADE_MS 1000
+#define BENCH_GROUP_HEADS 40 // 40 x 12 channels after the fixture fill the universe
+#define BENCH_GROUP_ROUNDS 200
+#define BENCH_SHADOW_ROUNDS 1000
+#define BENCH_CUE_STEPS 120   // Chase and strobe steps per track, as BENCH_CUE_BLOCKS lists them
+#define BENCH_CUE_STEP_MS 25  // Five frame slots per step at 200 Hz
+#define BENCH_PIXELS ((DMX_UNIVERSE_SIZE - BENCH_CHANNEL + 1) / 3) // RGB pixels after the fixture
+#define BENCH_PIXEL_FRAMES 1000
+#define BENCH_PIXEL_FRAME_MS 5 // 200 Hz frame slots
+#define BENCH_WIRE_SAMPLES 200
+#define BENCH_WIRE_TIMEOUT_MS 100
+#define BENCH_BASELINE_PRIORITY 5 // DMX_TASK_PRIORITY of the driver
+#define BENCH_BASELINE_STACK 2048
+
+#if CONFIG_LIGHT_PONG_DMX_BENCHMARK_MUTEX_BASELINE
+/**
+ * @brief Mutex-guarded universe as written before the lock-free back buffer
+ */
+typedef struct
+{
+    SemaphoreHandle_t mutex;
+    SemaphoreHandle_t done;
+    TaskHandle_t task;
+    volatile bool stop;
+    uint8_t universe[DMX_UNIVERSE_SIZE + 1];
+    uint8_t tx_ring[DMX_UNIVERSE_SIZE + 1];
+} bench_baseline_t;
+
+/**
+ * @brief Wake the baseline task once per frame slot
+ */
+static void bench_baseline_slot(int64_t slot_us, void *user_ctx)
+{
+    xTaskNotifyGive(((bench_baseline_t *)user_ctx)->task);
+}
+
+/**
+ * @brief Stand-in for the old dmx_transmit(), at the priority of the TX task
+ *
+ * It held the mutex while uart_write_bytes() copied the universe into the
+ * UART TX ring buffer; the wait for the wire happened after the release.
+ */
+static void bench_baseline_task(void *arg)
+{
+    bench_baseline_t *baseline = (bench_baseline_t *)arg;
+
+    while (!baseline->stop)
+    {
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BENCH_WIRE_TIMEOUT_MS)) == 0)
+        {
+            continue;
+        }
+        xSemaphoreTake(baseline->mutex, portMAX_DELAY);
+        memcpy(baseline->tx_ring, baseline->universe, sizeof(baseline->tx_ring));
+        xSemaphoreGive(baseline->mutex);
+    }
+
+    xSemaphoreGive(baseline->done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Free the baseline once its task has exited or was never started
+ */
+static void bench_baseline_free(bench_baseline_t *baseline)
+{
+    if (baseline->done != NULL)
+    {
+        vSemaphoreDelete(baseline->done);
+    }
+    if (baseline->mutex != NULL)
+    {
+        vSemaphoreDelete(baseline->mutex);
+    }
+    free(baseline);
+}
+
+/**
+ * @brief Stop the baseline task and wait until it has exited
+ */
+static void bench_baseline_stop(bench_baseline_t *baseline)
+{
+    baseline->stop = true;
+    xTaskNotifyGive(baseline->task);
+    xSemaphoreTake(baseline->done, portMAX_DELAY);
+}
+
+/**
+ * @brief dmx_set_channel() latency with the pre-lock-free mutex discipline
+ *
+ * Same loop as bench_set_channel_latency(), so both numbers compare
+ * directly when this variant is compiled in.
+ */
+static void bench_set_channel_latency_mutex(dmx_handle_t dmx_handle)
+{
+    bench_baseline_t *baseline = (bench_baseline_t *)calloc(1, sizeof(bench_baseline_t));
+    if (baseline == NULL)
+    {
+        ESP_LOGW(TAG, "Mutex baseline skipped: out of memory");
+        return;
+    }
+
+    baseline->mutex = xSemaphoreCreateMutex();
+    baseline->done = xSemaphoreCreateBinary();
+    if (baseline->mutex == NULL || baseline->done == NULL ||
+        xTaskCreate(bench_baseline_task, "bench_mutex", BENCH_BASELINE_STACK, baseline,
+                    BENCH_BASELINE_PRIORITY, &baseline->task) != pdPASS)
+    {
+        ESP_LOGW(TAG, "Mutex baseline skipped: could not create task");
+        bench_baseline_free(baseline);
+        return;
+    }
+
+    if (dmx_add_tx_callback(dmx_handle, bench_baseline_slot, baseline) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Mutex baseline skipped: no frame slot callback");
+        bench_baseline_stop(baseline);
+        bench_baseline_free(baseline);
+        return;
+    }
+
+    int64_t worst_us = 0;
+    int64_t total_us = 0;
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        int64_t start = esp_timer_get_time();
+        xSemaphoreTake(baseline->mutex, portMAX_DELAY);
+        baseline->universe[BENCH_CHANNEL] = (uint8_t)i;
+        xSemaphoreGive(baseline->mutex);
+        int64_t elapsed = esp_timer_get_time() - start;
+
+        total_us += elapsed;
+        if (elapsed > worst_us)
+        {
+            worst_us = elapsed;
+        }
+
+        if ((i % BENCH_YIELD_EVERY) == 0)
+        {
+            vTaskDelay(1);
+        }
+    }
+
+    dmx_remove_tx_callback(dmx_handle, bench_baseline_slot, baseline);
+    bench_baseline_stop(baseline);
+    bench_baseline_free(baseline);
+
+    ESP_LOGI(TAG, "Mutex baseline: %d calls, mean %" PRId64 " us, worst %" PRId64 " us",
+             BENCH_ITERATIONS, total_us / BENCH_ITERATIONS, worst_us);
+}
+#endif
+
+/**
+ * @brief Worst-case and mean dmx_set_channel() latency while TX is running
+ */
+static void bench_set_channel_latency(dmx_handle_t dmx_handle)
+{
+    int64_t worst_us = 0;
+    int64_t total_us = 0;
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        int64_t start = esp_timer_get_time();
+        dmx_set_channel(dmx_handle, BENCH_CHANNEL, (uint8_t)i);
+        int64_t elapsed = esp_timer_get_time() - start;
+
+        total_us += elapsed;
+        if (elapsed > worst_us)
+        {
+            worst_us = elapsed;
+        }
+
+        if ((i % BENCH_YIELD_EVERY) == 0)
+        {
+            vTaskDelay(1);
+        }
+    }
+
+    dmx_set_channel(dmx_handle, BENCH_CHANNEL, 0);
+
+    ESP_LOGI(TAG, "dmx_set_channel: %d calls, mean %" PRId64 " us, worst %" PRId64 " us",
+             BENCH_ITERATIONS, total_us / BENCH_ITERATIONS, worst_us);
+}
+
+/**
+ * @brief CPU time the TX path spends per frame (BREAK generation included)
+ */
+static void bench_frame_cpu_time(dmx_handle_t dmx_handle)
+{
+    uint32_t last_us = 0;
+    uint32_t max_us = 0;
+
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    dmx_get_frame_cpu_time(dmx_handle, &last_us, &max_us);
+
+    ESP_LOGI(TAG, "dmx_transmit CPU time per frame: last %" PRIu32 " us, max %" PRIu32 " us",
+             last_us, max_us);
+}
+
+/**
+ * @brief Per-frame CPU time with the fade pool full
+ *
+ * Uses the unpatched channels after the fixture, so a trimmed universe stays
+ * longer for the rest of the session.
+ */
+static void bench_fade_cpu_time(dmx_handle_t dmx_handle)
+{
+    static uint8_t targets[DMX_MAX_FADES];
+    uint32_t idle_last_us = 0;
+    uint32_t fade_max_us = 0;
+
+    for (int i = 0; i < DMX_MAX_FADES; i++)
+    {
+        targets[i] = (uint8_t)(255 - i);
+    }
+
+    dmx_get_frame_cpu_time(dmx_handle, &idle_last_us, NULL);
+    dmx_reset_stats(dmx_handle);
+
+    if (dmx_fade_channels(dmx_handle, BENCH_CHANNEL, targets, DMX_MAX_FADES,
+                          BENCH_FADE_MS, DMX_FADE_EASE_IN_OUT) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Fade benchmark skipped: could not start fades");
+        return;
+    }
+    vTaskDelay(pdMS_TO_TICKS(BENCH_FADE_MS));
+    dmx_get_frame_cpu_time(dmx_handle, NULL, &fade_max_us);
+
+    uint8_t zeros[DMX_MAX_FADES] = {0};
+    dmx_set_channels(dmx_handle, BENCH_CHANNEL, zeros, DMX_MAX_FADES);
+
+    ESP_LOGI(TAG, "%d fades: frame CPU time max %" PRIu32 " us (no fades: %" PRIu32 " us)",
+             DMX_MAX_FADES, fade_max_us, idle_last_us);
+}
+
+/**
+ * @brief Moving 40 heads: one locked write per head versus one group update
+ *
+ * The heads are patched on the unpatched channels after the fixture, so a
+ * trimmed universe stays full length for the rest of the session.
+ */
+static void bench_group_fanout(dmx_handle_t dmx_handle)
+{
+    static mh_x25_handle_t heads[BENCH_GROUP_HEADS];
+    fixture_group_handle_t group = NULL;
+    int created = 0;
+
+    if (fixture_group_create(BENCH_GROUP_HEADS, &group) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Group benchmark skipped: out of memory");
+        return;
+    }
+
+    for (; created < BENCH_GROUP_HEADS; created++)
+    {
+        mh_x25_config_t config = {
+            .dmx_handle = dmx_handle,
+            .start_channel = BENCH_CHANNEL + created * MH_X25_NUM_CHANNELS};
+        // Every other head mirrors pan, like a pair of heads facing each other
+        fixture_group_member_config_t member = {
+            .pan_offset = created * 256,
+            .mirror_pan = (created & 1) != 0};
+
+        if (mh_x25_init(&config, &heads[created]) != ESP_OK)
+        {
+            break;
+        }
+        if (fixture_group_add(group, heads[created], &member) != ESP_OK)
+        {
+            mh_x25_deinit(heads[created]);
+            break;
+        }
+    }
+
+    if (created == BENCH_GROUP_HEADS)
+    {
+        int64_t single_us = 0;
+        int64_t group_us = 0;
+
+        for (int round = 0; round < BENCH_GROUP_ROUNDS; round++)
+        {
+            uint16_t pan = (uint16_t)(round * 300);
+            uint16_t tilt = (uint16_t)(round * 200);
+
+            int64_t start = esp_timer_get_time();
+            for (int i = 0; i < BENCH_GROUP_HEADS; i++)
+            {
+                mh_x25_set_position_16bit(heads[i], pan, tilt);
+            }
+            single_us += esp_timer_get_time() - start;
+
+            const fixture_attr_value_t position[] = {
+                {FIXTURE_ATTR_PAN, pan},
+                {FIXTURE_ATTR_TILT, tilt}};
+            start = esp_timer_get_time();
+            fixture_group_set_attrs(group, position, 2);
+            group_us += esp_timer_get_time() - start;
+
+            vTaskDelay(1);
+        }
+
+        ESP_LOGI(TAG, "%d heads pan/tilt: per-head writes %" PRId64 " us, group %" PRId64 " us per update",
+                 BENCH_GROUP_HEADS, single_us / BENCH_GROUP_ROUNDS, group_us / BENCH_GROUP_ROUNDS);
+    }
+    else
+    {
+        ESP_LOGW(TAG, "Group benchmark skipped: only %d heads created", created);
+    }
+
+    fixture_group_delete(group);
+    for (int i = 0; i < created; i++)
+    {
+        mh_x25_deinit(heads[i]);
+    }
+}
+
+/**
+ * @brief Cost of re-setting unchanged attributes, as the game does on every hit
+ */
+static void bench_shadow_diff(dmx_handle_t dmx_handle)
+{
+    mh_x25_handle_t head = NULL;
+    const mh_x25_config_t config = {
+        .dmx_handle = dmx_handle,
+        .start_channel = BENCH_CHANNEL};
+
+    if (mh_x25_init(&config, &head) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Shadow benchmark skipped: head init failed");
+        return;
+    }
+
+    int64_t changed_us = 0;
+    int64_t unchanged_us = 0;
+
+    for (int round = 0; round < BENCH_SHADOW_ROUNDS; round++)
+    {
+        uint8_t value = (uint8_t)(round & 1);
+
+        int64_t start = esp_timer_get_time();
+        mh_x25_set_color(head, value);
+        mh_x25_set_gobo(head, value);
+        mh_x25_set_gobo_rotation(head, value);
+        changed_us += esp_timer_get_time() - start;
+
+        start = esp_timer_get_time();
+        mh_x25_set_color(head, value);
+        mh_x25_set_gobo(head, value);
+        mh_x25_set_gobo_rotation(head, value);
+        unchanged_us += esp_timer_get_time() - start;
+
+        if ((round % BENCH_YIELD_EVERY) == 0)
+        {
+            vTaskDelay(1);
+        }
+    }
+
+    fixture_write_stats_t stats = {0};
+    mh_x25_get_write_stats(head, &stats);
+    ESP_LOGI(TAG, "Color/gobo/rotation: changed %" PRId64 " ns, unchanged %" PRId64 " ns per call; "
+                  "%" PRIu32 " channel writes applied, %" PRIu32 " suppressed",
+             changed_us * 1000 / BENCH_SHADOW_ROUNDS, unchanged_us * 1000 / BENCH_SHADOW_ROUNDS,
+             stats.applied, stats.suppressed);
+
+    mh_x25_deinit(head);
+}
+
+// The same chase plus strobe twice, both as const tables: one keyframe per
+// step, and each distinct value once stepped through by a pattern
+#define BENCH_CUE_KEY(step, value) LIGHT_CUE_KEY((step) * BENCH_CUE_STEP_MS, (value))
+#define BENCH_CUE_COLOR_BLOCK(s)                                                                   \
+    BENCH_CUE_KEY((s) + 0, MH_X25_COLOR_RED), BENCH_CUE_KEY((s) + 1, MH_X25_COLOR_GREEN),          \
+        BENCH_CUE_KEY((s) + 2, MH_X25_COLOR_DARK_BLUE), BENCH_CUE_KEY((s) + 3, MH_X25_COLOR_YELLOW), \
+        BENCH_CUE_KEY((s) + 4, MH_X25_COLOR_PINK), BENCH_CUE_KEY((s) + 5, MH_X25_COLOR_LIGHT_BLUE)
+#define BENCH_CUE_DIMMER_BLOCK(s)                                                                  \
+    BENCH_CUE_KEY((s) + 0, MH_X25_DIMMER_FULL), BENCH_CUE_KEY((s) + 1, MH_X25_DIMMER_OFF),         \
+        BENCH_CUE_KEY((s) + 2, MH_X25_DIMMER_FULL), BENCH_CUE_KEY((s) + 3, MH_X25_DIMMER_OFF),     \
+        BENCH_CUE_KEY((s) + 4, MH_X25_DIMMER_FULL), BENCH_CUE_KEY((s) + 5, MH_X25_DIMMER_OFF)
+// BENCH_CUE_STEPS keyframes in blocks of six steps
+#define BENCH_CUE_BLOCKS(block)                                                                    \
+    block(0), block(6), block(12), block(18), block(24), block(30), block(36), block(42), block(48), \
+        block(54), block(60), block(66), block(72), block(78), block(84), block(90), block(96),    \
+        block(102), block(108), block(114)
+
+static const light_cue_key_t bench_cue_color_keys[] = {BENCH_CUE_BLOCKS(BENCH_CUE_COLOR_BLOCK)};
+static const light_cue_key_t bench_cue_dimmer_keys[] = {BENCH_CUE_BLOCKS(BENCH_CUE_DIMMER_BLOCK)};
+static const light_cue_track_t bench_cue_key_tracks[] = {
+    LIGHT_CUE_TRACK(FIXTURE_ATTR_COLOR, bench_cue_color_keys),
+    LIGHT_CUE_TRACK(FIXTURE_ATTR_DIMMER, bench_cue_dimmer_keys),
+};
+
+static const uint8_t bench_cue_colors[] = {MH_X25_COLOR_RED, MH_X25_COLOR_GREEN, MH_X25_COLOR_DARK_BLUE,
+                                           MH_X25_COLOR_YELLOW, MH_X25_COLOR_PINK, MH_X25_COLOR_LIGHT_BLUE};
+static const uint8_t bench_cue_levels[] = {MH_X25_DIMMER_FULL, MH_X25_DIMMER_OFF};
+static const light_cue_pattern_t bench_cue_chase = LIGHT_CUE_PATTERN(0, BENCH_CUE_STEP_MS, BENCH_CUE_STEPS,
+                                                                     bench_cue_colors);
+static const light_cue_pattern_t bench_cue_strobe = LIGHT_CUE_PATTERN(0, BENCH_CUE_STEP_MS, BENCH_CUE_STEPS,
+                                                                      bench_cue_levels);
+static const light_cue_track_t bench_cue_pattern_tracks[] = {
+    LIGHT_CUE_PATTERN_TRACK(FIXTURE_ATTR_COLOR, bench_cue_chase),
+    LIGHT_CUE_PATTERN_TRACK(FIXTURE_ATTR_DIMMER, bench_cue_strobe),
+};
+
+/**
+ * @brief Play a cue to its end and log its render cost per frame slot
+ */
+static void bench_cue_play(light_cue_player_handle_t player, const light_cue_t *cue, size_t table_bytes)
+{
+    light_cue_id_t id = 0;
+    light_cue_stats_t stats = {0};
+
+    light_cue_reset_stats(player);
+    if (light_cue_play(player, cue, 0, &id) != ESP_OK ||
+        light_cue_wait(player, id, pdMS_TO_TICKS(cue->length_ms * 2)) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Cue %s did not play", cue->name);
+        return;
+    }
+    light_cue_get_stats(player, &stats);
+
+    if (stats.frames > 0)
+    {
+        ESP_LOGI(TAG, "Cue %s: %u bytes const tables; %" PRIu32 " frames, %" PRIu32 " ns avg, "
+                      "%" PRIu32 " us worst per frame",
+                 cue->name, (unsigned)table_bytes, stats.frames,
+                 (uint32_t)((uint64_t)stats.render_us_total * 1000 / stats.frames), stats.render_us_max);
+    }
+}
+
+/**
+ * @brief Chase plus strobe as const keyframe tables vs. const step patterns
+ */
+static void bench_cue_tables(dmx_handle_t dmx_handle)
+{
+    mh_x25_handle_t head = NULL;
+    light_cue_player_handle_t player = NULL;
+    const mh_x25_config_t config = {
+        .dmx_handle = dmx_handle,
+        .start_channel = BENCH_CHANNEL};
+
+    if (mh_x25_init(&config, &head) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Cue benchmark skipped: head init failed");
+        return;
+    }
+    const light_cue_player_config_t player_config = {
+        .dmx_handle = dmx_handle,
+        .fixture = head};
+    if (light_cue_player_create(&player_config, &player) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Cue benchmark skipped: player init failed");
+        mh_x25_deinit(head);
+        return;
+    }
+
+    // Both variants live in rodata; neither needs RAM beyond the player
+    const light_cue_t key_cue = {"keyframes", bench_cue_key_tracks, 2, BENCH_CUE_STEPS * BENCH_CUE_STEP_MS, 1};
+    bench_cue_play(player, &key_cue,
+                   sizeof(bench_cue_color_keys) + sizeof(bench_cue_dimmer_keys) + sizeof(bench_cue_key_tracks));
+
+    const light_cue_t pattern_cue = {"patterns", bench_cue_pattern_tracks, 2, BENCH_CUE_STEPS * BENCH_CUE_STEP_MS, 1};
+    bench_cue_play(player, &pattern_cue,
+                   sizeof(bench_cue_colors) + sizeof(bench_cue_levels) + sizeof(bench_cue_chase) +
+                       sizeof(bench_cue_strobe) + sizeof(bench_cue_pattern_tracks));
+
+    light_cue_player_delete(player);
+    mh_x25_deinit(head);
+}
+
+/**
+ * @brief Render and map every effect onto the RGB channels after the fixture
+ */
+static void bench_pixel_fx(dmx_handle_t dmx_handle)
+{
+    static const char *const names[] = {"off", "chase", "rainbow", "noise", "wave"};
+    pixel_fx_handle_t fx = NULL;
+
+    if (pixel_fx_create(BENCH_PIXELS, &fx) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Pixel effect benchmark skipped: renderer init failed");
+        return;
+    }
+
+    const pixel_fx_dmx_map_t map = {
+        .dmx_handle = dmx_handle,
+        .start_channel = BENCH_CHANNEL,
+        .first_pixel = 0,
+        .pixel_count = BENCH_PIXELS,
+        .layout = PIXEL_FX_LAYOUT_RGB,
+        .gamma = true};
+
+    for (int effect = PIXEL_FX_CHASE; effect <= PIXEL_FX_WAVE; effect++)
+    {
+        const pixel_fx_params_t params = {
+            .effect = (pixel_fx_effect_t)effect,
+            .color = {255, 96, 0},
+            .speed = (effect == PIXEL_FX_CHASE) ? 60 : 128,
+            .scale = (effect == PIXEL_FX_CHASE) ? 8 : 12,
+            .brightness = 255};
+        int64_t render_us = 0;
+        int64_t write_us = 0;
+        int64_t worst_us = 0;
+
+        pixel_fx_set_params(fx, &params);
+        for (int frame = 0; frame < BENCH_PIXEL_FRAMES; frame++)
+        {
+            int64_t start = esp_timer_get_time();
+            pixel_fx_render(fx, (uint32_t)(frame * BENCH_PIXEL_FRAME_MS));
+            int64_t rendered = esp_timer_get_time();
+            pixel_fx_write_dmx(fx, &map);
+            int64_t end = esp_timer_get_time();
+
+            render_us += rendered - start;
+            write_us += end - rendered;
+            if (end - start > worst_us)
+            {
+                worst_us = end - start;
+            }
+            if ((frame % BENCH_YIELD_EVERY) == 0)
+            {
+                vTaskDelay(1);
+            }
+        }
+
+        ESP_LOGI(TAG, "Pixel %s, %d pixels: render %" PRId64 " us, map %" PRId64 " us per frame, worst %" PRId64 " us",
+                 names[effect], BENCH_PIXELS, render_us / BENCH_PIXEL_FRAMES, write_us / BENCH_PIXEL_FRAMES,
+                 worst_us);
+    }
+
+    pixel_fx_params_t off = {.effect = PIXEL_FX_OFF};
+    pixel_fx_set_params(fx, &off);
+    pixel_fx_render(fx, 0);
+    pixel_fx_write_dmx(fx, &map);
+    pixel_fx_delete(fx);
+}
+
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE
+/**
+ * @brief Time from dmx_set_channel() until the slot is on the virtual wire
+ */
+static void bench_update_to_wire_latency(dmx_handle_t dmx_handle)
+{
+    static dmx_wire_frame_t frame; // Too large for the caller's stack
+    int64_t worst_us = 0;
+    int64_t total_us = 0;
+    int samples = 0;
+
+    for (int i = 0; i < BENCH_WIRE_SAMPLES; i++)
+    {
+        const uint8_t marker = (uint8_t)(i + 1);
+
+        while (dmx_wire_read(dmx_handle, &frame, 0) == ESP_OK)
+        {
+            // Drop frames queued before the update
+        }
+
+        int64_t written = esp_timer_get_time();
+        dmx_set_channel(dmx_handle, BENCH_CHANNEL, marker);
+
+        while (dmx_wire_read(dmx_handle, &frame, pdMS_TO_TICKS(BENCH_WIRE_TIMEOUT_MS)) == ESP_OK)
+        {
+            if (frame.length > BENCH_CHANNEL && frame.data[BENCH_CHANNEL] == marker)
+            {
+                int64_t on_wire = frame.start_us + (int64_t)BENCH_CHANNEL * DMX_WIRE_SLOT_US;
+                int64_t latency = on_wire - written;
+                total_us += latency;
+                if (latency > worst_us)
+                {
+                    worst_us = latency;
+                }
+                samples++;
+                break;
+            }
+        }
+    }
+
+    dmx_set_channel(dmx_handle, BENCH_CHANNEL, 0);
+
+    uint32_t overruns = 0;
+    dmx_wire_get_overruns(dmx_handle, &overruns);
+
+    if (samples == 0)
+    {
+        ESP_LOGW(TAG, "Update-to-wire: no marker frame seen");
+        return;
+    }
+
+    ESP_LOGI(TAG, "Update-to-wire: %d/%d samples, mean %" PRId64 " us, worst %" PRId64 " us, ring overruns %" PRIu32,
+             samples, BENCH_WIRE_SAMPLES, total_us / samples, worst_us, overruns);
+}
+#endif
+
+void dmx_bench_run(dmx_handle_t dmx_handle)
+{
+    ESP_LOGI(TAG, "Running DMX benchmarks");
+    bench_set_channel_latency(dmx_handle);
+#if CONFIG_LIGHT_PONG_DMX_BENCHMARK_MUTEX_BASELINE
+    bench_set_channel_latency_mutex(dmx_handle);
+#endif
+    bench_frame_cpu_time(dmx_handle);
+    bench_fade_cpu_time(dmx_handle);
+    bench_group_fanout(dmx_handle);
+    bench_shadow_diff(dmx_handle);
+    bench_cue_tables(dmx_handle);
+    bench_pixel_fx(dmx_handle);
+#if CONFIG_DMX_DRIVER_VIRTUAL_WIRE
+    bench_update_to_wire_latency(dmx_handle);
+#endif
+    dmx_log_stats(dmx_handle);
+    ESP_LOGI(TAG, "DMX benchmarks complete");
+}
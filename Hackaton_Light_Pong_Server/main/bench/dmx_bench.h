@@ -0,0 +1,32 @@
+/**
+ * @file dmx_bench.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief On-target DMX driver benchmarks (enabled via menuconfig)
+ */
+
+#ifndef DMX_BENCH_H
+#define DMX_BENCH_H
+
+#include "dmx_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Run all DMX benchmarks and log the results
+     *
+     * Must be called after dmx_start_transmission() so the measurements
+     * include contention with the running transmission task.
+     *
+     * @param dmx_handle DMX handle
+     */
+    void dmx_bench_run(dmx_handle_t dmx_handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMX_BENCH_H
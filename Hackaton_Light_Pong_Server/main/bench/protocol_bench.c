@@ -0,0 +1,99 @@
+/**
+ * @file protocol_bench.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Paddle wire format benchmark
+ */
+
+#include "protocol_bench.h"
+#include <inttypes.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "espnow_handler.h"
+#include "paddle_protocol.h"
+
+static const char *TAG = "protocol_bench";
+
+#define BENCH_ROUNDS 10000
+
+// Keeps the compiler from dropping the measured work
+static volatile uint32_t bench_sink;
+
+/**
+ * @brief Legacy format: float sample copied into input_event_t and read back
+ */
+static void bench_legacy(void)
+{
+    input_event_t event = {0};
+    uint8_t buf[sizeof(input_event_t)];
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < BENCH_ROUNDS; i++)
+    {
+        event.type = MSG_PADDLE_INPUT;
+        event.btn_right_pressed = (uint8_t)(i & 1);
+        event.ax = (float)i * 0.001f;
+        event.gz = (float)i * 0.01f;
+        memcpy(buf, &event, sizeof(event));
+        bench_sink += ((const input_event_t *)buf)->btn_right_pressed;
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+
+    ESP_LOGI(TAG, "Legacy input_event_t: %u bytes, %" PRId64 " ns per copy",
+             (unsigned)sizeof(input_event_t), elapsed_us * 1000 / BENCH_ROUNDS);
+}
+
+/**
+ * @brief Compact format with a batch of samples
+ */
+static void bench_compact(uint8_t samples)
+{
+    paddle_proto_frame_t frame = {
+        .player_id = 1,
+        .buttons = PADDLE_PROTO_BTN_RIGHT,
+        .sample_period_ms = 5,
+        .sample_count = samples};
+    paddle_proto_frame_t decoded;
+    uint8_t buf[PADDLE_PROTO_MAX_SIZE];
+    size_t len = 0;
+
+    for (uint8_t i = 0; i < samples; i++)
+    {
+        frame.samples[i].ax = paddle_proto_accel_from_g(0.1f * i);
+        frame.samples[i].az = paddle_proto_accel_from_g(1.0f);
+        frame.samples[i].gz = paddle_proto_gyro_from_dps(-90.0f * i);
+    }
+
+    int64_t encode_us = 0;
+    int64_t decode_us = 0;
+    for (int i = 0; i < BENCH_ROUNDS; i++)
+    {
+        frame.seq = (uint16_t)i;
+
+        int64_t start = esp_timer_get_time();
+        paddle_proto_encode(&frame, buf, sizeof(buf), &len);
+        int64_t encoded = esp_timer_get_time();
+        paddle_proto_decode(buf, len, &decoded);
+        decode_us += esp_timer_get_time() - encoded;
+        encode_us += encoded - start;
+
+        bench_sink += decoded.seq;
+    }
+
+    // Legacy format needs one packet per sample
+    ESP_LOGI(TAG, "Compact, %u sample(s): %u bytes (legacy %u), encode %" PRId64 " ns, decode %" PRId64 " ns",
+             samples, (unsigned)len, (unsigned)(samples ? samples : 1) * (unsigned)sizeof(input_event_t),
+             encode_us * 1000 / BENCH_ROUNDS, decode_us * 1000 / BENCH_ROUNDS);
+}
+
+void protocol_bench_run(void)
+{
+    ESP_LOGI(TAG, "Running paddle protocol benchmarks");
+    bench_legacy();
+    bench_compact(0);
+    bench_compact(1);
+    bench_compact(4);
+    bench_compact(PADDLE_PROTO_MAX_SAMPLES);
+    ESP_LOGI(TAG, "Paddle protocol benchmarks complete");
+}
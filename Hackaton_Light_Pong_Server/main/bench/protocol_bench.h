@@ -0,0 +1,28 @@
+/**
+ * @file protocol_bench.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief Paddle wire format benchmark (enabled via menuconfig)
+ */
+
+#ifndef PROTOCOL_BENCH_H
+#define PROTOCOL_BENCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Compare the legacy and compact paddle formats and log the results
+     *
+     * Measures encode/decode time and payload size for single and batched
+     * IMU samples. Uses no peripherals, so it can run at any time.
+     */
+    void protocol_bench_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTOCOL_BENCH_H
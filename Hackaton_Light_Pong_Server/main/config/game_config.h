@@ -27,11 +27,27 @@ extern "C"
 // Win condition
 #define WIN_SCORE 9
 
+// Paddle roles: PLAYER_ROLES_DUEL, PLAYER_ROLES_TEAMS (odd IDs top, even bottom) or PLAYER_ROLES_MANUAL
+#define PLAYER_ROLE_POLICY PLAYER_ROLES_DUEL
+
 // Timeout configuration
-#define HIT_TIMEOUT_MS 2000
+#define HIT_TIMEOUT_MS 2000   // Hit window at BALL_FLIGHT_MS, scaled with the flight time
+#define HIT_WINDOW_MIN_MS 800 // Hit window at the fastest flight
+#define HIT_EARLY_MS 100      // Presses this long before the beam arrives still count
 #define CELEBRATION_BLINKS 10
 #define CELEBRATION_BLINK_ON_MS 250
 #define CELEBRATION_BLINK_OFF_MS 250
+#define VICTORY_TIMEOUT_MS 15000 // Longest wait for the victory animation before the next serve
+
+// Ball flight (stretched by the fixture motion model if the head cannot keep up)
+#define BALL_FLIGHT_MS 1000    // First flight of each point
+#define BALL_SPEEDUP_MS 50     // Shorter per return, down to the model's fastest
+#define FIREBALL_FLIGHT_PCT 70 // Fireball flight relative to a normal one
+#define BALL_CURVE (6 << 8)    // Fireball pan bulge at mid-flight (16-bit units)
+
+// DMX merge source priorities (higher overrides lower on shared channels)
+#define DMX_PRIORITY_GAME 100
+#define DMX_PRIORITY_EFFECTS 150
 
 // Playing field boundaries
 #define PAN_MIN (128 - 20)     // Left corner
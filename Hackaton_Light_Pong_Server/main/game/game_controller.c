@@ -9,9 +9,12 @@
 #include "game_types.h"
 #include "../config/game_config.h"
 #include "light_effects.h"
+#include "travel_calibration.h"
 #include "espnow_handler.h"
+#include "latency_trace.h"
 #include "esp_log.h"
 #include "esp_random.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -19,12 +22,18 @@ static const char *TAG = "game_controller";
 
 // Context variables
 static mh_x25_handle_t light_handle = NULL;
+static light_cue_player_handle_t effects_player = NULL;
+static fixture_motion_handle_t ball_motion = NULL;
 static EventGroupHandle_t paddle_events = NULL;
 static volatile uint8_t *last_btn_left_pressed = NULL;
 static volatile uint8_t *last_btn_right_pressed = NULL;
 static volatile int *current_side = NULL;
 static game_score_t *game_score = NULL;
 
+// Requested ball flight, shortened per return down to what the head can do
+static uint32_t ball_flight_ms = BALL_FLIGHT_MS;
+static uint32_t ball_flight_min_ms = 0;
+
 // Configuration for each player/side
 typedef struct
 {
@@ -38,6 +47,8 @@ typedef struct
 } side_config_t;
 
 void game_controller_set_context(mh_x25_handle_t light,
+                                 light_cue_player_handle_t effects,
+                                 fixture_motion_handle_t motion,
                                  EventGroupHandle_t events,
                                  volatile int *side,
                                  volatile uint8_t *btn_left,
@@ -45,6 +56,8 @@ void game_controller_set_context(mh_x25_handle_t light,
                                  void *score)
 {
     light_handle = light;
+    effects_player = effects;
+    ball_motion = motion;
     paddle_events = events;
     current_side = side;
     last_btn_left_pressed = btn_left;
@@ -57,6 +70,120 @@ static uint8_t get_random_pan(uint8_t pan_min, uint8_t pan_max)
     return pan_min + (esp_random() % (pan_max - pan_min + 1));
 }
 
+/**
+ * @brief Start the ball towards a position
+ *
+ * The planner writes a setpoint every DMX frame; a fireball flies faster on a
+ * curve bending towards the middle of the field.
+ *
+ * @return esp_timer time the beam arrives
+ */
+static int64_t move_ball(uint8_t pan, uint8_t tilt, uint8_t button_pressed)
+{
+    fixture_motion_target_t target = {
+        .pan = pan << 8,
+        .tilt = tilt << 8,
+        .profile = FIXTURE_MOTION_EASE,
+        .duration_ms = ball_flight_ms};
+
+    if (button_pressed == BUTTON_FIREBALL)
+    {
+        target.profile = FIXTURE_MOTION_ARC;
+        target.duration_ms = ball_flight_ms * FIREBALL_FLIGHT_PCT / 100;
+        target.arc_pan = (pan < 128) ? BALL_CURVE : -BALL_CURVE;
+    }
+
+    int64_t arrival_us = esp_timer_get_time();
+    if (fixture_motion_move(ball_motion, &target, &arrival_us) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Ball move rejected, jumping to target");
+        mh_x25_set_position_16bit(light_handle, target.pan, target.tilt);
+    }
+    return arrival_us;
+}
+
+/**
+ * @brief Shorten the next flight after a return, never below the head's fastest
+ */
+static void speed_up_ball(void)
+{
+    if (ball_flight_ms > ball_flight_min_ms + BALL_SPEEDUP_MS)
+    {
+        ball_flight_ms -= BALL_SPEEDUP_MS;
+    }
+    else
+    {
+        ball_flight_ms = ball_flight_min_ms;
+    }
+}
+
+/**
+ * @brief Hit window after the beam has arrived, shrinking with the ball's speed
+ */
+static TickType_t hit_window_ticks(void)
+{
+    uint32_t window_ms = (uint32_t)((uint64_t)HIT_TIMEOUT_MS * ball_flight_ms / BALL_FLIGHT_MS);
+    if (window_ms < HIT_WINDOW_MIN_MS)
+    {
+        window_ms = HIT_WINDOW_MIN_MS;
+    }
+    return pdMS_TO_TICKS(window_ms + HIT_EARLY_MS);
+}
+
+/**
+ * @brief Use the stored travel calibration, or measure one first if configured
+ */
+static void load_travel_model(void)
+{
+    fixture_motion_model_t model;
+    esp_err_t ret;
+
+#if CONFIG_LIGHT_PONG_CALIBRATE_TRAVEL
+    fixture_motion_model_t defaults;
+    fixture_motion_get_model(ball_motion, &defaults);
+    ret = travel_calibration_run(light_handle, paddle_events, MH_X25_SPEED_FAST, &defaults, &model);
+    if (ret == ESP_OK)
+    {
+        ret = travel_calibration_save(MH_X25_SPEED_FAST, &model);
+        if (ret != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Failed to store travel calibration: %s", esp_err_to_name(ret));
+        }
+        ret = ESP_OK;
+    }
+    else
+    {
+        ret = travel_calibration_load(MH_X25_SPEED_FAST, &model);
+    }
+#else
+    ret = travel_calibration_load(MH_X25_SPEED_FAST, &model);
+#endif
+
+    if (ret == ESP_OK)
+    {
+        fixture_motion_set_model(ball_motion, &model);
+        ESP_LOGI(TAG, "Using travel calibration: pan %lu, tilt %lu units/s, latency %lu ms",
+                 (unsigned long)model.pan_velocity, (unsigned long)model.tilt_velocity,
+                 (unsigned long)model.latency_ms);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "No travel calibration stored, using datasheet model");
+    }
+}
+
+/**
+ * @brief Block until the beam has reached its target
+ */
+static void wait_for_arrival(int64_t arrival_us)
+{
+    int64_t remaining_us = arrival_us - esp_timer_get_time();
+    if (remaining_us > 0)
+    {
+        vTaskDelay(pdMS_TO_TICKS((remaining_us + 999) / 1000));
+    }
+}
+
 static void apply_ball_effect(uint8_t button_pressed)
 {
     if (button_pressed == BUTTON_FIREBALL)
@@ -80,11 +207,12 @@ static void celebration_blink(uint8_t color)
     mh_x25_set_gobo(light_handle, MH_X25_GOBO_OPEN);
     mh_x25_set_gobo_rotation(light_handle, 0);
 
+    // The DMX driver interpolates the fades per frame; the delays only pace the pulses
     for (int i = 0; i < CELEBRATION_BLINKS; i++)
     {
-        mh_x25_set_dimmer(light_handle, MH_X25_DIMMER_FULL);
+        mh_x25_fade_dimmer(light_handle, MH_X25_DIMMER_FULL, CELEBRATION_BLINK_ON_MS, DMX_FADE_EASE_OUT);
         vTaskDelay(pdMS_TO_TICKS(CELEBRATION_BLINK_ON_MS));
-        mh_x25_set_dimmer(light_handle, 0);
+        mh_x25_fade_dimmer(light_handle, 0, CELEBRATION_BLINK_OFF_MS, DMX_FADE_EASE_IN);
         vTaskDelay(pdMS_TO_TICKS(CELEBRATION_BLINK_OFF_MS));
     }
     mh_x25_set_dimmer(light_handle, MH_X25_DIMMER_FULL);
@@ -110,14 +238,19 @@ static bool handle_paddle_hit(const side_config_t *cfg, uint8_t pan_min, uint8_t
 
     if (bits & cfg->event_bit)
     {
+        latency_trace_mark(cfg->player_number - 1, LATENCY_STAGE_WAKE);
         ESP_LOGI(TAG, "Player %d hit detected", cfg->player_number);
         apply_ball_effect(*cfg->button_state);
 
         uint8_t pan_position = get_random_pan(pan_min, pan_max);
-        mh_x25_set_position_16bit(light_handle, pan_position << 8, cfg->opposite_tilt << 8);
+        int64_t arrival_us = move_ball(pan_position, cfg->opposite_tilt, *cfg->button_state);
+        latency_trace_mark(cfg->player_number - 1, LATENCY_STAGE_COMMAND);
         *current_side = cfg->opposite_side;
+        speed_up_ball();
 
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        // The other side's hit window opens when the beam gets there, less the
+        // time a press needs to travel over the radio
+        wait_for_arrival(arrival_us - HIT_EARLY_MS * 1000);
         return true;
     }
 
@@ -132,6 +265,8 @@ static bool handle_timeout(const side_config_t *cfg, uint8_t pan_min, uint8_t pa
         return false;
     }
 
+    ball_flight_ms = BALL_FLIGHT_MS;
+
     if (cfg->player_number == 1)
         game_score->score_2++;
     else
@@ -139,6 +274,8 @@ static bool handle_timeout(const side_config_t *cfg, uint8_t pan_min, uint8_t pa
 
     ESP_LOGI(TAG, "Timeout: Player %d missed - Score P1=%d P2=%d",
              cfg->player_number, game_score->score_1, game_score->score_2);
+    latency_trace_log();
+    espnow_log_link_stats();
 
     esp_err_t ret = espnow_broadcast_score(game_score, sizeof(game_score_t));
     if (ret != ESP_OK)
@@ -151,7 +288,15 @@ static bool handle_timeout(const side_config_t *cfg, uint8_t pan_min, uint8_t pa
 
     if (winner > 0)
     {
-        play_winning_animation(winner, light_handle);
+        // The victory cue overrides the game light from the effects layer
+        // while the score is reset and the ball is served underneath it
+        light_cue_id_t victory = 0;
+        ret = play_winning_animation(winner, effects_player, &victory);
+        if (ret != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Failed to start victory animation: %s", esp_err_to_name(ret));
+        }
+        apply_ball_effect(BUTTON_NORMAL);
         game_score->score_1 = 0;
         game_score->score_2 = 0;
         ret = espnow_broadcast_score(game_score, sizeof(game_score_t));
@@ -161,8 +306,15 @@ static bool handle_timeout(const side_config_t *cfg, uint8_t pan_min, uint8_t pa
         }
 
         uint8_t pan_position = get_random_pan(pan_min, pan_max);
-        mh_x25_set_position_16bit(light_handle, pan_position << 8, TILT_TOP << 8);
+        wait_for_arrival(move_ball(pan_position, TILT_TOP, BUTTON_NORMAL));
         *current_side = SIDE_TOP;
+
+        if (victory != 0 && light_cue_wait(effects_player, victory, pdMS_TO_TICKS(VICTORY_TIMEOUT_MS)) != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Victory animation still running, stopping it");
+            light_cue_stop(effects_player, victory);
+        }
+        ESP_LOGI(TAG, "Victory animation complete, resetting game");
         vTaskDelay(pdMS_TO_TICKS(2000));
         return true;
     }
@@ -179,7 +331,6 @@ void dmx_controller_task(void *pvParameters)
 {
     const uint8_t pan_min = PAN_MIN;
     const uint8_t pan_max = PAN_MAX;
-    const TickType_t timeout_ticks = pdMS_TO_TICKS(HIT_TIMEOUT_MS);
 
     mh_x25_set_color(light_handle, MH_X25_COLOR_WHITE);
     mh_x25_set_shutter(light_handle, MH_X25_SHUTTER_OPEN);
@@ -191,10 +342,23 @@ void dmx_controller_task(void *pvParameters)
 
     vTaskDelay(pdMS_TO_TICKS(500));
 
+    load_travel_model();
+
     *current_side = SIDE_TOP;
     uint8_t pan_position = get_random_pan(pan_min, pan_max);
     ESP_LOGI(TAG, "Game started: ball at TOP (pan=%d, tilt=%d)", pan_position, TILT_TOP);
-    mh_x25_set_position_16bit(light_handle, pan_position << 8, TILT_TOP << 8);
+    wait_for_arrival(move_ball(pan_position, TILT_TOP, BUTTON_NORMAL));
+
+    // The fastest full-field flight the model allows is where speeding up stops
+    fixture_motion_target_t full_field = {
+        .pan = pan_position << 8,
+        .tilt = TILT_BOTTOM << 8,
+        .profile = FIXTURE_MOTION_EASE,
+        .duration_ms = 0};
+    fixture_motion_plan_t plan = {0};
+    fixture_motion_plan(ball_motion, &full_field, &plan);
+    ball_flight_min_ms = plan.duration_ms;
+    ESP_LOGI(TAG, "Ball flight %d ms, speeding up to %lu ms", BALL_FLIGHT_MS, (unsigned long)ball_flight_min_ms);
     vTaskDelay(pdMS_TO_TICKS(1000));
 
     side_config_t player1_config = {
@@ -219,7 +383,7 @@ void dmx_controller_task(void *pvParameters)
     {
         side_config_t *current_player = (*current_side == SIDE_TOP) ? &player1_config : &player2_config;
 
-        if (!handle_paddle_hit(current_player, pan_min, pan_max, timeout_ticks))
+        if (!handle_paddle_hit(current_player, pan_min, pan_max, hit_window_ticks()))
         {
             if (handle_timeout(current_player, pan_min, pan_max))
             {
@@ -11,6 +11,8 @@
 #include <stdint.h>
 #include "dmx_driver.h"
 #include "mh_x25_driver.h"
+#include "fixture_motion.h"
+#include "light_cue.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 
@@ -29,7 +31,9 @@ extern "C"
     /**
      * @brief Set game controller context
      *
-     * @param light MH X25 light handle
+     * @param light MH X25 light handle of the game merge source
+     * @param effects Cue player of the MH X25 light on the effects merge source
+     * @param ball_motion Motion planner moving the game light
      * @param events Event group for paddle hits
      * @param side Pointer to current side state
      * @param btn_left Pointer to left button state
@@ -37,6 +41,8 @@ extern "C"
      * @param score Pointer to game score
      */
     void game_controller_set_context(mh_x25_handle_t light,
+                                     light_cue_player_handle_t effects,
+                                     fixture_motion_handle_t ball_motion,
                                      EventGroupHandle_t events,
                                      volatile int *side,
                                      volatile uint8_t *btn_left,
@@ -0,0 +1,304 @@
+/**
+ * @file travel_calibration.c
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief MH X25 pan/tilt travel time calibration implementation
+ */
+
+#include "travel_calibration.h"
+#include "../config/game_config.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include "esp_log.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include "freertos/task.h"
+
+static const char *TAG = "travel_cal";
+
+#define TRAVEL_CAL_NVS_NAMESPACE "light_pong"
+#define TRAVEL_CAL_SETTLE_MS 2500 // Longest full-field move at a slow speed channel
+#define TRAVEL_CAL_MIN_SAMPLES 4  // Per axis
+#define TRAVEL_CAL_CENTER 128
+
+/**
+ * @brief Running sums of a least squares line fit t = offset + d / velocity
+ */
+typedef struct
+{
+    int64_t sum_d;
+    int64_t sum_t;
+    int64_t sum_dd;
+    int64_t sum_dt;
+    int32_t n;
+} travel_fit_t;
+
+static void fit_add(travel_fit_t *fit, int64_t distance, int64_t travel_us)
+{
+    fit->sum_d += distance;
+    fit->sum_t += travel_us;
+    fit->sum_dd += distance * distance;
+    fit->sum_dt += distance * travel_us;
+    fit->n++;
+}
+
+/**
+ * @brief Solve the fit for velocity (units/s) and offset (us)
+ */
+static bool fit_solve(const travel_fit_t *fit, uint32_t *velocity, int64_t *offset_us)
+{
+    if (fit->n < TRAVEL_CAL_MIN_SAMPLES)
+    {
+        return false;
+    }
+
+    int64_t num = fit->n * fit->sum_dt - fit->sum_d * fit->sum_t; // slope * den, us per unit
+    int64_t den = fit->n * fit->sum_dd - fit->sum_d * fit->sum_d;
+    if (num <= 0 || den <= 0)
+    {
+        return false;
+    }
+
+    *velocity = (uint32_t)((den * 1000000) / num);
+    *offset_us = (fit->sum_t - (num * fit->sum_d) / den) / fit->n;
+    return *velocity > 0;
+}
+
+/**
+ * @brief Wait for any paddle press
+ *
+ * @return esp_timer time of the press, or -1 on timeout
+ */
+static int64_t wait_for_press(EventGroupHandle_t events)
+{
+    EventBits_t bits = xEventGroupWaitBits(events, PADDLE_TOP_HIT | PADDLE_BOTTOM_HIT, pdTRUE, pdFALSE,
+                                           pdMS_TO_TICKS(TRAVEL_CAL_PRESS_TIMEOUT_MS));
+    if ((bits & (PADDLE_TOP_HIT | PADDLE_BOTTOM_HIT)) == 0)
+    {
+        return -1;
+    }
+    return esp_timer_get_time();
+}
+
+/**
+ * @brief Measure the time from the beam appearing to a paddle press
+ *
+ * Includes the radio delay of the paddle, so it cancels out of the travel times.
+ */
+static int64_t measure_reaction(mh_x25_handle_t light, EventGroupHandle_t events)
+{
+    int64_t sum_us = 0;
+    int count = 0;
+
+    mh_x25_set_position_16bit(light, TRAVEL_CAL_CENTER << 8, TRAVEL_CAL_CENTER << 8);
+
+    for (int i = 0; i < TRAVEL_CAL_REACTION_RUNS; i++)
+    {
+        mh_x25_set_dimmer(light, MH_X25_DIMMER_OFF);
+        vTaskDelay(pdMS_TO_TICKS(1000 + esp_random() % 2000));
+
+        xEventGroupClearBits(events, PADDLE_TOP_HIT | PADDLE_BOTTOM_HIT);
+        mh_x25_set_dimmer(light, MH_X25_DIMMER_FULL);
+        int64_t on_us = esp_timer_get_time();
+
+        int64_t press_us = wait_for_press(events);
+        if (press_us > 0)
+        {
+            sum_us += press_us - on_us;
+            count++;
+        }
+    }
+
+    return (count > 0) ? sum_us / count : -1;
+}
+
+/**
+ * @brief Step the head and time the press when the beam arrives
+ *
+ * @return Press time minus command time in us, or -1 on timeout
+ */
+static int64_t measure_step(mh_x25_handle_t light, EventGroupHandle_t events, uint8_t pan, uint8_t tilt)
+{
+    xEventGroupClearBits(events, PADDLE_TOP_HIT | PADDLE_BOTTOM_HIT);
+    mh_x25_set_position_16bit(light, pan << 8, tilt << 8);
+    int64_t start_us = esp_timer_get_time();
+
+    int64_t press_us = wait_for_press(events);
+    return (press_us > 0) ? press_us - start_us : -1;
+}
+
+/**
+ * @brief Step one axis across the field and back over TRAVEL_CAL_STEPS distances
+ */
+static void measure_axis(mh_x25_handle_t light, EventGroupHandle_t events, bool tilt_axis,
+                         int64_t reaction_us, travel_fit_t *fit)
+{
+    const uint8_t from = tilt_axis ? TILT_BOTTOM : PAN_MIN;
+    const uint8_t span = tilt_axis ? (TILT_TOP - TILT_BOTTOM) : (PAN_MAX - PAN_MIN);
+
+    for (int step = 1; step <= TRAVEL_CAL_STEPS; step++)
+    {
+        uint8_t to = from + (span * step) / TRAVEL_CAL_STEPS;
+        int64_t distance = (int64_t)(to - from) << 8;
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            // Out and back, so both directions are in the fit
+            uint8_t start = (pass == 0) ? from : to;
+            uint8_t target = (pass == 0) ? to : from;
+
+            if (tilt_axis)
+            {
+                mh_x25_set_position_16bit(light, TRAVEL_CAL_CENTER << 8, start << 8);
+            }
+            else
+            {
+                mh_x25_set_position_16bit(light, start << 8, TRAVEL_CAL_CENTER << 8);
+            }
+            vTaskDelay(pdMS_TO_TICKS(TRAVEL_CAL_SETTLE_MS));
+
+            int64_t elapsed_us = tilt_axis ? measure_step(light, events, TRAVEL_CAL_CENTER, target)
+                                           : measure_step(light, events, target, TRAVEL_CAL_CENTER);
+            if (elapsed_us < 0)
+            {
+                ESP_LOGW(TAG, "No press for %s step of %d", tilt_axis ? "tilt" : "pan", to - from);
+                continue;
+            }
+
+            int64_t travel_us = elapsed_us - reaction_us;
+            ESP_LOGI(TAG, "%s %d -> %d: %lld ms", tilt_axis ? "Tilt" : "Pan", start, target,
+                     (long long)(travel_us / 1000));
+            fit_add(fit, distance, (travel_us > 0) ? travel_us : 0);
+        }
+    }
+}
+
+/**
+ * @brief Latency left after the acceleration phase of a step at velocity v
+ *
+ * A step accelerates to v and brakes again, which costs v / a over a move at
+ * constant speed; the rest of the fitted offset is latency.
+ */
+static int64_t axis_latency_us(int64_t offset_us, uint32_t velocity, uint32_t accel)
+{
+    int64_t latency_us = offset_us - ((int64_t)velocity * 1000000) / accel;
+    return (latency_us > 0) ? latency_us : 0;
+}
+
+esp_err_t travel_calibration_run(mh_x25_handle_t light, EventGroupHandle_t events, uint8_t speed,
+                                 const fixture_motion_model_t *defaults, fixture_motion_model_t *out_model)
+{
+    if (light == NULL || events == NULL || defaults == NULL || out_model == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ESP_LOGI(TAG, "Travel calibration at speed %d: press a paddle when the beam appears", speed);
+    mh_x25_set_speed(light, speed);
+
+    int64_t reaction_us = measure_reaction(light, events);
+    if (reaction_us < 0)
+    {
+        ESP_LOGW(TAG, "No paddle presses, calibration aborted");
+        return ESP_ERR_TIMEOUT;
+    }
+    ESP_LOGI(TAG, "Reaction time %lld ms; now press when the beam stops", (long long)(reaction_us / 1000));
+
+    travel_fit_t pan_fit = {0};
+    travel_fit_t tilt_fit = {0};
+    measure_axis(light, events, true, reaction_us, &tilt_fit);
+    measure_axis(light, events, false, reaction_us, &pan_fit);
+
+    if (tilt_fit.n < TRAVEL_CAL_MIN_SAMPLES || pan_fit.n < TRAVEL_CAL_MIN_SAMPLES)
+    {
+        ESP_LOGW(TAG, "Too few presses (pan %ld, tilt %ld)", (long)pan_fit.n, (long)tilt_fit.n);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    uint32_t pan_velocity;
+    uint32_t tilt_velocity;
+    int64_t pan_offset_us;
+    int64_t tilt_offset_us;
+    if (!fit_solve(&pan_fit, &pan_velocity, &pan_offset_us) ||
+        !fit_solve(&tilt_fit, &tilt_velocity, &tilt_offset_us))
+    {
+        ESP_LOGW(TAG, "Travel times do not grow with distance, calibration rejected");
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    int64_t latency_us = (axis_latency_us(pan_offset_us, pan_velocity, defaults->pan_accel) +
+                          axis_latency_us(tilt_offset_us, tilt_velocity, defaults->tilt_accel)) / 2;
+
+    *out_model = *defaults;
+    out_model->pan_velocity = pan_velocity;
+    out_model->tilt_velocity = tilt_velocity;
+    out_model->latency_ms = (uint32_t)(latency_us / 1000);
+
+    ESP_LOGI(TAG, "Pan %lu units/s, tilt %lu units/s, latency %lu ms",
+             (unsigned long)pan_velocity, (unsigned long)tilt_velocity, (unsigned long)out_model->latency_ms);
+    return ESP_OK;
+}
+
+/**
+ * @brief NVS key of the model for a speed channel value
+ */
+static void travel_key(uint8_t speed, char *key, size_t size)
+{
+    snprintf(key, size, "travel_%u", speed);
+}
+
+esp_err_t travel_calibration_load(uint8_t speed, fixture_motion_model_t *out_model)
+{
+    if (out_model == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t nvs;
+    if (nvs_open(TRAVEL_CAL_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    fixture_motion_model_t model;
+    size_t length = sizeof(model);
+    travel_key(speed, key, sizeof(key));
+    esp_err_t ret = nvs_get_blob(nvs, key, &model, &length);
+    nvs_close(nvs);
+
+    if (ret != ESP_OK || length != sizeof(model))
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *out_model = model;
+    return ESP_OK;
+}
+
+esp_err_t travel_calibration_save(uint8_t speed, const fixture_motion_model_t *model)
+{
+    if (model == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(TRAVEL_CAL_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    travel_key(speed, key, sizeof(key));
+    ret = nvs_set_blob(nvs, key, model, sizeof(*model));
+    if (ret == ESP_OK)
+    {
+        ret = nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+
+    return ret;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file travel_calibration.h
+ * @author Matthias Hefel
+ * @date 2026
+ * @brief MH X25 pan/tilt travel time calibration for Light Pong
+ *
+ * The head is stepped across the playing field at a given speed channel
+ * setting while a player presses a paddle the moment the beam arrives. The
+ * player's reaction time is measured first and subtracted. A least squares
+ * fit of travel time = offset + distance / velocity per axis gives the
+ * fixture's velocity, and the offset minus the acceleration phase gives its
+ * latency. Results are stored in NVS per speed channel value.
+ */
+
+#ifndef TRAVEL_CALIBRATION_H
+#define TRAVEL_CALIBRATION_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "mh_x25_driver.h"
+#include "fixture_motion.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TRAVEL_CAL_REACTION_RUNS 3  // Reaction time samples
+#define TRAVEL_CAL_STEPS 3          // Distances per axis (1/3, 2/3 and the full field)
+#define TRAVEL_CAL_PRESS_TIMEOUT_MS 5000
+
+    /**
+     * @brief Measure pan/tilt travel time and fit a motion model
+     *
+     * Blocks for about a minute. The game light must not be moved by anyone
+     * else meanwhile; its speed channel is left at speed afterwards.
+     *
+     * @param light MH X25 handle of the game light
+     * @param events Paddle event group, any paddle counts
+     * @param speed Speed channel value to calibrate (MH_X25_SPEED_FAST for the planner)
+     * @param defaults Model providing the acceleration, which cannot be told apart from latency
+     * @param out_model Pointer to store the fitted model
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_TIMEOUT: Too few paddle presses
+     *      - ESP_ERR_INVALID_RESPONSE: Presses do not fit a travel model
+     */
+    esp_err_t travel_calibration_run(mh_x25_handle_t light, EventGroupHandle_t events, uint8_t speed,
+                                     const fixture_motion_model_t *defaults, fixture_motion_model_t *out_model);
+
+    /**
+     * @brief Load a stored model for a speed channel value
+     *
+     * @param speed Speed channel value
+     * @param out_model Pointer to store the model
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - ESP_ERR_NOT_FOUND: No calibration stored
+     */
+    esp_err_t travel_calibration_load(uint8_t speed, fixture_motion_model_t *out_model);
+
+    /**
+     * @brief Store a model for a speed channel value
+     *
+     * @param speed Speed channel value
+     * @param model Model
+     * @return
+     *      - ESP_OK: Success
+     *      - ESP_ERR_INVALID_ARG: Invalid arguments
+     *      - Others: NVS error
+     */
+    esp_err_t travel_calibration_save(uint8_t speed, const fixture_motion_model_t *model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRAVEL_CALIBRATION_H
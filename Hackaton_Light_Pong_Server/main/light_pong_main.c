@@ -13,13 +13,21 @@
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
 #include "esp_log.h"
+#include "nvs_flash.h"
 #include "dmx_driver.h"
+#include "dmx_merge.h"
+#include "dmx_rdm.h"
 #include "mh_x25_driver.h"
+#include "fixture_motion.h"
+#include "light_cue.h"
 #include "config/hardware_config.h"
 #include "config/game_config.h"
 #include "espnow_handler.h"
+#include "latency_trace.h"
 #include "game/game_controller.h"
 #include "game/game_types.h"
+#include "bench/dmx_bench.h"
+#include "bench/protocol_bench.h"
 
 static const char *TAG = "main";
 
@@ -29,14 +37,72 @@ static volatile uint8_t last_btn_left_pressed = 0;
 static volatile uint8_t last_btn_right_pressed = 0;
 
 static dmx_handle_t dmx_handle = NULL;
+static dmx_source_handle_t game_source = NULL;
+static dmx_source_handle_t effects_source = NULL;
 static mh_x25_handle_t light_handle = NULL;
+static mh_x25_handle_t effects_light_handle = NULL;
+static fixture_motion_handle_t ball_motion = NULL;
+static light_cue_player_handle_t effects_player = NULL;
 
 static game_score_t game_score = {0, 0};
 
+#if CONFIG_LIGHT_PONG_RDM_PATCH
+#define RDM_MAX_DEVICES 8
+
+/**
+ * @brief Discover RDM fixtures and move a single one to MH_X25_START_CHANNEL
+ */
+static void rdm_patch_fixture(void)
+{
+    dmx_rdm_uid_t uids[RDM_MAX_DEVICES];
+    uint16_t count = 0;
+
+    esp_err_t ret = dmx_rdm_discover(dmx_handle, uids, RDM_MAX_DEVICES, &count);
+    if (ret != ESP_OK && ret != ESP_ERR_NO_MEM)
+    {
+        ESP_LOGW(TAG, "RDM discovery failed: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    dmx_rdm_device_info_t info = {0};
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (dmx_rdm_get_device_info(dmx_handle, uids[i], &info) == ESP_OK)
+        {
+            ESP_LOGI(TAG, "RDM %04X:%08lX model 0x%04X, address %d, footprint %d",
+                     DMX_RDM_UID_MANUFACTURER(uids[i]), (unsigned long)DMX_RDM_UID_DEVICE(uids[i]),
+                     info.model_id, info.start_address, info.footprint);
+        }
+    }
+
+    // footprint stays 0 if DEVICE_INFO failed or the device uses no channels
+    if (count != 1 || info.footprint == 0 || info.start_address == MH_X25_START_CHANNEL)
+    {
+        return;
+    }
+
+    ret = dmx_rdm_set_start_address(dmx_handle, uids[0], MH_X25_START_CHANNEL);
+    ESP_LOGI(TAG, "Readdressing fixture from %d to %d: %s", info.start_address,
+             MH_X25_START_CHANNEL, esp_err_to_name(ret));
+}
+#endif
+
 void app_main(void)
 {
     ESP_LOGI(TAG, "Initializing Light Pong Game");
 
+    // NVS holds the travel calibration read by the game controller
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND)
+    {
+        nvs_flash_erase();
+        ret = nvs_flash_init();
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "NVS unavailable: %s", esp_err_to_name(ret));
+    }
+
     // Create event group for paddle communication
     paddle_events = xEventGroupCreate();
     if (paddle_events == NULL)
@@ -51,34 +117,94 @@ void app_main(void)
         .rx_pin = DMX_RX_PIN,
         .enable_pin = DMX_ENABLE_PIN,
         .uart_num = UART_NUM_1,
-        .universe_size = 512};
+        .universe_size = 512,
+        .break_mode = DMX_BREAK_MODE_UART,
+        .refresh_mode = DMX_REFRESH_TRIMMED,
+        .refresh_rate_hz = 200,
+        .idle_rate_hz = 10};
 
-    esp_err_t ret = dmx_init(&dmx_config, &dmx_handle);
+    ret = dmx_init(&dmx_config, &dmx_handle);
     if (ret != ESP_OK)
     {
         ESP_LOGE(TAG, "Failed to initialize DMX: %s", esp_err_to_name(ret));
         return;
     }
 
+    // Game and effects write the same fixture through separate merge sources;
+    // effects override the game while active and release it afterwards
+    ret = dmx_source_create(dmx_handle, "game", DMX_PRIORITY_GAME, &game_source);
+    if (ret == ESP_OK)
+    {
+        ret = dmx_source_create(dmx_handle, "effects", DMX_PRIORITY_EFFECTS, &effects_source);
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to create DMX merge sources: %s", esp_err_to_name(ret));
+        dmx_deinit(dmx_handle);
+        return;
+    }
+    dmx_merge_set_rule(dmx_handle, MH_X25_START_CHANNEL + MH_X25_CHANNEL_DIMMER, 1, DMX_MERGE_HTP);
+
     // Initialize MH X25 light
     mh_x25_config_t light_config = {
         .dmx_handle = dmx_handle,
+        .source = game_source,
         .start_channel = MH_X25_START_CHANNEL};
 
     ret = mh_x25_init(&light_config, &light_handle);
+    if (ret == ESP_OK)
+    {
+        light_config.source = effects_source;
+        ret = mh_x25_init(&light_config, &effects_light_handle);
+    }
+    if (ret == ESP_OK)
+    {
+        // Ball moves are planned per DMX frame from the head's pan/tilt dynamics
+        const fixture_motion_model_t ball_model = {
+            .pan_velocity = MH_X25_PAN_VELOCITY,
+            .tilt_velocity = MH_X25_TILT_VELOCITY,
+            .pan_accel = MH_X25_PAN_ACCEL,
+            .tilt_accel = MH_X25_TILT_ACCEL,
+            .latency_ms = MH_X25_MOTION_LATENCY_MS};
+        ret = fixture_motion_create(light_handle, &ball_model, &ball_motion);
+    }
+    if (ret == ESP_OK)
+    {
+        // Effects are cues played per DMX frame, the game task never waits on them
+        const light_cue_player_config_t player_config = {
+            .dmx_handle = dmx_handle,
+            .fixture = effects_light_handle};
+        ret = light_cue_player_create(&player_config, &effects_player);
+        if (ret != ESP_OK)
+        {
+            fixture_motion_delete(ball_motion);
+        }
+    }
     if (ret != ESP_OK)
     {
         ESP_LOGE(TAG, "Failed to initialize MH X25: %s", esp_err_to_name(ret));
+        mh_x25_deinit(effects_light_handle);
+        mh_x25_deinit(light_handle);
         dmx_deinit(dmx_handle);
         return;
     }
     ESP_LOGI(TAG, "MH X25 initialized at DMX address %d", MH_X25_START_CHANNEL);
 
+    // Added after the ball motion, so its frame stage sees the position already written
+    ret = latency_trace_init(dmx_handle);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Paddle latency tracing unavailable: %s", esp_err_to_name(ret));
+    }
+
     // Start continuous DMX transmission
     ret = dmx_start_transmission(dmx_handle);
     if (ret != ESP_OK)
     {
         ESP_LOGE(TAG, "Failed to start DMX transmission: %s", esp_err_to_name(ret));
+        light_cue_player_delete(effects_player);
+        fixture_motion_delete(ball_motion);
+        mh_x25_deinit(effects_light_handle);
         mh_x25_deinit(light_handle);
         dmx_deinit(dmx_handle);
         return;
@@ -87,11 +213,24 @@ void app_main(void)
     // Wait for DMX to stabilize
     vTaskDelay(pdMS_TO_TICKS(500));
 
+#if CONFIG_LIGHT_PONG_RDM_PATCH
+    rdm_patch_fixture();
+#endif
+
+#if CONFIG_LIGHT_PONG_DMX_BENCHMARK
+    dmx_bench_run(dmx_handle);
+#endif
+
+#if CONFIG_LIGHT_PONG_PROTOCOL_BENCHMARK
+    protocol_bench_run();
+#endif
+
     // Set context for communication module (inject dependencies)
     espnow_set_context(paddle_events, (uint8_t *)&last_btn_left_pressed, (uint8_t *)&last_btn_right_pressed);
+    player_registry_set_policy(PLAYER_ROLE_POLICY);
 
     // Set context for game controller (inject dependencies)
-    game_controller_set_context(light_handle, paddle_events, &current_side,
+    game_controller_set_context(light_handle, effects_player, ball_motion, paddle_events, &current_side,
                                 (uint8_t *)&last_btn_left_pressed, (uint8_t *)&last_btn_right_pressed,
                                 &game_score);
 